@@ -2,6 +2,7 @@
 
 #include "Window/Window.h"
 #include "Rendering/RenderingAPI.h"
+#include "Scene/SystemScheduler.h"
 
 #include "Event/WindowEvent.h"
 #include "Event/KeyEvent.h"
@@ -17,19 +18,47 @@ namespace Firefly
         virtual ~Application();
 
         void Update(float deltaTime);
-        void OnEvent(std::shared_ptr<Event> event);
+        void OnEvent(const Event& event);
 
         void RequestShutdown();
         bool IsShutdownRequested() const;
 
+        // with a tick rate above 0 the simulation runs in fixed steps of OnFixedUpdate and OnRender is called once per
+        // frame with the fraction of a step that is not simulated yet, otherwise OnUpdate gets the frame time
+        void SetFixedTickRate(float tickRate);
+        float GetFixedTickRate() const;
+        // steps that do not fit into a frame are dropped, so a slow frame does not cause even slower ones
+        void SetMaxFixedStepsPerFrame(uint32_t maxStepCount);
+
+        // a frame rate of 0 leaves the frame rate unlimited
+        void SetTargetFrameRate(float frameRate);
+        // while the window is minimized or unfocused the application idles, it waits for window events instead of
+        // polling them and runs at the background frame rate, a background frame rate of 0 disables idling
+        void SetBackgroundFrameRate(float frameRate);
+        bool IsIdle() const;
+        float GetFrameRateLimit() const;
+
     protected:
-        virtual void OnUpdate(float deltaTime) = 0;
-        virtual void OnWindowEvent(std::shared_ptr<WindowEvent> event) = 0;
-        virtual void OnKeyEvent(std::shared_ptr<KeyEvent> event) = 0;
-        virtual void OnMouseEvent(std::shared_ptr<MouseEvent> event) = 0;
-        virtual void OnGamepadEvent(std::shared_ptr<GamepadEvent> event) = 0;
+        // called before the window events of a frame are polled, the place to wait for a frame slot in low latency mode
+        virtual void OnFrameStart() {}
+        virtual void OnUpdate(float deltaTime) {}
+        virtual void OnFixedUpdate(float fixedDeltaTime) {}
+        virtual void OnRender(float deltaTime, float interpolationAlpha) {}
+        // called with the events of their category, the payload of the concrete event type is read with AsType
+        virtual void OnWindowEvent(const Event& event) = 0;
+        virtual void OnKeyEvent(const Event& event) = 0;
+        virtual void OnMouseEvent(const Event& event) = 0;
+        virtual void OnGamepadEvent(const Event& event) = 0;
 
         std::shared_ptr<Window> m_window;
+        SystemScheduler m_systemScheduler;
         bool m_isShutdownRequested = false;
+
+        float m_fixedTickRate = 0.0f;
+        uint32_t m_maxFixedStepsPerFrame = 5;
+        float m_accumulatedTime = 0.0f;
+
+        float m_targetFrameRate = 0.0f;
+        float m_backgroundFrameRate = 10.0f;
     };
 }
\ No newline at end of file
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <spdlog/spdlog.h>
+#include <spdlog/sinks/sink.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <tuple>
+
+namespace Firefly
+{
+    // single producer single consumer byte ring, the thread owning it writes records and the logging thread reads them
+    class LogRing
+    {
+    public:
+        // rounded up to a power of two
+        LogRing(size_t capacity);
+
+        size_t GetCapacity() const;
+        bool IsEmpty() const;
+
+        bool TryWrite(const uint8_t* data, size_t size);
+        // the first four bytes of a record hold its size
+        bool TryRead(std::vector<uint8_t>& record);
+
+        // set when the owning thread exits, the ring is dropped once it was drained
+        std::atomic<bool> m_isAbandoned = false;
+
+    private:
+        void CopyIn(size_t position, const uint8_t* data, size_t size);
+        void CopyOut(size_t position, uint8_t* data, size_t size) const;
+
+        std::vector<uint8_t> m_buffer;
+        size_t m_mask;
+        std::atomic<size_t> m_writePosition = 0;
+        std::atomic<size_t> m_readPosition = 0;
+    };
+
+    // argument types that can be copied as bytes and formatted later, strings are copied as characters
+    template<typename T, typename = void>
+    struct LogArgument
+    {
+        static constexpr bool s_isDeferrable = false;
+    };
+
+    template<typename T>
+    struct LogArgument<T, std::enable_if_t<std::is_arithmetic_v<T>>>
+    {
+        static constexpr bool s_isDeferrable = true;
+
+        static size_t GetSize(const T&)
+        {
+            return sizeof(T);
+        }
+
+        static void Write(uint8_t*& data, const T& argument)
+        {
+            memcpy(data, &argument, sizeof(T));
+            data += sizeof(T);
+        }
+
+        static T Read(const uint8_t*& data)
+        {
+            T argument;
+            memcpy(&argument, data, sizeof(T));
+            data += sizeof(T);
+            return argument;
+        }
+    };
+
+    template<typename T>
+    struct LogArgument<T, std::enable_if_t<std::is_convertible_v<const T&, std::string_view>>>
+    {
+        static constexpr bool s_isDeferrable = true;
+
+        static size_t GetSize(const T& argument)
+        {
+            return sizeof(uint32_t) + std::string_view(argument).size();
+        }
+
+        static void Write(uint8_t*& data, const T& argument)
+        {
+            std::string_view string(argument);
+            uint32_t length = static_cast<uint32_t>(string.size());
+            memcpy(data, &length, sizeof(uint32_t));
+            memcpy(data + sizeof(uint32_t), string.data(), length);
+            data += sizeof(uint32_t) + length;
+        }
+
+        static std::string_view Read(const uint8_t*& data)
+        {
+            uint32_t length;
+            memcpy(&length, data, sizeof(uint32_t));
+            std::string_view string(reinterpret_cast<const char*>(data + sizeof(uint32_t)), length);
+            data += sizeof(uint32_t) + length;
+            return string;
+        }
+    };
+
+    // the calling thread only copies the format string and the argument bytes into its own ring, the logging
+    // thread formats the records in timestamp order and writes them to the sinks
+    class AsyncLogger
+    {
+    public:
+        struct Description
+        {
+            bool isConsoleEnabled = true;
+            // rotating log files are written when a path is set
+            std::string filePath;
+            size_t maxFileSize = 5 * 1024 * 1024;
+            size_t maxFileCount = 3;
+            // bytes per logging thread, a full ring makes its thread wait for the logging thread
+            size_t ringCapacity = 256 * 1024;
+        };
+
+        static void Start(const Description& description);
+        // drains all rings, no other thread may log while it stops
+        static void Stop();
+        static bool IsRunning();
+
+        // blocks until every record pushed before was written
+        static void Flush();
+
+        template<typename FormatString, typename... Args>
+        static void Push(spdlog::logger* handle, spdlog::level::level_enum level, const FormatString& format, const Args &... args)
+        {
+            // the format string is copied into the record, so any string can be deferred, other formats and
+            // arguments that are not copyable as bytes are formatted right away
+            if constexpr (sizeof...(Args) == 0 && LogArgument<FormatString>::s_isDeferrable)
+                PushRecord(handle, level, "{}", format);
+            else if constexpr (sizeof...(Args) == 0)
+                PushRecord(handle, level, "{}", fmt::format("{}", format));
+            else if constexpr (LogArgument<FormatString>::s_isDeferrable && (LogArgument<Args>::s_isDeferrable && ...))
+                PushRecord(handle, level, std::string_view(format), args...);
+            else
+            {
+                // a bad format string becomes an error record instead of an exception, like the error handler of spdlog
+                spdlog::string_view_t formatView(format);
+                try
+                {
+                    PushRecord(handle, level, "{}", fmt::vformat(formatView, fmt::make_format_args(args...)));
+                }
+                catch (const std::exception& exception)
+                {
+                    PushRecord(handle, spdlog::level::err, "{}", GetFormatErrorMessage(std::string_view(formatView.data(), formatView.size()), exception));
+                }
+            }
+
+            if (level >= spdlog::level::critical)
+                Flush();
+        }
+
+    private:
+        using FormatFunction = std::string(*)(std::string_view format, const uint8_t* arguments);
+
+        // followed by the characters of the format string and the argument bytes
+        struct RecordHeader
+        {
+            uint32_t size;
+            FormatFunction formatFunction;
+            spdlog::logger* handle;
+            spdlog::level::level_enum level;
+            spdlog::log_clock::time_point time;
+            uint32_t formatLength;
+        };
+
+        struct FormattedRecord
+        {
+            spdlog::log_clock::time_point time;
+            spdlog::logger* handle;
+            spdlog::level::level_enum level;
+            std::string message;
+        };
+
+        template<typename... Args>
+        static void PushRecord(spdlog::logger* handle, spdlog::level::level_enum level, std::string_view format, const Args &... args)
+        {
+            std::vector<uint8_t>& record = GetThreadRecordBuffer();
+            record.resize(sizeof(RecordHeader) + format.size() + (LogArgument<Args>::GetSize(args) + ... + 0));
+
+            RecordHeader header = { static_cast<uint32_t>(record.size()), &FormatArguments<Args...>, handle, level, spdlog::log_clock::now(), static_cast<uint32_t>(format.size()) };
+            memcpy(record.data(), &header, sizeof(RecordHeader));
+            memcpy(record.data() + sizeof(RecordHeader), format.data(), format.size());
+            uint8_t* data = record.data() + sizeof(RecordHeader) + format.size();
+            (LogArgument<Args>::Write(data, args), ...);
+
+            Enqueue(record);
+        }
+
+        template<typename... Args>
+        static std::string FormatArguments(std::string_view format, const uint8_t* data)
+        {
+            // braced initialization reads the arguments in order
+            std::tuple<decltype(LogArgument<Args>::Read(data))...> arguments{ LogArgument<Args>::Read(data)... };
+            return std::apply([format](const auto &... arguments)
+                {
+                    return fmt::vformat(spdlog::string_view_t(format.data(), format.size()), fmt::make_format_args(arguments...));
+                }, arguments);
+        }
+
+        // fmt::format_error and every other exception thrown while formatting
+        static std::string GetFormatErrorMessage(std::string_view format, const std::exception& exception);
+        static std::vector<uint8_t>& GetThreadRecordBuffer();
+        static void Enqueue(const std::vector<uint8_t>& record);
+        static void WakeUp();
+        static bool AreRingsEmpty();
+        static FormattedRecord FormatRecord(const std::vector<uint8_t>& record);
+        static void WriteRecord(const FormattedRecord& record);
+        static void Run();
+
+        static std::atomic<bool> s_isRunning;
+        static size_t s_ringCapacity;
+        static std::vector<spdlog::sink_ptr> s_sinks;
+        static std::vector<std::shared_ptr<LogRing>> s_rings;
+        static std::mutex s_ringMutex;
+        // held by the logging thread from reading records until they are written
+        static std::mutex s_writeMutex;
+        static std::mutex s_mutex;
+        static std::condition_variable s_condition;
+        static bool s_isStopRequested;
+        // the logging thread sleeps without a timeout while all rings are empty, writers wake it up
+        static std::atomic<bool> s_isWaiting;
+        static bool s_isWakeUpRequested;
+        static std::thread s_thread;
+    };
+}
\ No newline at end of file
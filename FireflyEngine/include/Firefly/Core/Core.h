@@ -4,7 +4,7 @@
 #include "Core/Logger.h"
 
 #ifdef DEBUG
-#define FIREFLY_ASSERT(condition, ...) {if(!(condition)) {Firefly::Logger::Critical("Assert", __VA_ARGS__); __debugbreak();}}
+#define FIREFLY_ASSERT(condition, ...) {if(!(condition)) {FIREFLY_LOG_CRITICAL("Assert", __VA_ARGS__); __debugbreak();}}
 #else
 #define FIREFLY_ASSERT(condition, ...)
 #endif
\ No newline at end of file
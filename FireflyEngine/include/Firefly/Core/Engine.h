@@ -2,6 +2,8 @@
 
 #include <chrono>
 
+#include "Core/FrameLimiter.h"
+
 namespace Firefly
 {
     struct Application;
@@ -21,6 +23,7 @@ namespace Firefly
         bool m_isInitialized = false;
         bool m_isRunning = true;
         std::chrono::steady_clock::time_point m_lastFrameTime;
+        FrameLimiter m_frameLimiter;
     };
 
     extern Application* InstantiateApplication();
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <chrono>
+
+namespace Firefly
+{
+    // paces frames to a target rate by sleeping for the bulk of the remaining frame time and spinning for the rest,
+    // the spin tail covers the largest recently measured sleep overshoot of the os scheduler
+    class FrameLimiter
+    {
+    public:
+        ~FrameLimiter();
+
+        void Reset();
+        void WaitForNextFrame(float frameRate);
+
+    private:
+        void SleepUntil(std::chrono::steady_clock::time_point time);
+        // the default windows timer wakes sleeps up to 15.6 ms late, which would leave most of a frame to the spin tail,
+        // the resolution is only raised while a rate is limited, since it costs power system wide
+        void SetTimerResolutionRaised(bool isRaised);
+
+        static constexpr std::chrono::microseconds s_sleepDuration = std::chrono::microseconds(1000);
+
+        std::chrono::steady_clock::time_point m_nextFrameTime;
+        std::chrono::duration<float> m_sleepOvershoot = std::chrono::duration<float>(0.002f);
+        bool m_isTimerResolutionRaised = false;
+    };
+}
\ No newline at end of file
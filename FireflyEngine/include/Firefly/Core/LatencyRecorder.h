@@ -0,0 +1,32 @@
+#pragma once
+
+#include <mutex>
+
+namespace Firefly
+{
+    struct LatencyPercentiles
+    {
+        float p50 = 0.0f;
+        float p95 = 0.0f;
+        float p99 = 0.0f;
+        uint32_t sampleCount = 0;
+    };
+
+    // keeps the newest latency samples in seconds, samples can be added and read from different threads
+    class LatencyRecorder
+    {
+    public:
+        LatencyRecorder(uint32_t capacity = 1024);
+
+        void AddSample(float latency);
+        // sorts a copy of the samples, meant for occasional queries and not for every frame
+        LatencyPercentiles GetPercentiles() const;
+        void Reset();
+
+    private:
+        mutable std::mutex m_mutex;
+        std::vector<float> m_samples;
+        uint32_t m_capacity;
+        uint32_t m_nextSampleIndex = 0;
+    };
+}
\ No newline at end of file
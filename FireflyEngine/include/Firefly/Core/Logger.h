@@ -3,107 +3,76 @@
 #include "Core.h"
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include "Core/AsyncLogger.h"
+
+#include <mutex>
+
+// same values as the spdlog levels
+#define FIREFLY_LOG_LEVEL_TRACE     0
+#define FIREFLY_LOG_LEVEL_DEBUG     1
+#define FIREFLY_LOG_LEVEL_INFO      2
+#define FIREFLY_LOG_LEVEL_WARN      3
+#define FIREFLY_LOG_LEVEL_ERROR     4
+#define FIREFLY_LOG_LEVEL_CRITICAL  5
+#define FIREFLY_LOG_LEVEL_OFF       6
+
+// levels below are compiled out together with the evaluation of their arguments
+#ifndef FIREFLY_LOG_ACTIVE_LEVEL
+#define FIREFLY_LOG_ACTIVE_LEVEL FIREFLY_LOG_LEVEL_TRACE
+#endif
+
+// the logger of a call site is looked up once and kept in a static, a level disabled at runtime costs one branch
+#define FIREFLY_LOG(logLevel, name, ...) \
+    do \
+    { \
+        if constexpr (logLevel >= FIREFLY_LOG_ACTIVE_LEVEL) \
+        { \
+            static Firefly::Logger::Handle s_fireflyLogHandle = Firefly::Logger::GetHandle(name); \
+            if (s_fireflyLogHandle->should_log(static_cast<spdlog::level::level_enum>(logLevel))) \
+                Firefly::Logger::Log(s_fireflyLogHandle, static_cast<spdlog::level::level_enum>(logLevel), __VA_ARGS__); \
+        } \
+    } while (false)
+
+#define FIREFLY_LOG_TRACE(name, ...)    FIREFLY_LOG(FIREFLY_LOG_LEVEL_TRACE, name, __VA_ARGS__)
+#define FIREFLY_LOG_DEBUG(name, ...)    FIREFLY_LOG(FIREFLY_LOG_LEVEL_DEBUG, name, __VA_ARGS__)
+#define FIREFLY_LOG_INFO(name, ...)     FIREFLY_LOG(FIREFLY_LOG_LEVEL_INFO, name, __VA_ARGS__)
+#define FIREFLY_LOG_WARN(name, ...)     FIREFLY_LOG(FIREFLY_LOG_LEVEL_WARN, name, __VA_ARGS__)
+#define FIREFLY_LOG_ERROR(name, ...)    FIREFLY_LOG(FIREFLY_LOG_LEVEL_ERROR, name, __VA_ARGS__)
+#define FIREFLY_LOG_CRITICAL(name, ...) FIREFLY_LOG(FIREFLY_LOG_LEVEL_CRITICAL, name, __VA_ARGS__)
 
 namespace Firefly
 {
     class Logger
     {
     public:
-        static void Init();
-
-        // trace
-        template<typename T>
-        static void Trace(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->trace(msg);
-        }
-
-        template<typename... Args>
-        static void Trace(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->trace(fmt, args...);
-        }
-
-        // debug
-        template<typename T>
-        static void Debug(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->debug(msg);
-        }
-
-        template<typename... Args>
-        static void Debug(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->debug(fmt, args...);
-        }
-
-        // info
-        template<typename T>
-        static void Info(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->info(msg);
-        }
+        // loggers live until shutdown, so a handle stays valid once it was looked up
+        using Handle = spdlog::logger*;
 
-        template<typename... Args>
-        static void Info(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->info(fmt, args...);
-        }
-
-        // warn
-        template<typename T>
-        static void Warn(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->warn(msg);
-        }
-
-        template<typename... Args>
-        static void Warn(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->warn(fmt, args...);
-        }
+        static void Init();
 
-        // error
-        template<typename T>
-        static void Error(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->error(msg);
-        }
+        // thread safe, creates the logger on first use
+        static Handle GetHandle(const std::string& name);
 
-        template<typename... Args>
-        static void Error(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->error(fmt, args...);
-        }
+        // runtime threshold of all loggers on top of FIREFLY_LOG_ACTIVE_LEVEL
+        static void SetLevel(spdlog::level::level_enum level);
 
-        // critical
-        template<typename T>
-        static void Critical(const std::string& name, const T& msg)
-        {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->critical(msg);
-        }
+        static constexpr const char* s_pattern = "%^[%T] %-8l (%n): %v%$";
 
-        template<typename... Args>
-        static void Critical(const std::string& name, spdlog::string_view_t fmt, const Args &... args)
+        // formats right away or hands the record to the logging thread while the AsyncLogger runs
+        template<typename FormatString, typename... Args>
+        static void Log(Handle handle, spdlog::level::level_enum level, const FormatString& fmt, const Args &... args)
         {
-            std::shared_ptr<spdlog::logger> logger = GetLoggerByName(name);
-            logger->critical(fmt, args...);
+            if (AsyncLogger::IsRunning())
+                AsyncLogger::Push(handle, level, fmt, args...);
+            else if constexpr (sizeof...(Args) == 0)
+                handle->log(level, fmt);
+            else
+                handle->log(level, spdlog::string_view_t(fmt), args...);
         }
 
     private:
-        static std::shared_ptr<spdlog::logger> GetLoggerByName(const std::string& name);
-
-        static std::vector<std::shared_ptr<spdlog::logger>> s_loggers;
+        static std::mutex s_mutex;
+        static std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> s_loggers;
+        static spdlog::level::level_enum s_level;
     };
 }
\ No newline at end of file
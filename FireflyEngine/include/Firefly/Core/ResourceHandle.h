@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Firefly
+{
+    class Shader;
+    class Material;
+    class Texture;
+    class Mesh;
+
+    // 32 bit reference to a slot of a ResourceRegistry, the low bits are the slot index and the high bits the generation
+    // of the slot when the handle was created, a removed resource bumps the generation so its old handles stop resolving
+    template <typename TResource>
+    class ResourceHandle
+    {
+    public:
+        static constexpr uint32_t s_indexBits = 20;
+        static constexpr uint32_t s_generationBits = 32 - s_indexBits;
+        static constexpr uint32_t s_maxIndex = (1u << s_indexBits) - 1;
+        static constexpr uint32_t s_maxGeneration = (1u << s_generationBits) - 1;
+
+        ResourceHandle() = default;
+        ResourceHandle(uint32_t index, uint32_t generation) :
+            m_value((generation << s_indexBits) | index) {}
+
+        uint32_t GetIndex() const { return m_value & s_maxIndex; }
+        uint32_t GetGeneration() const { return m_value >> s_indexBits; }
+        uint32_t GetValue() const { return m_value; }
+
+        // slot generations start at one, so the default handle never resolves
+        bool IsValid() const { return m_value != 0; }
+        explicit operator bool() const { return IsValid(); }
+
+        bool operator==(const ResourceHandle& other) const { return m_value == other.m_value; }
+        bool operator!=(const ResourceHandle& other) const { return m_value != other.m_value; }
+
+    private:
+        uint32_t m_value = 0;
+    };
+
+    typedef ResourceHandle<Shader> ShaderHandle;
+    typedef ResourceHandle<Material> MaterialHandle;
+    typedef ResourceHandle<Texture> TextureHandle;
+    typedef ResourceHandle<Mesh> MeshHandle;
+}
\ No newline at end of file
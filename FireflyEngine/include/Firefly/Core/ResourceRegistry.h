@@ -1,9 +1,13 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <type_traits>
 
+#include "Core/ResourceHandle.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Material.h"
 #include "Rendering/Texture.h"
@@ -11,48 +15,204 @@
 
 namespace Firefly
 {
+    // resources live in slot chunks addressed by generational handles, names are only looked up while loading and
+    // the frame loop resolves handles by indexing the slots without touching the reference counts
+    // slots are only written by the main thread, e.g. by ResourceLoader::Update, and chunks never move once allocated,
+    // so Get and IsAlive are lock-free from any thread, the names and the owning references are guarded by a mutex
     template <typename TResource>
     class ResourceRegistry
     {
     public:
+        typedef ResourceHandle<TResource> Handle;
+
         static ResourceRegistry<TResource>& Instance()
         {
             static ResourceRegistry<TResource> registry;
             return registry;
         }
 
-        void Insert(const std::string& name, std::shared_ptr<TResource> resource)
+        // a name that is already taken keeps its resource and the handle of that resource is returned
+        Handle Insert(const std::string& name, std::shared_ptr<TResource> resource)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto handle = m_handles.find(name);
+            if (handle != m_handles.end())
+                return handle->second;
+
+            Handle newHandle = InsertUnlocked(resource);
+            GetSlot(newHandle.GetIndex()).name = name;
+            m_handles.emplace(name, newHandle);
+            return newHandle;
+        }
+
+        Handle Insert(std::shared_ptr<TResource> resource)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return InsertUnlocked(resource);
+        }
+
+        // swaps the resource behind a handle, e.g. a loaded resource for its placeholder, and returns the previous one
+        std::shared_ptr<TResource> Replace(Handle handle, std::shared_ptr<TResource> resource)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!IsAlive(handle))
+                return nullptr;
+
+            Slot& slot = GetSlot(handle.GetIndex());
+            slot.pointer.store(resource.get(), std::memory_order_release);
+            std::swap(slot.resource, resource);
+            return resource;
+        }
+
+        // releases the reference of the registry, the caller destroys the resource once nothing draws it anymore
+        std::shared_ptr<TResource> Remove(Handle handle)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return RemoveUnlocked(handle);
+        }
+
+        Handle GetHandle(const std::string& name) const
         {
-            if (m_resources.find(name) == m_resources.end())
-                m_resources[name] = resource;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return GetHandleUnlocked(name);
+        }
+
+        bool IsAlive(Handle handle) const
+        {
+            return Get(handle) != nullptr;
+        }
+
+        // nullptr for handles of removed resources, the pointer stays valid until the resource is removed or replaced
+        TResource* Get(Handle handle) const
+        {
+            uint32_t index = handle.GetIndex();
+            if (!handle.IsValid() || index >= m_slotCount.load(std::memory_order_acquire))
+                return nullptr;
+
+            // the pointer is read first, a slot that got reused since then has a newer generation
+            const Slot& slot = GetSlot(index);
+            TResource* resource = slot.pointer.load(std::memory_order_acquire);
+            return slot.generation.load(std::memory_order_acquire) == handle.GetGeneration() ? resource : nullptr;
         }
 
-        std::shared_ptr<TResource> Retrieve(const std::string& name)
+        std::shared_ptr<TResource> Retrieve(Handle handle) const
         {
-            if (m_resources.find(name) != m_resources.end())
-                return m_resources[name];
-            return nullptr;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return IsAlive(handle) ? GetSlot(handle.GetIndex()).resource : nullptr;
         }
 
-        std::vector<std::shared_ptr<TResource>> GetAll() const
+        std::shared_ptr<TResource> Retrieve(const std::string& name) const
         {
-            std::vector<std::shared_ptr<TResource>> resources;
-            for (auto resourceEntry : m_resources)
-                resources.push_back(resourceEntry.second);
-            return resources;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Handle handle = GetHandleUnlocked(name);
+            return IsAlive(handle) ? GetSlot(handle.GetIndex()).resource : nullptr;
+        }
+
+        // func(Handle, const std::shared_ptr<TResource>&) is called under the lock and must not change this registry
+        template <typename Func>
+        void Each(Func func) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uint32_t slotCount = m_slotCount.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < slotCount; i++)
+            {
+                const Slot& slot = GetSlot(i);
+                if (slot.resource)
+                    func(Handle(i, slot.generation.load(std::memory_order_relaxed)), slot.resource);
+            }
         }
 
         void DestroyResources()
         {
-            for (auto resourceEntry : m_resources)
-                resourceEntry.second->Destroy();
-            m_resources.clear();
+            std::lock_guard<std::mutex> lock(m_mutex);
+            uint32_t slotCount = m_slotCount.load(std::memory_order_relaxed);
+            for (uint32_t i = 0; i < slotCount; i++)
+            {
+                const Slot& slot = GetSlot(i);
+                if (slot.resource)
+                    RemoveUnlocked(Handle(i, slot.generation.load(std::memory_order_relaxed)))->Destroy();
+            }
         }
 
     private:
+        static constexpr uint32_t s_chunkSize = 1024;
+        static constexpr uint32_t s_maxChunkCount = (Handle::s_maxIndex + s_chunkSize) / s_chunkSize;
+
+        struct Slot
+        {
+            // the raw pointer mirrors the owning reference for the lock-free lookups
+            std::atomic<TResource*> pointer = nullptr;
+            std::atomic<uint32_t> generation = 1;
+            std::shared_ptr<TResource> resource;
+            std::string name;
+        };
+
         ResourceRegistry() {};
 
-        std::unordered_map<std::string, std::shared_ptr<TResource>> m_resources;
+        Slot& GetSlot(uint32_t index) const
+        {
+            return m_chunks[index / s_chunkSize][index % s_chunkSize];
+        }
+
+        Handle InsertUnlocked(std::shared_ptr<TResource> resource)
+        {
+            uint32_t index;
+            if (!m_freeIndices.empty())
+            {
+                index = m_freeIndices.back();
+                m_freeIndices.pop_back();
+            }
+            else
+            {
+                index = m_slotCount.load(std::memory_order_relaxed);
+                FIREFLY_ASSERT(index <= Handle::s_maxIndex, "Too many resources in the registry!");
+                if (index % s_chunkSize == 0)
+                    m_chunks[index / s_chunkSize] = std::make_unique<Slot[]>(s_chunkSize);
+            }
+
+            Slot& slot = GetSlot(index);
+            slot.resource = resource;
+            slot.pointer.store(resource.get(), std::memory_order_release);
+            // a new slot is published after its chunk, so lookups never index a chunk that is being allocated
+            if (index == m_slotCount.load(std::memory_order_relaxed))
+                m_slotCount.store(index + 1, std::memory_order_release);
+            return Handle(index, slot.generation.load(std::memory_order_relaxed));
+        }
+
+        std::shared_ptr<TResource> RemoveUnlocked(Handle handle)
+        {
+            if (!IsAlive(handle))
+                return nullptr;
+
+            uint32_t index = handle.GetIndex();
+            Slot& slot = GetSlot(index);
+            slot.pointer.store(nullptr, std::memory_order_release);
+            std::shared_ptr<TResource> resource = std::move(slot.resource);
+            slot.resource = nullptr;
+            if (!slot.name.empty())
+            {
+                m_handles.erase(slot.name);
+                slot.name.clear();
+            }
+
+            // generation zero is skipped on wrap around, it would make the handle of slot zero invalid
+            uint32_t generation = slot.generation.load(std::memory_order_relaxed);
+            slot.generation.store(generation == Handle::s_maxGeneration ? 1 : generation + 1, std::memory_order_release);
+            m_freeIndices.push_back(index);
+            return resource;
+        }
+
+        Handle GetHandleUnlocked(const std::string& name) const
+        {
+            auto handle = m_handles.find(name);
+            return handle != m_handles.end() ? handle->second : Handle();
+        }
+
+        mutable std::mutex m_mutex;
+        std::array<std::unique_ptr<Slot[]>, s_maxChunkCount> m_chunks;
+        std::atomic<uint32_t> m_slotCount = 0;
+        std::vector<uint32_t> m_freeIndices;
+        std::unordered_map<std::string, Handle> m_handles;
     };
 
     typedef ResourceRegistry<Shader> ShaderRegistry;
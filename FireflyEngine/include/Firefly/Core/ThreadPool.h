@@ -0,0 +1,80 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+namespace Firefly
+{
+    class ThreadPool
+    {
+    public:
+        static ThreadPool& Instance();
+
+        ThreadPool(uint32_t threadCount);
+        ~ThreadPool();
+
+        void Submit(std::function<void()> task);
+
+        // calls func(begin, end) for chunks of at most grainSize indices, the calling thread helps until all chunks are done
+        template<typename Func>
+        void ParallelFor(size_t count, size_t grainSize, Func&& func)
+        {
+            if (count == 0)
+                return;
+
+            grainSize = std::max<size_t>(grainSize, 1);
+            size_t chunkCount = (count + grainSize - 1) / grainSize;
+            if (chunkCount == 1 || m_threads.empty())
+            {
+                func(size_t(0), count);
+                return;
+            }
+
+            struct ParallelForState
+            {
+                std::atomic<size_t> nextChunk = 0;
+                std::atomic<size_t> doneChunkCount = 0;
+                std::mutex mutex;
+                std::condition_variable condition;
+            };
+            auto state = std::make_shared<ParallelForState>();
+
+            auto processChunks = [state, count, grainSize, chunkCount, &func]()
+            {
+                size_t chunk;
+                while ((chunk = state->nextChunk.fetch_add(1)) < chunkCount)
+                {
+                    size_t begin = chunk * grainSize;
+                    func(begin, std::min(begin + grainSize, count));
+                    if (state->doneChunkCount.fetch_add(1) + 1 == chunkCount)
+                    {
+                        std::lock_guard<std::mutex> lock(state->mutex);
+                        state->condition.notify_all();
+                    }
+                }
+            };
+
+            size_t helperCount = std::min(chunkCount - 1, m_threads.size());
+            for (size_t i = 0; i < helperCount; i++)
+                Submit(processChunks);
+            processChunks();
+
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->condition.wait(lock, [&state, chunkCount]() { return state->doneChunkCount.load() == chunkCount; });
+        }
+
+        uint32_t GetThreadCount() const;
+
+    private:
+        void WorkerLoop();
+
+        std::vector<std::thread> m_threads;
+        std::queue<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_isRunning = true;
+    };
+}
\ No newline at end of file
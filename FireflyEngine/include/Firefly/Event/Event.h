@@ -3,28 +3,87 @@
 #include "Core/Core.h"
 #include "pch.h"
 
+#include <chrono>
+#include <new>
+
 namespace Firefly
 {
-    class Event : public std::enable_shared_from_this<Event>
+    // ordered by category so that every category and sub category is a contiguous range of types
+    enum class EventType : uint8_t
+    {
+        WindowResize,
+        WindowClose,
+        WindowMaximize,
+        WindowMinimize,
+        WindowRestore,
+        WindowMove,
+        KeyPress,
+        KeyRelease,
+        KeyRepeat,
+        MouseButtonPress,
+        MouseButtonRelease,
+        MouseMove,
+        MouseScroll,
+        GamepadConnected,
+        GamepadDisconnected,
+        GamepadButtonPress,
+        GamepadButtonRelease,
+        GamepadAxisLeftMove,
+        GamepadAxisRightMove,
+        GamepadTriggerLeftMove,
+        GamepadTriggerRightMove,
+        Count
+    };
+
+    enum class EventCategory : uint8_t
+    {
+        Window,
+        Key,
+        Mouse,
+        Gamepad
+    };
+
+    // an event stores its payload by value, payloads are small trivially copyable classes that name the range of types
+    // they cover, one type for a concrete event and all types of a category for the category classes
+    class Event
     {
     public:
         template<typename T>
-        bool IsType()
+        explicit Event(const T& payload) :
+            m_type(T::s_firstType),
+            m_timestamp(std::chrono::steady_clock::now())
         {
-            if (std::dynamic_pointer_cast<T>(shared_from_this()) != nullptr)
-                return true;
-            else
-                return false;
+            static_assert(T::s_firstType == T::s_lastType, "Only concrete events can be stored!");
+            static_assert(std::is_trivially_copyable_v<T> && sizeof(T) <= s_maxPayloadSize, "Event payloads have to be small and trivially copyable!");
+            new (m_payload) T(payload);
         }
 
+        inline EventType GetType() const { return m_type; }
+        EventCategory GetCategory() const;
+        // when the event was created, for input events this is when the window callback reported it
+        inline std::chrono::steady_clock::time_point GetTimestamp() const { return m_timestamp; }
+
         template<typename T>
-        std::shared_ptr<T> AsType()
+        bool IsType() const
         {
-            return std::dynamic_pointer_cast<T>(shared_from_this());
+            return m_type >= T::s_firstType && m_type <= T::s_lastType;
         }
 
-        virtual std::string ToString() const = 0;
-    };
+        template<typename T>
+        const T* AsType() const
+        {
+            if (!IsType<T>())
+                return nullptr;
+            return std::launder(reinterpret_cast<const T*>(m_payload));
+        }
 
-    class InputEvent : public Event {};
-}
+        std::string ToString() const;
+
+    private:
+        static constexpr size_t s_maxPayloadSize = 16;
+
+        EventType m_type;
+        std::chrono::steady_clock::time_point m_timestamp;
+        alignas(8) unsigned char m_payload[s_maxPayloadSize];
+    };
+}
\ No newline at end of file
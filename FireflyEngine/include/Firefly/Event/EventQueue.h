@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Event/Event.h"
+
+namespace Firefly
+{
+    // the events of a frame are queued by value, the storage is kept between frames so queueing does not allocate once
+    // it grew to the event count of a busy frame
+    class EventQueue
+    {
+    public:
+        template<typename T>
+        void Push(const T& payload)
+        {
+            Push(Event(payload));
+        }
+
+        void Push(const Event& event);
+
+        // a mouse move replaces a mouse move right before it, handlers only see the newest position
+        void SetMouseMoveCoalescingEnabled(bool enabled);
+
+        // events queued by the callback are dispatched in the same call
+        void Dispatch(const std::function<void(const Event&)>& callback);
+
+    private:
+        std::vector<Event> m_events;
+        bool m_isMouseMoveCoalescingEnabled = false;
+    };
+}
\ No newline at end of file
@@ -4,49 +4,65 @@
 
 namespace Firefly
 {
-    class GamepadEvent : public InputEvent
+    class GamepadEvent
     {
     public:
-        GamepadEvent(int gamepadNumber, const std::string& gamepadName) :
-            m_gamepadNumber(gamepadNumber), m_gamepadName(gamepadName) {}
+        static constexpr EventType s_firstType = EventType::GamepadConnected;
+        static constexpr EventType s_lastType = EventType::GamepadTriggerRightMove;
 
-        inline int GetGamepadNumber() { return m_gamepadNumber; }
-        inline std::string GetGamepadName() { return m_gamepadName; }
+        GamepadEvent(int gamepadNumber) :
+            m_gamepadNumber(gamepadNumber) {}
+
+        inline int GetGamepadNumber() const { return m_gamepadNumber; }
 
     protected:
         int m_gamepadNumber;
-        std::string m_gamepadName;
     };
 
     class GamepadConnectedEvent : public GamepadEvent
     {
     public:
-        GamepadConnectedEvent(int gamepadNumber, const std::string& gamepadName) :
-            GamepadEvent(gamepadNumber, gamepadName) {}
+        static constexpr EventType s_firstType = EventType::GamepadConnected;
+        static constexpr EventType s_lastType = EventType::GamepadConnected;
+
+        // the name is owned by the windowing library and stays valid until the gamepad is disconnected
+        GamepadConnectedEvent(int gamepadNumber, const char* gamepadName) :
+            GamepadEvent(gamepadNumber), m_gamepadName(gamepadName) {}
 
-        virtual std::string ToString() const override
+        inline const char* GetGamepadName() const { return m_gamepadName; }
+
+        std::string ToString() const
         {
-            return "GamepadConnectedEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ")";
+            return "GamepadConnectedEvent: " + std::string(m_gamepadName) + "(" + std::to_string(m_gamepadNumber) + ")";
         }
+
+    protected:
+        const char* m_gamepadName;
     };
 
     class GamepadDisconnectedEvent : public GamepadEvent
     {
     public:
-        GamepadDisconnectedEvent(int gamepadNumber, const std::string& gamepadName) :
-            GamepadEvent(gamepadNumber, gamepadName) {}
+        static constexpr EventType s_firstType = EventType::GamepadDisconnected;
+        static constexpr EventType s_lastType = EventType::GamepadDisconnected;
+
+        GamepadDisconnectedEvent(int gamepadNumber) :
+            GamepadEvent(gamepadNumber) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
-            return "GamepadDisconnectedEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ")";
+            return "GamepadDisconnectedEvent: " + std::to_string(m_gamepadNumber);
         }
     };
 
     class GamepadButtonEvent : public GamepadEvent
     {
     public:
-        GamepadButtonEvent(int gamepadNumber, const std::string& gamepadName, int buttonCode) :
-            GamepadEvent(gamepadNumber, gamepadName), m_buttonCode(buttonCode) {}
+        static constexpr EventType s_firstType = EventType::GamepadButtonPress;
+        static constexpr EventType s_lastType = EventType::GamepadButtonRelease;
+
+        GamepadButtonEvent(int gamepadNumber, int buttonCode) :
+            GamepadEvent(gamepadNumber), m_buttonCode(buttonCode) {}
 
         inline int GetButtonCode() const { return m_buttonCode; }
 
@@ -57,32 +73,41 @@ namespace Firefly
     class GamepadButtonPressEvent : public GamepadButtonEvent
     {
     public:
-        GamepadButtonPressEvent(int gamepadNumber, const std::string& gamepadName, int buttonCode) :
-            GamepadButtonEvent(gamepadNumber, gamepadName, buttonCode) {}
+        static constexpr EventType s_firstType = EventType::GamepadButtonPress;
+        static constexpr EventType s_lastType = EventType::GamepadButtonPress;
+
+        GamepadButtonPressEvent(int gamepadNumber, int buttonCode) :
+            GamepadButtonEvent(gamepadNumber, buttonCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
-            return "GamepadButtonPressEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_buttonCode);
+            return "GamepadButtonPressEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_buttonCode);
         }
     };
 
     class GamepadButtonReleaseEvent : public GamepadButtonEvent
     {
     public:
-        GamepadButtonReleaseEvent(int gamepadNumber, const std::string& gamepadName, int buttonCode) :
-            GamepadButtonEvent(gamepadNumber, gamepadName, buttonCode) {}
+        static constexpr EventType s_firstType = EventType::GamepadButtonRelease;
+        static constexpr EventType s_lastType = EventType::GamepadButtonRelease;
 
-        virtual std::string ToString() const override
+        GamepadButtonReleaseEvent(int gamepadNumber, int buttonCode) :
+            GamepadButtonEvent(gamepadNumber, buttonCode) {}
+
+        std::string ToString() const
         {
-            return "GamepadButtonReleaseEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_buttonCode);
+            return "GamepadButtonReleaseEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_buttonCode);
         }
     };
 
     class GamepadAxisMoveEvent : public GamepadEvent
     {
     public:
-        GamepadAxisMoveEvent(int gamepadNumber, const std::string& gamepadName, float xPos, float yPos) :
-            GamepadEvent(gamepadNumber, gamepadName), m_xPos(xPos), m_yPos(yPos) {}
+        static constexpr EventType s_firstType = EventType::GamepadAxisLeftMove;
+        static constexpr EventType s_lastType = EventType::GamepadAxisRightMove;
+
+        GamepadAxisMoveEvent(int gamepadNumber, float xPos, float yPos) :
+            GamepadEvent(gamepadNumber), m_xPos(xPos), m_yPos(yPos) {}
 
         inline float GetXPos() const { return m_xPos; }
         inline float GetYPos() const { return m_yPos; }
@@ -94,32 +119,41 @@ namespace Firefly
     class GamepadAxisLeftMoveEvent : public GamepadAxisMoveEvent
     {
     public:
-        GamepadAxisLeftMoveEvent(int gamepadNumber, const std::string& gamepadName, float xPos, float yPos) :
-            GamepadAxisMoveEvent(gamepadNumber, gamepadName, xPos, yPos) {}
+        static constexpr EventType s_firstType = EventType::GamepadAxisLeftMove;
+        static constexpr EventType s_lastType = EventType::GamepadAxisLeftMove;
 
-        virtual std::string ToString() const override
+        GamepadAxisLeftMoveEvent(int gamepadNumber, float xPos, float yPos) :
+            GamepadAxisMoveEvent(gamepadNumber, xPos, yPos) {}
+
+        std::string ToString() const
         {
-            return "GamepadAxisLeftMoveEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
+            return "GamepadAxisLeftMoveEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
         }
     };
 
     class GamepadAxisRightMoveEvent : public GamepadAxisMoveEvent
     {
     public:
-        GamepadAxisRightMoveEvent(int gamepadNumber, const std::string& gamepadName, float xPos, float yPos) :
-            GamepadAxisMoveEvent(gamepadNumber, gamepadName, xPos, yPos) {}
+        static constexpr EventType s_firstType = EventType::GamepadAxisRightMove;
+        static constexpr EventType s_lastType = EventType::GamepadAxisRightMove;
+
+        GamepadAxisRightMoveEvent(int gamepadNumber, float xPos, float yPos) :
+            GamepadAxisMoveEvent(gamepadNumber, xPos, yPos) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
-            return "GamepadAxisRightMoveEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
+            return "GamepadAxisRightMoveEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
         }
     };
 
     class GamepadTriggerMoveEvent : public GamepadEvent
     {
     public:
-        GamepadTriggerMoveEvent(int gamepadNumber, const std::string& gamepadName, float pos) :
-            GamepadEvent(gamepadNumber, gamepadName), m_pos(pos) {}
+        static constexpr EventType s_firstType = EventType::GamepadTriggerLeftMove;
+        static constexpr EventType s_lastType = EventType::GamepadTriggerRightMove;
+
+        GamepadTriggerMoveEvent(int gamepadNumber, float pos) :
+            GamepadEvent(gamepadNumber), m_pos(pos) {}
 
         inline float GetPos() const { return m_pos; }
 
@@ -130,24 +164,30 @@ namespace Firefly
     class GamepadTriggerLeftMoveEvent : public GamepadTriggerMoveEvent
     {
     public:
-        GamepadTriggerLeftMoveEvent(int gamepadNumber, const std::string& gamepadName, float pos) :
-            GamepadTriggerMoveEvent(gamepadNumber, gamepadName, pos) {}
+        static constexpr EventType s_firstType = EventType::GamepadTriggerLeftMove;
+        static constexpr EventType s_lastType = EventType::GamepadTriggerLeftMove;
+
+        GamepadTriggerLeftMoveEvent(int gamepadNumber, float pos) :
+            GamepadTriggerMoveEvent(gamepadNumber, pos) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
-            return "GamepadTriggerLeftMoveEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_pos);
+            return "GamepadTriggerLeftMoveEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_pos);
         }
     };
 
     class GamepadTriggerRightMoveEvent : public GamepadTriggerMoveEvent
     {
     public:
-        GamepadTriggerRightMoveEvent(int gamepadNumber, const std::string& gamepadName, float pos) :
-            GamepadTriggerMoveEvent(gamepadNumber, gamepadName, pos) {}
+        static constexpr EventType s_firstType = EventType::GamepadTriggerRightMove;
+        static constexpr EventType s_lastType = EventType::GamepadTriggerRightMove;
+
+        GamepadTriggerRightMoveEvent(int gamepadNumber, float pos) :
+            GamepadTriggerMoveEvent(gamepadNumber, pos) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
-            return "GamepadTriggerRightMoveEvent: " + m_gamepadName + "(" + std::to_string(m_gamepadNumber) + ") " + std::to_string(m_pos);
+            return "GamepadTriggerRightMoveEvent: " + std::to_string(m_gamepadNumber) + " " + std::to_string(m_pos);
         }
     };
 }
\ No newline at end of file
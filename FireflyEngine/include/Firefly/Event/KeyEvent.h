@@ -4,9 +4,12 @@
 
 namespace Firefly
 {
-    class KeyEvent : public InputEvent
+    class KeyEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::KeyPress;
+        static constexpr EventType s_lastType = EventType::KeyRepeat;
+
         KeyEvent(int keyCode) :
             m_keyCode(keyCode) {}
 
@@ -19,10 +22,13 @@ namespace Firefly
     class KeyPressEvent : public KeyEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::KeyPress;
+        static constexpr EventType s_lastType = EventType::KeyPress;
+
         KeyPressEvent(int keyCode) :
             KeyEvent(keyCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "KeyPressEvent: " + std::to_string(m_keyCode);
         }
@@ -31,10 +37,13 @@ namespace Firefly
     class KeyReleaseEvent : public KeyEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::KeyRelease;
+        static constexpr EventType s_lastType = EventType::KeyRelease;
+
         KeyReleaseEvent(int keyCode) :
             KeyEvent(keyCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "KeyReleaseEvent: " + std::to_string(m_keyCode);
         }
@@ -43,10 +52,13 @@ namespace Firefly
     class KeyRepeatEvent : public KeyEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::KeyRepeat;
+        static constexpr EventType s_lastType = EventType::KeyRepeat;
+
         KeyRepeatEvent(int keyCode) :
             KeyEvent(keyCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "KeyRepeatEvent: " + std::to_string(m_keyCode);
         }
@@ -4,11 +4,19 @@
 
 namespace Firefly
 {
-    class MouseEvent : public InputEvent {};
+    class MouseEvent
+    {
+    public:
+        static constexpr EventType s_firstType = EventType::MouseButtonPress;
+        static constexpr EventType s_lastType = EventType::MouseScroll;
+    };
 
     class MouseButtonEvent : public MouseEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::MouseButtonPress;
+        static constexpr EventType s_lastType = EventType::MouseButtonRelease;
+
         MouseButtonEvent(int buttonCode) :
             m_buttonCode(buttonCode) {}
 
@@ -21,10 +29,13 @@ namespace Firefly
     class MouseButtonPressEvent : public MouseButtonEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::MouseButtonPress;
+        static constexpr EventType s_lastType = EventType::MouseButtonPress;
+
         MouseButtonPressEvent(int buttonCode) :
             MouseButtonEvent(buttonCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "MouseButtonPressEvent: " + std::to_string(m_buttonCode);
         }
@@ -33,10 +44,13 @@ namespace Firefly
     class MouseButtonReleaseEvent : public MouseButtonEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::MouseButtonRelease;
+        static constexpr EventType s_lastType = EventType::MouseButtonRelease;
+
         MouseButtonReleaseEvent(int buttonCode) :
             MouseButtonEvent(buttonCode) {}
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "MouseButtonReleaseEvent: " + std::to_string(m_buttonCode);
         }
@@ -45,13 +59,16 @@ namespace Firefly
     class MouseMoveEvent : public MouseEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::MouseMove;
+        static constexpr EventType s_lastType = EventType::MouseMove;
+
         MouseMoveEvent(int xPos, int yPos) :
             m_xPos(xPos), m_yPos(yPos) {}
 
         inline int GetXPos() const { return m_xPos; }
         inline int GetYPos() const { return m_yPos; }
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "MouseMoveEvent: " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
         }
@@ -63,13 +80,16 @@ namespace Firefly
     class MouseScrollEvent : public MouseEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::MouseScroll;
+        static constexpr EventType s_lastType = EventType::MouseScroll;
+
         MouseScrollEvent(float xOffset, float yOffset) :
             m_xOffset(xOffset), m_yOffset(yOffset) {}
 
         inline float GetXOffset() const { return m_xOffset; }
         inline float GetYOffset() const { return m_yOffset; }
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "MouseScrollEvent: " + std::to_string(m_xOffset) + ", " + std::to_string(m_yOffset);
         }
@@ -4,18 +4,26 @@
 
 namespace Firefly
 {
-    class WindowEvent : public Event {};
+    class WindowEvent
+    {
+    public:
+        static constexpr EventType s_firstType = EventType::WindowResize;
+        static constexpr EventType s_lastType = EventType::WindowMove;
+    };
 
     class WindowResizeEvent : public WindowEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::WindowResize;
+        static constexpr EventType s_lastType = EventType::WindowResize;
+
         WindowResizeEvent(int width, int height) :
             m_width(width), m_height(height) {}
 
         inline int GetWidth() const { return m_width; }
         inline int GetHeight() const { return m_height; }
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "WindowResizeEvent: " + std::to_string(m_width) + ", " + std::to_string(m_height);
         }
@@ -27,7 +35,10 @@ namespace Firefly
     class WindowCloseEvent : public WindowEvent
     {
     public:
-        virtual std::string ToString() const override
+        static constexpr EventType s_firstType = EventType::WindowClose;
+        static constexpr EventType s_lastType = EventType::WindowClose;
+
+        std::string ToString() const
         {
             return "WindowCloseEvent";
         }
@@ -36,7 +47,10 @@ namespace Firefly
     class WindowMaximizeEvent : public WindowEvent
     {
     public:
-        virtual std::string ToString() const override
+        static constexpr EventType s_firstType = EventType::WindowMaximize;
+        static constexpr EventType s_lastType = EventType::WindowMaximize;
+
+        std::string ToString() const
         {
             return "WindowMaximizeEvent";
         }
@@ -45,7 +59,10 @@ namespace Firefly
     class WindowMinimizeEvent : public WindowEvent
     {
     public:
-        virtual std::string ToString() const override
+        static constexpr EventType s_firstType = EventType::WindowMinimize;
+        static constexpr EventType s_lastType = EventType::WindowMinimize;
+
+        std::string ToString() const
         {
             return "WindowMinimizeEvent";
         }
@@ -54,7 +71,10 @@ namespace Firefly
     class WindowRestoreEvent : public WindowEvent
     {
     public:
-        virtual std::string ToString() const override
+        static constexpr EventType s_firstType = EventType::WindowRestore;
+        static constexpr EventType s_lastType = EventType::WindowRestore;
+
+        std::string ToString() const
         {
             return "WindowRestoreEvent";
         }
@@ -63,13 +83,16 @@ namespace Firefly
     class WindowMoveEvent : public WindowEvent
     {
     public:
+        static constexpr EventType s_firstType = EventType::WindowMove;
+        static constexpr EventType s_lastType = EventType::WindowMove;
+
         WindowMoveEvent(int xPos, int yPos) :
             m_xPos(xPos), m_yPos(yPos) {}
 
         inline int GetXPos() const { return m_xPos; }
         inline int GetYPos() const { return m_yPos; }
 
-        virtual std::string ToString() const override
+        std::string ToString() const
         {
             return "WindowMoveEvent: " + std::to_string(m_xPos) + ", " + std::to_string(m_yPos);
         }
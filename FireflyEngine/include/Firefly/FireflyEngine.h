@@ -10,4 +10,6 @@
 #include "Scene/Camera.h"
 #include "Rendering/RenderingAPI.h"
 #include "Rendering/Renderer.h"
-#include "Rendering/MeshGenerator.h"
\ No newline at end of file
+#include "Rendering/MeshGenerator.h"
+#include "Rendering/ResourceLoader.h"
+#include "Rendering/SoftwareOcclusionCuller.h"
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <bitset>
+
 #include "Input/GamepadButtonCodes.h"
 
 #define FIREFLY_MAX_GAMEPADS    16
@@ -22,16 +24,10 @@
 
 namespace Firefly
 {
+    // plain state of one gamepad, trivially copyable so that input snapshots can be copied as a whole
     class Gamepad
     {
     public:
-        Gamepad(const std::string& name);
-        Gamepad(const Gamepad& gamepad);
-        ~Gamepad();
-
-        void SetName(const std::string& name);
-        std::string GetName() const;
-
         void SetIsButtonPressed(int buttonCode, bool isPressed);
         bool IsButtonPressed(int buttonCode) const;
 
@@ -47,13 +43,12 @@ namespace Firefly
         float GetTriggerRight() const;
 
     private:
-        std::string m_name;
-        std::unordered_map<int, bool> m_isButtonPressedMap;
-        float m_axisLeftX;
-        float m_axisLeftY;
-        float m_axisRightX;
-        float m_axisRightY;
-        float m_triggerLeft;
-        float m_triggerRight;
+        std::bitset<FIREFLY_GAMEPAD_BUTTON_COUNT> m_pressedButtons;
+        float m_axisLeftX = 0.f;
+        float m_axisLeftY = 0.f;
+        float m_axisRightX = 0.f;
+        float m_axisRightY = 0.f;
+        float m_triggerLeft = -1.f;
+        float m_triggerRight = -1.f;
     };
 }
\ No newline at end of file
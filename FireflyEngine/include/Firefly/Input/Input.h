@@ -1,18 +1,19 @@
 #pragma once
 
+#include <atomic>
+
 #include "Core/Core.h"
 #include "Event/KeyEvent.h"
 #include "Event/MouseEvent.h"
 #include "Event/GamepadEvent.h"
-#include "Input/KeyCodes.h"
-#include "Input/MouseButtonCodes.h"
-#include "Input/Gamepad.h"
+#include "Input/InputSnapshot.h"
 
 namespace Firefly
 {
     class  Input
     {
     public:
+        // the live state, changes with every dispatched event and is only meant for the main thread
         static bool IsKeyPressed(int keyCode);
 
         static bool IsMouseButtonPressed(int mouseButton);
@@ -29,22 +30,27 @@ namespace Firefly
         static float GetGamepadTriggerLeft(int gamepadNumber);
         static float GetGamepadTriggerRight(int gamepadNumber);
 
-        static void OnEvent(std::shared_ptr<Event> event);
+        // compare the last two snapshots
+        static bool WasKeyPressedThisFrame(int keyCode);
+        static bool WasKeyReleasedThisFrame(int keyCode);
+        static bool WasMouseButtonPressedThisFrame(int mouseButton);
+        static bool WasMouseButtonReleasedThisFrame(int mouseButton);
+        static bool WasGamepadButtonPressedThisFrame(int gamepadNumber, int gamepadButton);
+        static bool WasGamepadButtonReleasedThisFrame(int gamepadNumber, int gamepadButton);
+
+        // lock free, the returned snapshot is not written again before the next but one UpdateSnapshots call,
+        // so the worker threads of a frame can read it while the main thread already polls the next events
+        static const InputSnapshot& GetSnapshot();
+        static void UpdateSnapshots();
+
+        static void OnEvent(const Event& event);
 
     private:
-        static void OnKeyEvent(std::shared_ptr<KeyEvent> keyEvent);
-        static void OnMouseEvent(std::shared_ptr<MouseEvent> mouseEvent);
-        static void OnMouseMoveEvent(std::shared_ptr<MouseMoveEvent> mouseMoveEvent);
-        static void OnMouseButtonEvent(std::shared_ptr<MouseButtonEvent> mouseButtonEvent);
-        static void OnGamepadEvent(std::shared_ptr<GamepadEvent> gamepadEvent);
-        static void OnGamepadButtonEvent(std::shared_ptr<GamepadButtonEvent> gamepadButtonEvent);
-        static void OnGamepadAxisMoveEvent(std::shared_ptr<GamepadAxisMoveEvent> gamepadAxisModeEvent);
-        static void OnGamepadTriggerMoveEvent(std::shared_ptr<GamepadTriggerMoveEvent> gamepadTriggerModeEvent);
-
-        static std::unordered_map<int, bool> m_isKeyPressedMap;
-        static std::unordered_map<int, Gamepad> m_gamepadMap;
-        static std::unordered_map<int, bool> m_isMouseButtonPressedMap;
-        static int m_mousePositionX;
-        static int m_mousePositionY;
+        static Gamepad* FindGamepad(int gamepadNumber);
+
+        static InputState m_state;
+        static std::array<std::string, FIREFLY_MAX_GAMEPADS> m_gamepadNames;
+        static std::array<InputSnapshot, 3> m_snapshots;
+        static std::atomic<uint32_t> m_snapshotIndex;
     };
 }
\ No newline at end of file
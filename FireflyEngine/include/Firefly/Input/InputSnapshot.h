@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+
+#include "Input/KeyCodes.h"
+#include "Input/MouseButtonCodes.h"
+#include "Input/Gamepad.h"
+
+namespace Firefly
+{
+    // dense input state indexed by the key, button and gamepad codes, codes out of range are never pressed
+    struct InputState
+    {
+        std::bitset<FIREFLY_KEY_LAST + 1> pressedKeys;
+        std::bitset<FIREFLY_MOUSE_BUTTON_LAST + 1> pressedMouseButtons;
+        int mousePositionX = 0;
+        int mousePositionY = 0;
+        std::bitset<FIREFLY_MAX_GAMEPADS> connectedGamepads;
+        std::array<Gamepad, FIREFLY_MAX_GAMEPADS> gamepads;
+
+        bool IsKeyPressed(int keyCode) const;
+        bool IsMouseButtonPressed(int mouseButton) const;
+        bool IsGamepadConnected(int gamepadNumber) const;
+        const Gamepad* GetGamepad(int gamepadNumber) const;
+    };
+
+    // the input state after the events of a frame were dispatched together with the state of the frame before
+    struct InputSnapshot
+    {
+        InputState current;
+        InputState previous;
+
+        bool WasKeyPressedThisFrame(int keyCode) const;
+        bool WasKeyReleasedThisFrame(int keyCode) const;
+        bool WasMouseButtonPressedThisFrame(int mouseButton) const;
+        bool WasMouseButtonReleasedThisFrame(int mouseButton) const;
+        bool WasGamepadButtonPressedThisFrame(int gamepadNumber, int gamepadButton) const;
+        bool WasGamepadButtonReleasedThisFrame(int gamepadNumber, int gamepadButton) const;
+    };
+}
\ No newline at end of file
@@ -126,3 +126,5 @@
 #define FIREFLY_KEY_RIGHT_ALT          346
 #define FIREFLY_KEY_RIGHT_SUPER        347
 #define FIREFLY_KEY_MENU               348
+
+#define FIREFLY_KEY_LAST               FIREFLY_KEY_MENU
@@ -8,6 +8,7 @@
 #define FIREFLY_MOUSE_BUTTON_6         5
 #define FIREFLY_MOUSE_BUTTON_7         6
 #define FIREFLY_MOUSE_BUTTON_8         7
+#define FIREFLY_MOUSE_BUTTON_LAST      FIREFLY_MOUSE_BUTTON_8
 #define FIREFLY_MOUSE_BUTTON_LEFT      FIREFLY_MOUSE_BUTTON_1
 #define FIREFLY_MOUSE_BUTTON_RIGHT     FIREFLY_MOUSE_BUTTON_2
 #define FIREFLY_MOUSE_BUTTON_MIDDLE    FIREFLY_MOUSE_BUTTON_3
\ No newline at end of file
@@ -1,23 +1,56 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 
 namespace Firefly
 {
     class Window;
 
+    // when a frame passed the stages after its input, default time points are stages that were not measured
+    struct FrameTiming
+    {
+        std::chrono::steady_clock::time_point inputEventTime;
+        std::chrono::steady_clock::time_point presentTime;
+        std::chrono::steady_clock::time_point gpuCompletionTime;
+    };
+
     class GraphicsContext
     {
     public:
+        enum class PresentMode
+        {
+            Fifo,
+            FifoRelaxed,
+            Mailbox,
+            Immediate
+        };
+
         void Init(std::shared_ptr<Window> window);
         virtual void Destroy() = 0;
 
+        // the window size is cached, the render thread must not call into the window, which only works on the main thread
         uint32_t GetWidth() const;
         uint32_t GetHeight() const;
+        // called on the main thread when the window was resized
+        void SetSize(uint32_t width, uint32_t height);
+        std::shared_ptr<Window> GetWindow() const;
+
+        // the requested mode, backends fall back to a supported one
+        void SetPresentMode(PresentMode presentMode);
+        PresentMode GetPresentMode() const;
+
+        // block compressed texture formats, without them textures are uploaded uncompressed
+        virtual bool IsTextureCompressionSupported() const = 0;
 
     protected:
         virtual void OnInit(std::shared_ptr<Window> window) = 0;
+        virtual void OnSetPresentMode(PresentMode presentMode) = 0;
 
         std::shared_ptr<Window> m_window;
+        std::atomic<PresentMode> m_presentMode = PresentMode::FifoRelaxed;
+        // width in the upper and height in the lower half, so both are read together
+        std::atomic<uint64_t> m_size = 0;
     };
 }
\ No newline at end of file
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "Core/ResourceHandle.h"
 #include "Rendering/Shader.h"
 #include "Rendering/Texture.h"
 #include <glm/glm.hpp>
+#include <array>
+#include <atomic>
 
 namespace Firefly
 {
@@ -16,8 +19,13 @@ namespace Firefly
             Roughness,
             Metalness,
             Occlusion,
-            Height
+            Height,
+            // occlusion in red, roughness in green and metalness in blue, replaces the three single channel textures
+            OcclusionRoughnessMetalness
         };
+        static constexpr size_t s_textureUsageCount = static_cast<size_t>(TextureUsage::OcclusionRoughnessMetalness) + 1;
+        // backends reserve their per-material resources up front for this many materials
+        static constexpr size_t s_maxMaterialCount = 256;
 
         Material();
 
@@ -26,6 +34,11 @@ namespace Firefly
 
         std::shared_ptr<Shader> GetShader() const;
 
+        // bumped by every setter, renderers compare it to the version they uploaded last
+        uint32_t GetVersion() const;
+        // bumped by the setters of all materials, lets renderers skip checking the versions when nothing changed
+        static uint64_t GetGlobalVersion();
+
         void SetAlbedo(const glm::vec4& albedo);
         glm::vec4 GetAlbedo() const;
 
@@ -39,22 +52,32 @@ namespace Firefly
         float GetHeightScale() const;
 
         void SetTexture(std::shared_ptr<Texture> texture, TextureUsage usage);
-        std::shared_ptr<Texture> GetTexture(TextureUsage usage);
-        bool HasTexture(TextureUsage usage);
+        // the texture is resolved through the TextureRegistry, RefreshTexture picks up a resource that replaced it
+        void SetTexture(TextureHandle texture, TextureUsage usage);
+        void RefreshTexture(TextureHandle texture);
+        std::shared_ptr<Texture> GetTexture(TextureUsage usage) const;
+        bool HasTexture(TextureUsage usage) const;
         void EnableTexture(bool enable, TextureUsage usage);
-        bool IsTextureEnabled(TextureUsage usage);
+        bool IsTextureEnabled(TextureUsage usage) const;
         void ClearTextures();
 
     protected:
         virtual void OnInit() = 0;
         virtual void OnSetTexture(std::shared_ptr<Texture> texture, TextureUsage usage) = 0;
 
+        void MarkChanged();
+
         std::shared_ptr<Shader> m_shader;
         glm::vec4 m_albedo;
         float m_roughness;
         float m_metalness;
         float m_heightScale;
-        std::unordered_map<TextureUsage, std::shared_ptr<Texture>> m_textures;
-        std::unordered_map<TextureUsage, bool> m_useTextures;
+        std::array<std::shared_ptr<Texture>, s_textureUsageCount> m_textures;
+        std::array<TextureHandle, s_textureUsageCount> m_textureHandles;
+        std::array<bool, s_textureUsageCount> m_useTextures;
+        uint32_t m_version;
+
+        // setters run on the main thread while the render thread may compare it
+        static std::atomic<uint64_t> s_globalVersion;
     };
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Rendering/GraphicsContext.h"
+#include "Scene/BoundingBox.h"
 #include <glm/glm.hpp>
 
 namespace Firefly
@@ -17,17 +18,23 @@ namespace Firefly
             glm::vec2 texCoords;
         };
 
+        // imports the vertices and indices of a single mesh file, nothing touches the graphics api so it runs on any
+        // thread, logs and returns false when the file can not be imported
+        static bool ReadFile(const std::string& path, bool flipTexCoords, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
         void Init(std::vector<Vertex> vertices, std::vector<uint32_t> indices);
         void Init(const std::string& path, bool flipTexCoords = false);
         virtual void Destroy() = 0;
 
         uint32_t GetVertexCount() const;
         uint32_t GetIndexCount() const;
+        const BoundingBox& GetBoundingBox() const;
 
     protected:
         virtual void OnInit(std::vector<Vertex> vertices, std::vector<uint32_t> indices) = 0;
 
         uint32_t m_vertexCount = 0;
         uint32_t m_indexCount = 0;
+        BoundingBox m_boundingBox;
     };
 }
\ No newline at end of file
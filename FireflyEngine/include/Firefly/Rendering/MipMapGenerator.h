@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Rendering/Texture.h"
+
+namespace Firefly
+{
+    // filters mip chains of decoded images on the cpu, so loader threads build them in parallel and a texture
+    // is uploaded with all of its levels at once instead of blitting one level after another on the gpu
+    class MipMapGenerator
+    {
+    public:
+        // appends the lower levels to the pixels of the first level, every level holds all array layers,
+        // returns the level count of the pixels, which stays one for formats without a cpu filter
+        static uint32_t GenerateMipChain(const Texture::Description& description, std::vector<uint8_t>& pixels);
+        static bool IsFormatSupported(Texture::Format format);
+
+    private:
+        static bool IsNonLinearFormat(Texture::Format format);
+        // 8 bit images with one, two or four channels, the fourth is alpha and never srgb encoded
+        static void DownsampleUnorm(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight,
+            uint8_t* destination, uint32_t width, uint32_t height, uint32_t channelCount, bool isNonLinear);
+        static void DownsampleFloat(const float* source, uint32_t sourceWidth, uint32_t sourceHeight,
+            float* destination, uint32_t width, uint32_t height);
+    };
+}
\ No newline at end of file
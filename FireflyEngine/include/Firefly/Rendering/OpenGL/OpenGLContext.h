@@ -14,13 +14,18 @@ namespace Firefly
 
         void SwapBuffers();
 
+        virtual bool IsTextureCompressionSupported() const override;
+
     protected:
         virtual void OnInit(std::shared_ptr<Window> window) override;
+        virtual void OnSetPresentMode(PresentMode presentMode) override;
 
     private:
         void PrintGpuInfo();
+        bool IsExtensionSupported(const std::string& extension) const;
 
         GLFWwindow* m_glfwWindow;
+        bool m_isTextureCompressionSupported = false;
 
         static void GLAPIENTRY DebugMessengerCallback(
             GLenum source, GLenum type, GLuint id,
@@ -18,10 +18,11 @@ namespace Firefly
         virtual void Init() override;
         virtual void Destroy() override;
 
-        virtual void BeginDrawRecording() override;
-        virtual void RecordDraw(const Entity& entity) override;
-        virtual void EndDrawRecording() override;
-        virtual void SubmitDraw(std::shared_ptr<Camera> camera) override;
+    protected:
+        // the context is current on the main thread only
+        virtual bool IsRenderThreadSupported() const override;
+        virtual void DrawFrame(const FramePacket& framePacket) override;
+        virtual void WaitForSubmittedFrames() override;
 
     private:
         void CreateRenderPass();
@@ -34,7 +35,7 @@ namespace Firefly
 
 
         std::shared_ptr<OpenGLContext> m_openGLContext;
-        std::vector<Entity> m_entities;
+        std::vector<ObjectData> m_objectData;
         uint32_t m_windowWidth;
         uint32_t m_windowHeight;
 
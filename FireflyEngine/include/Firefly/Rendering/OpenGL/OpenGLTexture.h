@@ -26,10 +26,10 @@ namespace Firefly
         static size_t GetTextureByteSize(uint32_t width, uint32_t height, Type type, Format format);
 
     protected:
-        virtual void OnInit(void* pixelData) override;
+        virtual void OnInit(void* pixelData, uint32_t pixelDataMipLevels) override;
 
     private:
-        void CreateTexture(void* pixelData);
+        void CreateTexture(void* pixelData, uint32_t pixelDataMipLevels);
         void DestroyTexture();
         void CreateTextureView();
         void DestroyTextureView();
@@ -27,6 +27,9 @@ namespace Firefly
 
         struct Description
         {
+            // when disabled the attachments keep the content of a previous pass
+            bool isClearingEnabled = true;
+
             bool isMultisamplingEnabled = false;
             bool isSampleShadingEnabled = false;
             float minSampleShading = 1.0f;
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include "Core/ResourceHandle.h"
+#include "Scene/BoundingBox.h"
+
+namespace Firefly
+{
+    class Scene;
+
+    // everything a renderer needs to draw an entity, copied from its components when they change
+    struct RenderProxy
+    {
+        entt::entity entity = entt::null;
+        MeshHandle mesh;
+        MaterialHandle material;
+        uint32_t materialIndex = 0;
+        glm::mat4 modelMatrix = glm::mat4(1.0f);
+        glm::mat4 normalMatrix = glm::mat4(1.0f);
+        // world matrix after the previous fixed step, frames between two steps are interpolated from it to modelMatrix
+        glm::mat4 previousModelMatrix = glm::mat4(1.0f);
+        BoundingBox worldBox;
+    };
+
+    // packed render proxies of all entities with a TransformComponent, a MeshComponent and a MaterialComponent
+    // the registry signals queue the entities that were added, removed or patched, only those are touched by Update
+    class RenderProxyCache
+    {
+    public:
+        static constexpr uint32_t s_invalidIndex = std::numeric_limits<uint32_t>::max();
+
+        RenderProxyCache(std::shared_ptr<Scene> scene);
+        ~RenderProxyCache();
+
+        void Update();
+        // the changes are collected over all updates until the renderer packed them
+        void ClearChanges();
+        // called before every fixed simulation step, proxies that moved in the step before come to rest at their
+        // current matrix, the proxies that move in the new step are interpolated from there
+        void BeginFixedStep();
+
+        uint32_t GetProxyIndex(entt::entity entity) const;
+        const std::vector<RenderProxy>& GetProxies() const;
+        // proxy indices written since the last ClearChanges, removing a proxy moves the last one into its slot
+        const std::vector<uint32_t>& GetChangedProxyIndices() const;
+        // entities whose proxy moved in the last fixed step, empty as long as the simulation runs no fixed steps
+        const std::unordered_set<entt::entity>& GetMovingEntities() const;
+
+        // deduplicated materials of all proxies, slots of materials that are no longer used hold invalid handles until reused
+        const std::vector<MaterialHandle>& GetMaterials() const;
+        const std::vector<uint32_t>& GetChangedMaterialIndices() const;
+
+    private:
+        void OnEntityChanged(entt::registry& registry, entt::entity entity);
+
+        void WriteProxy(uint32_t proxyIndex, entt::entity entity);
+        void RemoveProxy(uint32_t proxyIndex);
+        void MarkProxyChanged(uint32_t proxyIndex);
+
+        uint32_t AcquireMaterialIndex(MaterialHandle material);
+        void ReleaseMaterialIndex(uint32_t materialIndex);
+
+        std::shared_ptr<entt::registry> m_entityRegistry;
+
+        std::vector<RenderProxy> m_proxies;
+        std::unordered_map<entt::entity, uint32_t> m_proxyIndices;
+        std::vector<uint32_t> m_changedProxyIndices;
+        std::vector<uint8_t> m_proxyChangedFlags;
+
+        std::vector<MaterialHandle> m_materials;
+        std::vector<uint32_t> m_materialReferenceCounts;
+        // indexed by the registry slot of a material, only valid when m_materials holds the same handle at that index
+        std::vector<uint32_t> m_materialIndices;
+        std::vector<uint32_t> m_freeMaterialIndices;
+        std::vector<uint32_t> m_changedMaterialIndices;
+
+        std::vector<entt::entity> m_pendingEntities;
+        std::unordered_set<entt::entity> m_pendingEntitySet;
+
+        std::unordered_set<entt::entity> m_movingEntities;
+        bool m_isInterpolationEnabled = false;
+    };
+}
\ No newline at end of file
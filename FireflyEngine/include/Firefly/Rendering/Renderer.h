@@ -4,6 +4,14 @@
 #include "Rendering/GraphicsContext.h"
 #include "Rendering/Shader.h"
 #include "Scene/Camera.h"
+#include "Rendering/RenderProxyCache.h"
+#include "Core/LatencyRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace Firefly
 {
@@ -27,6 +35,7 @@ namespace Firefly
         float hasMetalnessTexture;
         float hasOcclusionTexture;
         float hasHeightTexture;
+        float hasOcclusionRoughnessMetalnessTexture;
     };
 
     struct ObjectData
@@ -35,15 +44,102 @@ namespace Firefly
         glm::mat4 normalMatrix;
     };
 
+    // one draw of a frame packet, meshes and materials are owned by their resource registries and outlive the frame
+    struct FrameDraw
+    {
+        Mesh* mesh;
+        Material* material;
+        uint32_t materialIndex;
+        uint32_t objectIndex;
+        BoundingBox worldBox;
+    };
+
+    // everything needed to draw a frame, copied out of the scene so the next frame can be simulated while it is drawn
+    struct FramePacket
+    {
+        SceneData sceneData;
+        std::vector<FrameDraw> draws;
+        // object and material data that changed since the previous packet, indexed like the proxies and their materials
+        std::vector<std::pair<uint32_t, ObjectData>> objectDataDeltas;
+        std::vector<std::pair<uint32_t, MaterialData>> materialDataDeltas;
+        std::chrono::steady_clock::time_point inputTime;
+        // the newest input event the packet was built after, default when the frame had no new input
+        std::chrono::steady_clock::time_point inputEventTime;
+    };
+
     class Renderer
     {
     public:
+        virtual ~Renderer() = default;
+
         virtual void Init() = 0;
         virtual void Destroy() = 0;
 
-        virtual void BeginDrawRecording() = 0;
-        virtual void RecordDraw(const Entity& entity) = 0;
-        virtual void EndDrawRecording() = 0;
-        virtual void SubmitDraw(std::shared_ptr<Camera> camera) = 0;
+        // the render proxies of the scene are kept between frames, RecordDraw only selects which of them are drawn
+        void SetScene(std::shared_ptr<Scene> scene);
+
+        // with a render thread SubmitDraw hands the packet over and returns, it is drawn while the next one is recorded
+        void SetRenderThreadEnabled(bool enabled);
+        bool IsRenderThreadEnabled() const;
+
+        // with fixed simulation steps BeginFixedStep is called before every step, the alpha of BeginDrawRecording is the
+        // fraction of a step that is not simulated yet, moving entities are drawn between their last two steps by it
+        void BeginFixedStep();
+        void BeginDrawRecording(float interpolationAlpha = 1.0f);
+        void RecordDraw(const Entity& entity);
+        void EndDrawRecording();
+        void SubmitDraw(std::shared_ptr<Camera> camera);
+
+        // in low latency mode WaitForFrameSlot blocks until the gpu finished every submitted frame, called right before the
+        // window events are polled the next frame is built from the newest input instead of queueing behind older frames
+        void SetLowLatencyEnabled(bool enabled);
+        bool IsLowLatencyEnabled() const;
+        void WaitForFrameSlot();
+
+        // smoothed time in seconds from polling the window events of a frame until its image is queued for presentation
+        float GetInputToPresentLatency() const;
+
+        // distributions over the recent frames that followed new input, measured from the newest input event of the frame
+        // until its image was queued for presentation and until the gpu finished it, the completion is the first time the
+        // cpu saw the frame finished, so it is an upper bound, sampleCount tells how many frames were measured
+        LatencyPercentiles GetInputToPresentPercentiles() const;
+        LatencyPercentiles GetInputToGpuCompletionPercentiles() const;
+        void ResetLatencyPercentiles();
+
+    protected:
+        virtual bool IsRenderThreadSupported() const = 0;
+        virtual void DrawFrame(const FramePacket& framePacket) = 0;
+        virtual void WaitForSubmittedFrames() = 0;
+
+        // backends call it when the image of the packet was handed to the presentation engine
+        void RecordPresent(const FramePacket& framePacket);
+        void RecordFrameTiming(const FrameTiming& frameTiming);
+
+        // waits for the packet in flight, backends call it before destroying the resources the render thread uses
+        void StopRenderThread();
+
+    private:
+        void RunRenderThread();
+        void WriteMaterialData(uint32_t materialIndex, const Material& material);
+        static ObjectData InterpolateObjectData(const RenderProxy& proxy, float interpolationAlpha);
+
+        std::unique_ptr<RenderProxyCache> m_renderProxies;
+        // material versions packed into each material slot
+        std::vector<uint32_t> m_materialDataVersions;
+        uint64_t m_materialGlobalVersion = 0;
+
+        // the main thread records into one packet while the render thread draws the other one
+        FramePacket m_framePackets[2];
+        uint32_t m_recordingPacketIndex = 0;
+        bool m_isPacketPending = false;
+        bool m_isRenderThreadStopRequested = false;
+        std::thread m_renderThread;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        bool m_isLowLatencyEnabled = false;
+        std::atomic<float> m_inputToPresentLatency = 0.0f;
+        LatencyRecorder m_inputToPresentLatencies;
+        LatencyRecorder m_inputToGpuCompletionLatencies;
     };
 }
\ No newline at end of file
@@ -39,7 +39,7 @@ namespace Firefly
         static std::shared_ptr<Mesh> CreateMesh(std::vector<Mesh::Vertex> vertices, std::vector<uint32_t> indices);
         static std::shared_ptr<Mesh> CreateMesh(const std::string& path, bool flipTexCoords = false);
         static std::shared_ptr<Texture> CreateTexture(const std::string& path, bool useLinearColorSpace = true);
-        static std::shared_ptr<Texture> CreateTexture(const Texture::Description& description);
+        static std::shared_ptr<Texture> CreateTexture(const Texture::Description& description, void* pixelData = nullptr, uint32_t pixelDataMipLevels = 1);
         static std::shared_ptr<Material> CreateMaterial(std::shared_ptr<Shader> shader);
         static std::shared_ptr<FrameBuffer> CreateFrameBuffer(const FrameBuffer::Description& description);
         static std::shared_ptr<RenderPass> CreateRenderPass(const RenderPass::Description& description);
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Core/ResourceHandle.h"
+#include "Core/ThreadPool.h"
+#include "Rendering/Material.h"
+#include "Rendering/Mesh.h"
+#include "Rendering/Texture.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace Firefly
+{
+    // loads meshes and textures without blocking the caller, files are decoded on a thread pool of the loader and
+    // their handles resolve to shared placeholders until the renderer uploaded the decoded data
+    class ResourceLoader
+    {
+    public:
+        struct TextureRequest
+        {
+            std::string path;
+            bool useLinearColorSpace = true;
+            // NONE keeps the decoded format, see TextureCompressor::SelectFormat
+            Texture::Format compressedFormat = Texture::Format::NONE;
+            // 1, 2 or 4 channels of the file are kept, see Texture::ReadImage
+            uint32_t channelCount = 4;
+        };
+
+        static ResourceLoader& Instance();
+
+        // creates the placeholders, needs an initialized rendering api
+        void Init();
+        // waits for running decodes and releases the placeholders, before the registries destroy their resources
+        void Destroy();
+
+        // the path is the registry name, a path that is already loaded or loading returns its handle again
+        // both can be called from any thread
+        MeshHandle LoadMeshAsync(const std::string& path, bool flipTexCoords = false);
+        TextureHandle LoadTextureAsync(const std::string& path, bool useLinearColorSpace = true, Texture::Format compressedFormat = Texture::Format::NONE, uint32_t channelCount = 4);
+        // picks the color space, the channel count and, if enabled, the compressed format that fit the usage in a material,
+        // roughness, metalness, occlusion and height maps keep a single channel and normal maps two
+        TextureHandle LoadTextureAsync(const std::string& path, Material::TextureUsage usage);
+        // packs three single channel maps into one texture for Material::TextureUsage::OcclusionRoughnessMetalness,
+        // the images need the same size, an empty path fills its channel with full occlusion, full roughness or no metalness
+        TextureHandle LoadOcclusionRoughnessMetalnessAsync(const std::string& occlusionPath, const std::string& roughnessPath, const std::string& metalnessPath);
+        // decodes all files at once on the shared thread pool and uploads them before returning, for startup and
+        // loading screens where the caller waits anyway, call it on the thread that draws, e.g. before a render thread runs
+        std::vector<TextureHandle> LoadTextures(const std::vector<TextureRequest>& requests);
+
+        // decoding threads also filter the mip chains, so textures are uploaded complete instead of blitting their levels
+        void SetCpuMipMappingEnabled(bool enabled);
+        bool IsCpuMipMappingEnabled() const;
+        // textures loaded by their usage are block compressed while decoding, stays off when the gpu lacks the formats
+        void SetTextureCompressionEnabled(bool enabled);
+        bool IsTextureCompressionEnabled() const;
+
+        // creates the graphics resources of a few decoded files, called by the renderer on the thread that draws,
+        // which is the only one submitting to the graphics queue while a render thread runs
+        void UploadDecodedResources();
+        // swaps uploaded resources into their registry slots and points the materials at loaded textures,
+        // called once per frame on the main thread
+        void Update();
+
+        // meshes that replaced their placeholder in the last Update, caches of their bounds are outdated
+        const std::vector<MeshHandle>& GetReplacedMeshes() const;
+        // files that are still decoding or waiting for their upload
+        uint32_t GetPendingCount() const;
+
+    private:
+        struct DecodedMesh
+        {
+            MeshHandle handle;
+            std::vector<Mesh::Vertex> vertices;
+            std::vector<uint32_t> indices;
+        };
+
+        struct DecodedTexture
+        {
+            TextureHandle handle;
+            Texture::Description description;
+            std::vector<uint8_t> pixels;
+            uint32_t mipMapLevels = 1;
+        };
+
+        ResourceLoader() = default;
+
+        // inserts the placeholder under the name and runs the decode on the loader threads
+        TextureHandle SubmitTextureDecode(const std::string& name, std::shared_ptr<Texture> placeholder, std::function<bool(DecodedTexture&)> decode);
+        bool DecodeTexture(const std::string& path, bool useLinearColorSpace, Texture::Format compressedFormat, uint32_t channelCount, DecodedTexture& decodedTexture) const;
+        bool DecodeOcclusionRoughnessMetalness(const std::array<std::string, 3>& paths, Texture::Format compressedFormat, DecodedTexture& decodedTexture) const;
+        // builds the mip chain and compresses the pixels of a decoded image
+        void PrepareDecodedTexture(const std::string& name, Texture::Format compressedFormat, DecodedTexture& decodedTexture) const;
+
+        void RemovePending(MeshHandle handle);
+        void RemovePending(TextureHandle handle);
+
+        // uploads are spread over frames, so a burst of finished decodes does not stall a single frame
+        static constexpr uint32_t s_maxUploadsPerFrame = 4;
+
+        std::unique_ptr<ThreadPool> m_decodeThreadPool;
+        std::shared_ptr<Mesh> m_placeholderMesh;
+        std::shared_ptr<Texture> m_linearPlaceholderTexture;
+        std::shared_ptr<Texture> m_nonLinearPlaceholderTexture;
+        std::shared_ptr<Texture> m_occlusionRoughnessMetalnessPlaceholderTexture;
+
+        std::mutex m_mutex;
+        std::vector<DecodedMesh> m_decodedMeshes;
+        std::vector<DecodedTexture> m_decodedTextures;
+        std::vector<std::pair<MeshHandle, std::shared_ptr<Mesh>>> m_uploadedMeshes;
+        std::vector<std::pair<TextureHandle, std::shared_ptr<Texture>>> m_uploadedTextures;
+        // handles that still resolve to a placeholder, including the ones whose file failed to load
+        std::vector<MeshHandle> m_pendingMeshes;
+        std::vector<TextureHandle> m_pendingTextures;
+
+        std::vector<MeshHandle> m_replacedMeshes;
+        std::atomic<uint32_t> m_pendingCount = 0;
+        std::atomic<bool> m_isDestroyRequested = false;
+        std::atomic<bool> m_isCpuMipMappingEnabled = true;
+        std::atomic<bool> m_isTextureCompressionEnabled = true;
+        bool m_isTextureCompressionSupported = true;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include "Scene/BoundingBox.h"
+#include "Scene/SceneSpatialIndex.h"
+
+namespace Firefly
+{
+    // low poly stand-in geometry that has to lie completely inside the mesh it represents
+    struct OccluderMesh
+    {
+        std::vector<glm::vec3> m_positions;
+        std::vector<uint32_t> m_indices;
+
+        static std::shared_ptr<OccluderMesh> CreateBox(const BoundingBox& box);
+    };
+
+    // masked software occlusion culling: occluders are rasterized into a coarse depth buffer of 8x4 pixel tiles,
+    // each tile only stores two max depth layers and a coverage mask that tells which pixels belong to which layer
+    class SoftwareOcclusionCuller
+    {
+    public:
+        SoftwareOcclusionCuller(uint32_t width = 320, uint32_t height = 192);
+
+        void SetResolution(uint32_t width, uint32_t height);
+
+        void BeginFrame(const glm::mat4& viewProjection);
+        void AddOccluder(std::shared_ptr<OccluderMesh> occluderMesh, const glm::mat4& transform);
+        void RasterizeOccluders();
+
+        bool IsVisible(const BoundingBox& box) const;
+        void FilterVisible(std::vector<entt::entity>& entities, const SceneSpatialIndex& spatialIndex);
+
+        void GetDepthBuffer(std::vector<float>& depthBuffer) const;
+        uint32_t GetWidth() const;
+        uint32_t GetHeight() const;
+
+    private:
+        static constexpr uint32_t s_tileWidth = 8;
+        static constexpr uint32_t s_tileHeight = 4;
+
+        struct Tile
+        {
+            float zMax0;
+            float zMax1;
+            uint32_t mask;
+        };
+
+        struct Occluder
+        {
+            std::shared_ptr<OccluderMesh> mesh;
+            glm::mat4 transform;
+        };
+
+        struct Triangle
+        {
+            glm::vec3 edgeA;
+            glm::vec3 edgeB;
+            glm::vec3 edgeC;
+            glm::vec3 depthPlane;
+            float zMax;
+            int32_t minTileX;
+            int32_t maxTileX;
+            int32_t minTileY;
+            int32_t maxTileY;
+        };
+
+        void TransformOccluder(size_t occluderIndex);
+        void SetupTriangles(size_t occluderIndex);
+        void RasterizeTriangle(const Triangle& triangle, int32_t minTileY, int32_t maxTileY);
+        void UpdateTile(Tile& tile, uint32_t coverage, float zTriangle);
+
+        uint32_t m_width;
+        uint32_t m_height;
+        uint32_t m_tileCountX;
+        uint32_t m_tileCountY;
+        std::vector<Tile> m_tiles;
+
+        glm::mat4 m_viewProjection;
+        std::vector<Occluder> m_occluders;
+        std::vector<size_t> m_vertexOffsets;
+        std::vector<size_t> m_triangleOffsets;
+        std::vector<glm::vec4> m_screenVertices;
+        std::vector<Triangle> m_triangles;
+        std::vector<uint8_t> m_visibility;
+    };
+}
\ No newline at end of file
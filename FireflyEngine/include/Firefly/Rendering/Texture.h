@@ -37,6 +37,17 @@ namespace Firefly
             RGBA_16_FLOAT,
             RGBA_32_FLOAT,
 
+            // block compressed, 4x4 texels per block
+            BC1_RGBA,
+            BC1_RGBA_NON_LINEAR,
+            BC3_RGBA,
+            BC3_RGBA_NON_LINEAR,
+            BC4_R,
+            BC5_RG,
+            BC6H_RGB_FLOAT,
+            BC7_RGBA,
+            BC7_RGBA_NON_LINEAR,
+
             DEPTH_32_FLOAT,
             DEPTH_24_STENCIL_8
         };
@@ -90,8 +101,19 @@ namespace Firefly
             SamplerDescription sampler = {};
         };
 
+        // decodes an image file into pixels and the description Init(path) uses, nothing touches the graphics api
+        // so it runs on any thread, logs and returns false when the file can not be read
+        // channelCount keeps the first 1, 2 or 4 channels as an R, RG or RGBA format, zero takes the count of the file,
+        // three channels are widened to four and hdr images are always rgba
+        static bool ReadImage(const std::string& path, bool useLinearColorSpace, Description& description, std::vector<uint8_t>& pixels, uint32_t channelCount = 4);
+
         void Init(const std::string& path, bool useLinearColorSpace = true);
         void Init(const Description& description);
+        // the pixels of the first mip level of all array layers, nullptr leaves the texture uninitialized
+        void Init(const Description& description, void* pixelData);
+        // pixelData holds pixelDataMipLevels levels one after another, each with all array layers, a complete chain
+        // is uploaded as it is and a single level gets its lower levels generated by the gpu
+        void Init(const Description& description, void* pixelData, uint32_t pixelDataMipLevels);
         virtual void Destroy() = 0;
 
         uint32_t GetWidth();
@@ -106,12 +128,20 @@ namespace Firefly
         bool HasDepthFormat() const;
         bool HasDepthStencilFormat() const;
 
+        static uint32_t GetMipMapLevelCount(const Description& description);
+        static uint32_t GetArrayLayerCount(const Description& description);
+        // zero for block compressed formats, their sizes come from GetImageByteSize
+        static uint32_t GetBytePerPixel(Format format);
+        static bool IsCompressedFormat(Format format);
+        static uint32_t GetBlockByteSize(Format format);
+        // byte size of one array layer of one mip level
+        static size_t GetImageByteSize(Format format, uint32_t width, uint32_t height);
+
     protected:
-        virtual void OnInit(void* pixelData) = 0;
+        virtual void OnInit(void* pixelData, uint32_t pixelDataMipLevels) = 0;
         void CalcMipMapLevels();
         void CalcArrayLayers();
         static uint32_t ConvertToSampleCountNumber(SampleCount sampleCount);
-        static uint32_t GetBytePerPixel(Format format);
 
         Description m_description;
         uint32_t m_mipMapLevels;
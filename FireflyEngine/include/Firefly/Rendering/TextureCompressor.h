@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Rendering/Material.h"
+#include "Rendering/Texture.h"
+
+namespace Firefly
+{
+    // encodes decoded 8 bit mip chains into block compressed formats while textures are imported, it runs on the
+    // loader threads so the graphics api only receives the 4 to 8 times smaller blocks
+    class TextureCompressor
+    {
+    public:
+        // bc7 for colors and packed material data, bc5 for normals and bc4 for single channel data, NONE keeps the format uncompressed
+        static Texture::Format SelectFormat(Material::TextureUsage usage, Texture::Format format);
+        // the formats with an encoder, bc6h can be sampled but hdr images stay uncompressed
+        static bool IsFormatSupported(Texture::Format format);
+
+        // replaces the pixels of all mip levels and array layers with their blocks and sets the format of the description,
+        // compressed levels can not be generated by the gpu, so the pixels need the complete mip chain
+        // returns false and keeps the pixels when the image can not be encoded into the format
+        static bool Compress(Texture::Description& description, std::vector<uint8_t>& pixels, uint32_t mipMapLevels, Texture::Format format);
+
+    private:
+        // linear R, RG and RGBA as well as srgb RGBA pixels
+        static bool IsSourceFormatSupported(Texture::Format format);
+        // texels are the 16 rgba pixels of a 4x4 block, row after row
+        static void EncodeBC1Block(const uint8_t* texels, uint8_t* block);
+        static void EncodeBC4Block(const uint8_t* texels, uint32_t channel, uint8_t* block);
+        static void EncodeBC7Block(const uint8_t* texels, uint8_t* block);
+    };
+}
\ No newline at end of file
@@ -14,11 +14,19 @@ namespace Firefly
         virtual void Destroy() override;
 
         bool BeginScreenFrame();
-        bool EndScreenFrame();
+        // the input event time is kept with the frame until its command buffer is reused
+        bool EndScreenFrame(std::chrono::steady_clock::time_point inputEventTime);
 
         void BeginOffscreenFrame();
         void EndOffscreenFrame();
 
+        // blocks until the gpu finished all submitted screen frames
+        void WaitForSubmittedScreenFrames();
+
+        // timing of the frame that used the current image before, complete once BeginScreenFrame returned true, the gpu
+        // completion time is when the cpu first saw the fence of the frame signaled, an upper bound of the gpu finishing
+        FrameTiming GetCompletedScreenFrameTiming() const;
+
         vk::CommandBuffer GetCurrentCommandBuffer();
         uint32_t GetCurrentImageIndex() const;
 
@@ -28,8 +36,11 @@ namespace Firefly
         vk::CommandPool GetCommandPool() const;
         vk::DescriptorPool GetDescriptorPool() const;
 
+        virtual bool IsTextureCompressionSupported() const override;
+
     protected:
         virtual void OnInit(std::shared_ptr<Window> window) override;
+        virtual void OnSetPresentMode(PresentMode presentMode) override;
 
     private:
         void CreateInstance();
@@ -61,6 +72,8 @@ namespace Firefly
         void DestroySynchronizationPrimitives();
 
         void PrintGpuInfo();
+        // polls the fences of the presented frames, so frames the gpu finished early get a close completion time as well
+        void ObserveCompletedScreenFrames();
 
         std::vector<const char*> GetRequiredInstanceExtensions() const;
         std::vector<const char*> GetRequiredInstanceLayers() const;
@@ -87,6 +100,12 @@ namespace Firefly
         std::vector<vk::Fence> m_isScreenCommandBufferAvailableFences;
         vk::Fence m_isOffscreenCommandBufferAvailableFence;
 
+        std::vector<FrameTiming> m_screenFrameTimings;
+        FrameTiming m_completedScreenFrameTiming;
+
+        // set from the main thread, the swapchain is recreated by the thread drawing the next frame
+        std::atomic<bool> m_isSwapchainRecreationRequested = false;
+
         static VKAPI_ATTR VkBool32 VKAPI_CALL DebugMessengerCallback(
             VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity,
             VkDebugUtilsMessageTypeFlagsEXT messageType,
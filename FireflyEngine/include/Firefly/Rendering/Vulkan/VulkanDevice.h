@@ -19,6 +19,7 @@ namespace Firefly
         vk::Queue GetPresentQueue() const;
         uint32_t GetGraphicsQueueFamilyIndex() const;
         uint32_t GetPresentQueueFamilyIndex() const;
+        bool IsTextureCompressionBCEnabled() const;
 
         void WaitIdle();
 
@@ -32,5 +33,6 @@ namespace Firefly
         uint32_t m_graphicsQueueIndex = 0;
         uint32_t m_presentQueueFamilyIndex = 0;
         uint32_t m_presentQueueIndex = 0;
+        bool m_isTextureCompressionBCEnabled = false;
     };
 }
\ No newline at end of file
@@ -3,6 +3,9 @@
 #include "Rendering/Material.h"
 #include <vulkan/vulkan.hpp>
 
+#include <atomic>
+#include <mutex>
+
 namespace Firefly
 {
     class VulkanMaterial : public Material
@@ -12,7 +15,9 @@ namespace Firefly
 
         virtual void Destroy() override;
 
-        vk::DescriptorSet GetTexturesDescriptorSet() const;
+        // called by the thread that draws after the fence of the image was waited for, texture changes of the main
+        // thread are written to the set of the image first, so no set is written while a frame still uses it
+        vk::DescriptorSet GetTexturesDescriptorSet(uint32_t imageIndex);
 
     protected:
         virtual void OnInit() override;
@@ -23,6 +28,11 @@ namespace Firefly
         vk::DescriptorPool m_descriptorPool;
 
         vk::DescriptorSetLayout m_materialTexturesDescriptorSetLayout;
-        vk::DescriptorSet m_materialTexturesDescriptorSet;
+        std::vector<vk::DescriptorSet> m_materialTexturesDescriptorSets;
+        std::vector<uint64_t> m_descriptorSetTextureVersions;
+
+        std::mutex m_textureMutex;
+        std::array<vk::DescriptorImageInfo, s_textureUsageCount> m_textureImageInfos;
+        std::atomic<uint64_t> m_textureVersion = 0;
     };
 }
\ No newline at end of file
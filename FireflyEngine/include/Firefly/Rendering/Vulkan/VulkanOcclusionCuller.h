@@ -0,0 +1,132 @@
+#pragma once
+
+#include "Rendering/Shader.h"
+#include "Rendering/Vulkan/VulkanContext.h"
+#include "Rendering/Vulkan/VulkanTexture.h"
+#include "Scene/BoundingBox.h"
+
+namespace Firefly
+{
+    // two phase hierarchical-z occlusion culling on the gpu: the first phase tests the objects against the depth pyramid
+    // of the previous frame, the second phase re-tests the rejected objects against the pyramid built from the depth of
+    // the objects drawn in the first phase, both phases compact the visible objects of every batch into indexed indirect
+    // draw commands with a draw count per batch
+    class VulkanOcclusionCuller
+    {
+    public:
+        enum class Phase
+        {
+            FIRST,
+            SECOND
+        };
+
+        // matches the std430 layout of the objects buffer in occlusionCull.comp, the objects of a batch share mesh and
+        // material and are stored consecutively starting at batchFirstCommand
+        struct CullObject
+        {
+            glm::vec4 boundsMin;
+            glm::vec4 boundsMax;
+            uint32_t indexCount;
+            uint32_t objectIndex;
+            uint32_t batchIndex;
+            uint32_t batchFirstCommand;
+        };
+
+        void Init(uint32_t maxObjectCount);
+        void Destroy();
+
+        // the pyramid has the resolution of the depth texture and has to be rebuilt with it
+        void SetDepthTexture(std::shared_ptr<VulkanTexture> depthTexture, Texture::SampleCount sampleCount);
+
+        void UpdateObjects(const std::vector<CullObject>& objects);
+
+        // record into the current command buffer, the pyramid has to be built between the two draw phases
+        void CullFirstPhase();
+        void BuildDepthPyramid(const glm::mat4& viewProjection);
+        void CullSecondPhase();
+
+        vk::Buffer GetDrawCommandBuffer() const;
+        vk::DeviceSize GetDrawCommandOffset(size_t commandIndex, Phase phase) const;
+        uint32_t GetDrawCommandStride() const;
+        vk::Buffer GetDrawCountBuffer() const;
+        vk::DeviceSize GetDrawCountOffset(size_t batchIndex, Phase phase) const;
+
+    private:
+        struct ReducePushConstants
+        {
+            glm::ivec2 inputSize;
+            glm::ivec2 outputSize;
+            int32_t sampleCount;
+        };
+
+        struct CullPushConstants
+        {
+            glm::mat4 viewProjection;
+            glm::uvec2 depthSize;
+            uint32_t objectCount;
+            uint32_t pyramidLevelCount;
+            uint32_t phase;
+            uint32_t isPyramidValid;
+        };
+
+        void CreateBuffers();
+        void DestroyBuffers();
+        void CreateDescriptorSetLayouts();
+        void DestroyDescriptorSetLayouts();
+        void AllocateDescriptorSets();
+        void CreatePipelines();
+        void DestroyPipelines();
+        void CreateDepthPyramid();
+        void DestroyDepthPyramid();
+        void UpdateDescriptorSets();
+
+        void Cull(Phase phase);
+        void InsertDrawCommandBarrier(vk::CommandBuffer commandBuffer);
+
+        static constexpr uint32_t s_maxPyramidLevelCount = 16;
+
+        std::shared_ptr<VulkanContext> m_vkContext;
+        std::shared_ptr<VulkanDevice> m_device;
+        uint32_t m_imageCount = 0;
+        uint32_t m_maxObjectCount = 0;
+        uint32_t m_objectCount = 0;
+
+        std::vector<vk::Buffer> m_objectBuffers;
+        std::vector<vk::DeviceMemory> m_objectBufferMemories;
+        std::vector<vk::Buffer> m_drawCommandBuffers;
+        std::vector<vk::DeviceMemory> m_drawCommandBufferMemories;
+        std::vector<vk::Buffer> m_drawCountBuffers;
+        std::vector<vk::DeviceMemory> m_drawCountBufferMemories;
+        std::vector<vk::Buffer> m_visibilityBuffers;
+        std::vector<vk::DeviceMemory> m_visibilityBufferMemories;
+
+        std::shared_ptr<VulkanTexture> m_depthTexture;
+        Texture::SampleCount m_depthSampleCount = Texture::SampleCount::SAMPLE_1;
+        uint32_t m_pyramidWidth = 0;
+        uint32_t m_pyramidHeight = 0;
+        uint32_t m_pyramidLevelCount = 0;
+        vk::Image m_pyramidImage;
+        vk::DeviceMemory m_pyramidImageMemory;
+        vk::ImageView m_pyramidImageView;
+        std::vector<vk::ImageView> m_pyramidLevelImageViews;
+        vk::Sampler m_pyramidSampler;
+        glm::mat4 m_pyramidViewProjection = glm::mat4(1.0f);
+        bool m_isPyramidValid = false;
+        bool m_isPyramidLayoutInitialized = false;
+
+        std::shared_ptr<Shader> m_depthCopyShader;
+        std::shared_ptr<Shader> m_depthReduceShader;
+        std::shared_ptr<Shader> m_cullShader;
+
+        vk::DescriptorSetLayout m_reduceDescriptorSetLayout;
+        std::vector<vk::DescriptorSet> m_reduceDescriptorSets;
+        vk::PipelineLayout m_reducePipelineLayout;
+        vk::Pipeline m_depthCopyPipeline;
+        vk::Pipeline m_depthReducePipeline;
+
+        vk::DescriptorSetLayout m_cullDescriptorSetLayout;
+        std::vector<vk::DescriptorSet> m_cullDescriptorSets;
+        vk::PipelineLayout m_cullPipelineLayout;
+        vk::Pipeline m_cullPipeline;
+    };
+}
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Rendering/Material.h"
 #include "Rendering/Vulkan/VulkanTexture.h"
 #include "Rendering/Vulkan/VulkanMesh.h"
+#include "Rendering/Vulkan/VulkanOcclusionCuller.h"
+#include "Rendering/Vulkan/VulkanSceneBuffer.h"
 #include <unordered_map>
 
 namespace Firefly
@@ -19,13 +21,24 @@ namespace Firefly
         virtual void Init() override;
         virtual void Destroy() override;
 
-        virtual void BeginDrawRecording() override;
-        virtual void RecordDraw(const Entity& entity) override;
-        virtual void EndDrawRecording() override;
-        virtual void SubmitDraw(std::shared_ptr<Camera> camera) override;
+    protected:
+        virtual bool IsRenderThreadSupported() const override;
+        virtual void DrawFrame(const FramePacket& framePacket) override;
+        virtual void WaitForSubmittedFrames() override;
 
     private:
-        void UpdateUniformBuffers(std::shared_ptr<Camera> camera);
+        // consecutive culled draws sharing pipeline, material and mesh, drawn by one count based indirect draw
+        struct DrawBatch
+        {
+            uint32_t firstDraw;
+            uint32_t firstCommand;
+            uint32_t drawCount;
+        };
+
+        void UpdateUniformBuffers(const FramePacket& framePacket);
+        void BatchDraws(const FramePacket& framePacket);
+        static bool IsSameBatch(const FrameDraw& left, const FrameDraw& right);
+        void RecordEntityDraws(const FramePacket& framePacket, VulkanOcclusionCuller::Phase phase);
 
         void RecreateResources();
 
@@ -42,12 +55,12 @@ namespace Firefly
         void AllocateDescriptorSets();
 
         void CreateSceneDataUniformBuffers();
-        void CreateMaterialDataUniformBuffers();
-        void CreateObjectDataUniformBuffers();
+        void CreateMaterialDataBuffer();
+        void CreateObjectDataBuffer();
 
         void AllocateSceneDataDescriptorSets();
-        void AllocateMaterialDataDescriptorSets();
-        void AllocateObjectDataDescriptorSets();
+        void AllocateMaterialDataDescriptorSet();
+        void AllocateObjectDataDescriptorSet();
 
         void CreatePipelines();
         void DestroyPipelines();
@@ -69,6 +82,7 @@ namespace Firefly
 
         Texture::SampleCount m_msaaSampleCount = Texture::SampleCount::SAMPLE_4;
         std::shared_ptr<RenderPass> m_mainRenderPass;
+        std::shared_ptr<RenderPass> m_mainLateRenderPass;
         std::vector<std::shared_ptr<FrameBuffer>> m_mainFrameBuffers;
         std::shared_ptr<VulkanTexture> m_depthTexture;
         std::shared_ptr<VulkanTexture> m_colorTexture;
@@ -92,26 +106,22 @@ namespace Firefly
         std::vector<vk::DeviceMemory> m_sceneDataUniformBufferMemories;
 
         vk::DescriptorSetLayout m_materialDataDescriptorSetLayout;
-        std::vector<vk::DescriptorSet> m_materialDataDescriptorSets;
-        std::vector<vk::Buffer> m_materialDataUniformBuffers;
-        std::vector<vk::DeviceMemory> m_materialDataUniformBufferMemories;
-        MaterialData* m_materialData;
-        size_t m_materialDataCount = 100;
+        vk::DescriptorSet m_materialDataDescriptorSet;
+        VulkanSceneBuffer m_materialDataBuffer;
+        size_t m_materialDataCount = Material::s_maxMaterialCount;
         size_t m_materialDataDynamicAlignment;
 
         vk::DescriptorSetLayout m_materialTexturesDescriptorSetLayout;
 
         vk::DescriptorSetLayout m_objectDataDescriptorSetLayout;
-        std::vector<vk::DescriptorSet> m_objectDataDescriptorSets;
-        std::vector<vk::Buffer> m_objectDataUniformBuffers;
-        std::vector<vk::DeviceMemory> m_objectDataUniformBufferMemories;
-        ObjectData* m_objectData;
+        vk::DescriptorSet m_objectDataDescriptorSet;
+        VulkanSceneBuffer m_objectDataBuffer;
         size_t m_objectDataCount = 1000;
-        size_t m_objectDataDynamicAlignment;
 
-        std::vector<Entity> m_entities;
-        std::vector<std::shared_ptr<Material>> m_materials;
-        std::vector<size_t> m_entityMaterialIndices;
+        VulkanOcclusionCuller m_occlusionCuller;
+        std::vector<VulkanOcclusionCuller::CullObject> m_cullObjects;
+        std::vector<uint32_t> m_drawOrder;
+        std::vector<DrawBatch> m_drawBatches;
 
         std::shared_ptr<VulkanTexture> m_environmentCubeMap;
         std::shared_ptr<VulkanTexture> m_irradianceCubeMap;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Rendering/Shader.h"
+#include "Rendering/Vulkan/VulkanContext.h"
+
+namespace Firefly
+{
+    // persistent device local buffer of per-object or per-material elements, only the elements written since the last
+    // upload are copied to the gpu as {index, data} deltas that a compute shader scatters into the buffer
+    class VulkanSceneBuffer
+    {
+    public:
+        static constexpr uint32_t s_invalidIndex = std::numeric_limits<uint32_t>::max();
+
+        // the stride has to be a multiple of 16 bytes, the buffer can be bound as dynamic uniform buffer with it
+        void Init(uint32_t elementCount, uint32_t elementSize, vk::DeviceSize elementStride);
+        void Destroy();
+
+        // a later write to the same element before the next upload replaces the earlier one
+        void Write(uint32_t elementIndex, const void* data);
+
+        // record into the current command buffer outside of a render pass, before the first draw reading the buffer
+        void RecordUpload();
+
+        vk::Buffer GetBuffer() const;
+
+    private:
+        struct ScatterPushConstants
+        {
+            uint32_t deltaCount;
+            uint32_t elementVec4Count;
+            uint32_t elementVec4Stride;
+        };
+
+        void CreateDeltaBuffer(uint32_t imageIndex, uint32_t deltaCapacity);
+        void DestroyDeltaBuffer(uint32_t imageIndex);
+        void UpdateDescriptorSet(uint32_t imageIndex);
+
+        static constexpr uint32_t s_minDeltaCapacity = 64;
+
+        std::shared_ptr<VulkanContext> m_vkContext;
+        std::shared_ptr<VulkanDevice> m_device;
+        uint32_t m_imageCount = 0;
+        uint32_t m_elementCount = 0;
+        uint32_t m_elementSize = 0;
+        uint32_t m_elementVec4Count = 0;
+        vk::DeviceSize m_elementStride = 0;
+
+        vk::Buffer m_buffer;
+        vk::DeviceMemory m_bufferMemory;
+
+        // one header vec4 holding the element index followed by the element data, grown when a frame has more deltas
+        std::vector<vk::Buffer> m_deltaBuffers;
+        std::vector<vk::DeviceMemory> m_deltaBufferMemories;
+        std::vector<uint32_t> m_deltaCapacities;
+
+        std::vector<uint32_t> m_pendingElementIndices;
+        std::vector<uint8_t> m_pendingDeltas;
+        std::vector<uint32_t> m_pendingDeltaIndices;
+
+        std::shared_ptr<Shader> m_scatterShader;
+        vk::DescriptorSetLayout m_descriptorSetLayout;
+        std::vector<vk::DescriptorSet> m_descriptorSets;
+        vk::PipelineLayout m_pipelineLayout;
+        vk::Pipeline m_pipeline;
+    };
+}
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace Firefly
     class VulkanSwapchain
     {
     public:
-        void Init(vk::Device device, vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, uint32_t width, uint32_t height);
+        void Init(vk::Device device, vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, uint32_t width, uint32_t height, vk::PresentModeKHR presentMode);
         void Destroy();
 
         vk::SwapchainKHR GetHandle() const;
@@ -23,7 +23,7 @@ namespace Firefly
             uint32_t mipMapLevels, uint32_t arrayLayers, vk::SampleCountFlagBits sampleCount,
             vk::ImageUsageFlags usage, vk::MemoryPropertyFlags memoryPropertyFlags, vk::ImageCreateFlags createFlags,
             vk::Image& image, vk::DeviceMemory& imageMemory);
-        static void CopyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height, vk::Format format, uint32_t arrayLayers);
+        static void CopyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height, vk::Format format, Format textureFormat, uint32_t mipMapLevels, uint32_t arrayLayers);
         static void TransitionImageLayout(vk::Image image, vk::ImageLayout oldLayout, vk::ImageLayout newLayout,
             vk::Format format, uint32_t mipMapLevels, uint32_t arrayLayers);
         static void GenerateMipMaps(vk::Image image, uint32_t width, uint32_t height, vk::Format format, uint32_t mipMapLevels, uint32_t arrayLayers);
@@ -38,10 +38,10 @@ namespace Firefly
         static vk::SampleCountFlagBits ConvertToVulkanSampleCount(SampleCount sampleCount);
 
     protected:
-        virtual void OnInit(void* pixelData) override;
+        virtual void OnInit(void* pixelData, uint32_t pixelDataMipLevels) override;
 
     private:
-        void CreateImage(void* pixelData);
+        void CreateImage(void* pixelData, uint32_t pixelDataMipLevels);
         void DestroyImage();
         void CreateImageView();
         void DestroyImageView();
@@ -40,7 +40,9 @@ namespace Firefly::VulkanUtils
         vk::SurfaceKHR surface, SwapchainData& swapchainData);
 
     vk::PipelineLayout CreatePipelineLayout(std::vector<vk::DescriptorSetLayout> descriptorSetLayouts);
+    vk::PipelineLayout CreatePipelineLayout(std::vector<vk::DescriptorSetLayout> descriptorSetLayouts, std::vector<vk::PushConstantRange> pushConstantRanges);
     vk::Pipeline CreatePipeline(vk::PipelineLayout layout, std::shared_ptr<VulkanRenderPass> renderPass, std::shared_ptr<VulkanShader> shader, vk::FrontFace frontFace = vk::FrontFace::eCounterClockwise);
+    vk::Pipeline CreateComputePipeline(vk::PipelineLayout layout, std::shared_ptr<VulkanShader> shader);
 
     vk::CommandBuffer BeginOneTimeCommandBuffer(vk::Device device, vk::CommandPool commandPool);
     void EndCommandBuffer(vk::Device device, vk::CommandBuffer commandBuffer, vk::CommandPool commandPool, vk::Queue queue);
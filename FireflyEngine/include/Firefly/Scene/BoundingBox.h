@@ -0,0 +1,86 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <limits>
+
+namespace Firefly
+{
+    struct BoundingBox
+    {
+        glm::vec3 m_min = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 m_max = glm::vec3(-std::numeric_limits<float>::max());
+
+        BoundingBox() = default;
+        BoundingBox(const BoundingBox& other) = default;
+        BoundingBox(const glm::vec3& min, const glm::vec3& max) :
+            m_min(min), m_max(max) {}
+
+        bool IsValid() const
+        {
+            return m_min.x <= m_max.x && m_min.y <= m_max.y && m_min.z <= m_max.z;
+        }
+
+        glm::vec3 GetCenter() const
+        {
+            return 0.5f * (m_min + m_max);
+        }
+
+        glm::vec3 GetExtents() const
+        {
+            return 0.5f * (m_max - m_min);
+        }
+
+        float GetSurfaceArea() const
+        {
+            glm::vec3 size = m_max - m_min;
+            return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+        }
+
+        void Expand(const glm::vec3& point)
+        {
+            m_min = glm::min(m_min, point);
+            m_max = glm::max(m_max, point);
+        }
+
+        BoundingBox Inflated(float margin) const
+        {
+            return BoundingBox(m_min - glm::vec3(margin), m_max + glm::vec3(margin));
+        }
+
+        bool Contains(const BoundingBox& other) const
+        {
+            return m_min.x <= other.m_min.x && m_min.y <= other.m_min.y && m_min.z <= other.m_min.z &&
+                other.m_max.x <= m_max.x && other.m_max.y <= m_max.y && other.m_max.z <= m_max.z;
+        }
+
+        bool Intersects(const BoundingBox& other) const
+        {
+            return m_min.x <= other.m_max.x && other.m_min.x <= m_max.x &&
+                m_min.y <= other.m_max.y && other.m_min.y <= m_max.y &&
+                m_min.z <= other.m_max.z && other.m_min.z <= m_max.z;
+        }
+
+        float GetDistanceSquared(const glm::vec3& point) const
+        {
+            glm::vec3 delta = glm::max(glm::max(m_min - point, point - m_max), glm::vec3(0.f));
+            return glm::dot(delta, delta);
+        }
+
+        // Arvo's method: the box of a transformed box without transforming all eight corners.
+        BoundingBox Transformed(const glm::mat4& transform) const
+        {
+            glm::vec3 center = glm::vec3(transform * glm::vec4(GetCenter(), 1.f));
+            glm::vec3 extents = GetExtents();
+            glm::vec3 transformedExtents = glm::abs(glm::vec3(transform[0])) * extents.x +
+                glm::abs(glm::vec3(transform[1])) * extents.y +
+                glm::abs(glm::vec3(transform[2])) * extents.z;
+            return BoundingBox(center - transformedExtents, center + transformedExtents);
+        }
+
+        static BoundingBox Merge(const BoundingBox& a, const BoundingBox& b)
+        {
+            return BoundingBox(glm::min(a.m_min, b.m_min), glm::max(a.m_max, b.m_max));
+        }
+    };
+}
\ No newline at end of file
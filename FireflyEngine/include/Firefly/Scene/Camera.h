@@ -2,6 +2,8 @@
 
 #include <glm/glm.hpp>
 
+#include "Scene/Frustum.h"
+
 namespace Firefly
 {
     class Camera
@@ -28,6 +30,7 @@ namespace Firefly
 
         glm::mat4 GetViewMatrix() const;
         glm::mat4 GetProjectionMatrix() const;
+        Frustum GetFrustum() const;
         glm::vec3 GetPosition() const;
         glm::vec3 GetViewDirection() const;
         glm::vec3 GetRightDirection() const;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <entt.hpp>
+
+namespace Firefly
+{
+    // intrusive parent/child links, maintained by TransformHierarchy::SetParent
+    struct HierarchyComponent
+    {
+        entt::entity m_parent = entt::null;
+        entt::entity m_firstChild = entt::null;
+        entt::entity m_previousSibling = entt::null;
+        entt::entity m_nextSibling = entt::null;
+
+        HierarchyComponent() = default;
+        HierarchyComponent(const HierarchyComponent& other) = default;
+    };
+}
\ No newline at end of file
@@ -1,17 +1,17 @@
 #pragma once
 
 #include "pch.h"
-#include "Rendering/Material.h"
+#include "Core/ResourceHandle.h"
 
 namespace Firefly
 {
     struct MaterialComponent
     {
-        std::shared_ptr<Material> m_material;
+        MaterialHandle m_material;
 
         MaterialComponent() = default;
         MaterialComponent(const MaterialComponent& other) = default;
-        MaterialComponent(std::shared_ptr<Material> material) :
+        MaterialComponent(MaterialHandle material) :
             m_material(material) {}
     };
 }
\ No newline at end of file
@@ -1,17 +1,17 @@
 #pragma once
 
 #include "pch.h"
-#include "Rendering/Mesh.h"
+#include "Core/ResourceHandle.h"
 
 namespace Firefly
 {
     struct MeshComponent
     {
-        std::shared_ptr<Mesh> m_mesh;
+        MeshHandle m_mesh;
 
         MeshComponent() = default;
         MeshComponent(const MeshComponent& other) = default;
-        MeshComponent(std::shared_ptr<Mesh> mesh) :
+        MeshComponent(MeshHandle mesh) :
             m_mesh(mesh) {}
     };
 }
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pch.h"
+#include "Rendering/SoftwareOcclusionCuller.h"
+
+namespace Firefly
+{
+    struct OccluderComponent
+    {
+        std::shared_ptr<OccluderMesh> m_occluderMesh;
+
+        OccluderComponent() = default;
+        OccluderComponent(const OccluderComponent& other) = default;
+        OccluderComponent(std::shared_ptr<OccluderMesh> occluderMesh) :
+            m_occluderMesh(occluderMesh) {}
+    };
+}
\ No newline at end of file
@@ -1,16 +1,60 @@
 #pragma once
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 namespace Firefly
 {
     struct TransformComponent
     {
-        glm::mat4 m_transform;
+        // local transform relative to the parent in the TransformHierarchy
+        glm::vec3 m_position = glm::vec3(0.0f);
+        glm::quat m_rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 m_scale = glm::vec3(1.0f);
+
+        // world matrix and its inverse transpose, written by TransformHierarchy::Update
+        glm::mat4 m_transform = glm::mat4(1.0f);
+        glm::mat4 m_normalMatrix = glm::mat4(1.0f);
+        // incremented whenever the world matrix changes, data derived from it can be cached against the version
+        uint32_t m_version = 0;
 
         TransformComponent() = default;
         TransformComponent(const TransformComponent& other) = default;
+        TransformComponent(const glm::vec3& position, const glm::quat& rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f), const glm::vec3& scale = glm::vec3(1.0f)) :
+            m_position(position), m_rotation(rotation), m_scale(scale), m_transform(ComposeMatrix(position, rotation, scale)), m_normalMatrix(ComputeNormalMatrix(m_transform)) {}
+        // the matrix must not contain shear
         TransformComponent(const glm::mat4& transform) :
-            m_transform(transform) {}
+            m_transform(transform), m_normalMatrix(ComputeNormalMatrix(transform))
+        {
+            m_position = glm::vec3(transform[3]);
+            m_scale = glm::vec3(glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2])));
+            glm::mat3 rotation(glm::vec3(transform[0]) / m_scale.x, glm::vec3(transform[1]) / m_scale.y, glm::vec3(transform[2]) / m_scale.z);
+            if (glm::determinant(rotation) < 0.0f)
+            {
+                m_scale.x = -m_scale.x;
+                rotation[0] = -rotation[0];
+            }
+            m_rotation = glm::quat_cast(rotation);
+        }
+
+        glm::mat4 GetLocalMatrix() const
+        {
+            return ComposeMatrix(m_position, m_rotation, m_scale);
+        }
+
+        static glm::mat4 ComposeMatrix(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+        {
+            glm::mat3 rotationMatrix = glm::mat3_cast(rotation);
+            return glm::mat4(
+                glm::vec4(rotationMatrix[0] * scale.x, 0.0f),
+                glm::vec4(rotationMatrix[1] * scale.y, 0.0f),
+                glm::vec4(rotationMatrix[2] * scale.z, 0.0f),
+                glm::vec4(position, 1.0f));
+        }
+
+        static glm::mat4 ComputeNormalMatrix(const glm::mat4& transform)
+        {
+            return glm::mat4(glm::transpose(glm::inverse(glm::mat3(transform))));
+        }
     };
 }
\ No newline at end of file
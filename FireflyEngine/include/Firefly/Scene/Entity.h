@@ -8,15 +8,16 @@ namespace Firefly
 {
     class Scene;
 
+    // lightweight handle, it does not own the registry and is cheap to copy, the scene has to outlive it
     class Entity
     {
     public:
-        Entity(const Entity& entity);
-        Entity(std::shared_ptr<entt::registry> entityRegistry, entt::entity id = entt::null);
+        Entity(const Entity& entity) = default;
+        Entity(entt::registry* entityRegistry, entt::entity id = entt::null);
         Entity(std::shared_ptr<Scene> scene);
-        ~Entity();
 
         void RemoveFromScene();
+        entt::entity GetId() const;
 
         template<typename Component, typename... Args>
         void AddComponent(Args... args)
@@ -27,21 +28,25 @@ namespace Firefly
         template<typename Component>
         void RemoveComponent()
         {
-            m_entityRegistry->remove_if_exists<Component>();
+            m_entityRegistry->remove_if_exists<Component>(m_id);
+        }
+
+        template<typename Component, typename Func>
+        void PatchComponent(Func func)
+        {
+            m_entityRegistry->patch<Component>(m_id, func);
         }
 
         template<typename Component>
         Component& GetComponent() const
         {
-            auto view = m_entityRegistry->view<Component>();
-            return view.get<Component>(m_id);
+            return m_entityRegistry->get<Component>(m_id);
         }
 
         template<typename... Components>
         std::tuple<Components&...> GetComponents() const
         {
-            auto view = m_entityRegistry->view<Components...>();
-            return view.get<Components...>(m_id);
+            return m_entityRegistry->get<Components...>(m_id);
         }
 
         template<typename... Components>
@@ -51,7 +56,7 @@ namespace Firefly
         }
 
     private:
-        std::shared_ptr<entt::registry> m_entityRegistry;
+        entt::registry* m_entityRegistry;
         entt::entity m_id;
     };
 }
\ No newline at end of file
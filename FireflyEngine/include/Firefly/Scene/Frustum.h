@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Scene/BoundingBox.h"
+
+namespace Firefly
+{
+    struct Frustum
+    {
+        enum Plane
+        {
+            Left,
+            Right,
+            Bottom,
+            Top,
+            Near,
+            Far,
+            Count
+        };
+
+        // xyz = inward facing normal, w = distance
+        glm::vec4 m_planes[Plane::Count];
+
+        Frustum() = default;
+        Frustum(const Frustum& other) = default;
+        Frustum(const glm::mat4& viewProjection)
+        {
+            glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+            glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+            glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+            glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+            m_planes[Plane::Left] = row3 + row0;
+            m_planes[Plane::Right] = row3 - row0;
+            m_planes[Plane::Bottom] = row3 + row1;
+            m_planes[Plane::Top] = row3 - row1;
+            // -w <= z is conservative for both the OpenGL and the zero to one depth range
+            m_planes[Plane::Near] = row3 + row2;
+            m_planes[Plane::Far] = row3 - row2;
+
+            for (auto& plane : m_planes)
+                plane /= glm::length(glm::vec3(plane));
+        }
+
+        bool Intersects(const BoundingBox& box) const
+        {
+            glm::vec3 center = box.GetCenter();
+            glm::vec3 extents = box.GetExtents();
+            for (const auto& plane : m_planes)
+            {
+                float radius = glm::dot(extents, glm::abs(glm::vec3(plane)));
+                if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+                    return false;
+            }
+            return true;
+        }
+
+        bool Contains(const BoundingBox& box) const
+        {
+            glm::vec3 center = box.GetCenter();
+            glm::vec3 extents = box.GetExtents();
+            for (const auto& plane : m_planes)
+            {
+                float radius = glm::dot(extents, glm::abs(glm::vec3(plane)));
+                if (glm::dot(glm::vec3(plane), center) + plane.w < radius)
+                    return false;
+            }
+            return true;
+        }
+    };
+}
\ No newline at end of file
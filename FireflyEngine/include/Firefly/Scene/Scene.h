@@ -2,7 +2,11 @@
 
 #include <entt.hpp>
 
+#include "Core/ResourceHandle.h"
+#include "Core/ThreadPool.h"
 #include "Scene/Entity.h"
+#include "Scene/SceneSpatialIndex.h"
+#include "Scene/TransformHierarchy.h"
 
 namespace Firefly
 {
@@ -12,21 +16,73 @@ namespace Firefly
         Scene();
         ~Scene();
 
-        std::vector<Entity> GetEntities();
+        Entity GetEntity(entt::entity id);
+        SceneSpatialIndex& GetSpatialIndex();
+        TransformHierarchy& GetTransformHierarchy();
 
-        template<typename... Components>
-        std::vector<Entity> GetEntityGroup()
+        // patches the MeshComponents using one of the meshes, so the caches built from their bounds are updated
+        void RefreshMeshes(const std::vector<MeshHandle>& meshes);
+
+        // calls func(Entity, Components&...) for every entity that has all components, straight from the component pools
+        template<typename... Components, typename Func>
+        void Each(Func func)
+        {
+            entt::registry* entityRegistry = m_entityRegistry.get();
+            m_entityRegistry->view<Components...>().each([entityRegistry, &func](entt::entity id, Components&... components)
+                {
+                    func(Entity(entityRegistry, id), components...);
+                });
+        }
+
+        // calls func(entt::entity, Components&...) for chunks of grainSize entities on the thread pool
+        // components that are only read have to be requested as const, so writing to them does not compile,
+        // anything func reaches through captured references or this is shared by all workers and needs its own synchronization,
+        // there is no Entity handle because adding or removing components while iterating in parallel is a race
+        template<typename... Components, typename Func>
+        void ParallelEach(const Func& func, size_t grainSize = 1024)
         {
-            std::vector<Entity> entityGroup;
+            static_assert(sizeof...(Components) > 0, "ParallelEach needs at least one component to iterate");
+            static_assert(std::is_invocable_v<const Func&, entt::entity, Components&...>,
+                "ParallelEach needs a func(entt::entity, Components&...), read only components as const references");
+
+            // the smallest pool bounds the iteration, the view filters the entities that miss other components
+            const entt::entity* entities = nullptr;
+            size_t entityCount = std::numeric_limits<size_t>::max();
+            ([this, &entities, &entityCount]()
+                {
+                    auto pool = m_entityRegistry->view<std::remove_const_t<Components>>();
+                    if (pool.size() < entityCount)
+                    {
+                        entityCount = pool.size();
+                        entities = pool.data();
+                    }
+                }(), ...);
+
             auto view = m_entityRegistry->view<Components...>();
-            for (auto entityId : view)
-                entityGroup.push_back(Entity(m_entityRegistry, entityId));
-            return entityGroup;
+            ThreadPool::Instance().ParallelFor(entityCount, grainSize, [&view, entities, &func](size_t begin, size_t end)
+                {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        entt::entity entity = entities[i];
+                        if (view.contains(entity))
+                            func(entity, view.template get<Components>(entity)...);
+                    }
+                });
+        }
+
+        // for loops that need more control, e.g. view.get<Component>(id) or early outs
+        template<typename... Components>
+        auto View()
+        {
+            return m_entityRegistry->view<Components...>();
         }
 
     private:
         std::shared_ptr<entt::registry> m_entityRegistry;
+        std::unique_ptr<SceneSpatialIndex> m_spatialIndex;
+        std::unique_ptr<TransformHierarchy> m_transformHierarchy;
 
         friend class Entity;
+        friend class RenderProxyCache;
     };
 }
\ No newline at end of file
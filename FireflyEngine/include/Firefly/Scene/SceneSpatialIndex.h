@@ -0,0 +1,117 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include "Scene/BoundingBox.h"
+#include "Scene/Frustum.h"
+
+namespace Firefly
+{
+    // dynamic AABB tree over all entities with a TransformComponent and a MeshComponent
+    // changes are picked up through the registry signals, so transforms have to be patched (Entity::PatchComponent) or flagged with MarkDirty
+    class SceneSpatialIndex
+    {
+    public:
+        struct Ray
+        {
+            glm::vec3 origin;
+            glm::vec3 direction;
+        };
+
+        struct RayHit
+        {
+            entt::entity entity = entt::null;
+            float distance = 0.f;
+        };
+
+        SceneSpatialIndex(std::shared_ptr<entt::registry> entityRegistry, float fatMargin = 0.1f);
+        ~SceneSpatialIndex();
+
+        void Update();
+        void MarkDirty(entt::entity entity);
+
+        void QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& result) const;
+        void QueryBox(const BoundingBox& box, std::vector<entt::entity>& result) const;
+        void QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& result) const;
+        void QueryNearest(const glm::vec3& point, uint32_t count, std::vector<entt::entity>& result) const;
+        bool RayCast(const Ray& ray, float maxDistance, RayHit& hit) const;
+
+        bool GetBoundingBox(entt::entity entity, BoundingBox& box) const;
+        uint32_t GetProxyCount() const;
+        int32_t GetHeight() const;
+
+    private:
+        static constexpr int32_t s_nullNode = -1;
+
+        struct Node
+        {
+            BoundingBox fatBox;
+            BoundingBox box;
+            entt::entity entity = entt::null;
+            int32_t parent = s_nullNode;
+            int32_t child1 = s_nullNode;
+            int32_t child2 = s_nullNode;
+            int32_t height = -1;
+
+            bool IsLeaf() const { return child1 == s_nullNode; }
+        };
+
+        void OnBoundsChanged(entt::registry& registry, entt::entity entity);
+        void OnBoundsRemoved(entt::registry& registry, entt::entity entity);
+
+        bool CalculateBoundingBox(entt::entity entity, BoundingBox& box) const;
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t nodeIndex);
+
+        int32_t CreateProxy(entt::entity entity, const BoundingBox& box);
+        void DestroyProxy(int32_t proxyIndex);
+        void MoveProxy(int32_t proxyIndex, const BoundingBox& box);
+
+        void InsertLeaf(int32_t leafIndex);
+        void RemoveLeaf(int32_t leafIndex);
+        int32_t Balance(int32_t nodeIndex);
+        void RefitAncestors(int32_t nodeIndex);
+
+        template<typename NodeTest, typename LeafCallback>
+        void Traverse(NodeTest&& nodeTest, LeafCallback&& leafCallback) const
+        {
+            if (m_root == s_nullNode)
+                return;
+
+            thread_local std::vector<int32_t> stack;
+            stack.clear();
+            stack.push_back(m_root);
+            while (!stack.empty())
+            {
+                int32_t nodeIndex = stack.back();
+                stack.pop_back();
+
+                const Node& node = m_nodes[nodeIndex];
+                if (!nodeTest(node.fatBox))
+                    continue;
+
+                if (node.IsLeaf())
+                {
+                    leafCallback(node);
+                }
+                else
+                {
+                    stack.push_back(node.child1);
+                    stack.push_back(node.child2);
+                }
+            }
+        }
+
+        std::shared_ptr<entt::registry> m_entityRegistry;
+        float m_fatMargin;
+
+        std::vector<Node> m_nodes;
+        int32_t m_root = s_nullNode;
+        int32_t m_freeList = s_nullNode;
+        uint32_t m_proxyCount = 0;
+
+        std::unordered_map<entt::entity, int32_t> m_proxies;
+        std::vector<entt::entity> m_dirtyEntities;
+    };
+}
\ No newline at end of file
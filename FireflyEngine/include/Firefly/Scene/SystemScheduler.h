@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include <entt.hpp>
+
+namespace Firefly
+{
+    // access declarations of a system, any type can be used, e.g. components or shared resources like the camera
+    template<typename... Types>
+    struct Read {};
+
+    template<typename... Types>
+    struct Write {};
+
+    // runs systems on the thread pool, two systems conflict if one of them writes a type the other one reads or writes
+    // conflicting systems run in the order they were added, all others may overlap
+    // every ready system is handed to the pool as its own task, no worker waits for systems, so the ParallelFor
+    // calls inside systems find free workers
+    class SystemScheduler
+    {
+    public:
+        struct TraceEntry
+        {
+            std::string systemName;
+            uint32_t workerIndex;
+            float startTime;
+            float endTime;
+        };
+
+        ~SystemScheduler();
+
+        template<typename ReadAccess, typename WriteAccess, typename Func>
+        void AddSystem(const std::string& name, Func func)
+        {
+            System system;
+            system.name = name;
+            system.func = func;
+            AddTypeIds(ReadAccess(), system.readTypeIds);
+            AddTypeIds(WriteAccess(), system.writeTypeIds);
+            m_systems.push_back(system);
+        }
+
+        void Run(float deltaTime);
+
+        // start and end times in milliseconds relative to the start of the last Run
+        const std::vector<TraceEntry>& GetTrace() const;
+        void LogTrace() const;
+
+    private:
+        struct System
+        {
+            std::string name;
+            std::function<void(float)> func;
+            std::vector<entt::id_type> readTypeIds;
+            std::vector<entt::id_type> writeTypeIds;
+        };
+
+        template<template<typename...> typename Access, typename... Types>
+        static void AddTypeIds(Access<Types...>, std::vector<entt::id_type>& typeIds)
+        {
+            (typeIds.push_back(entt::type_info<std::remove_const_t<Types>>::id()), ...);
+        }
+
+        static bool ContainsAny(const std::vector<entt::id_type>& typeIds, const std::vector<entt::id_type>& otherTypeIds);
+        bool IsConflicting(const System& system, const System& otherSystem) const;
+        void BuildGraph();
+        // runs one ready system, leaves without waiting if the calling thread or another task took it already
+        void RunReadySystem(uint64_t runIndex, uint32_t workerIndex);
+        void SubmitReadySystems(uint64_t runIndex, size_t readySystemCount);
+
+        std::vector<System> m_systems;
+        std::vector<std::vector<size_t>> m_successors;
+        std::vector<uint32_t> m_predecessorCounts;
+
+        // guarded by m_mutex, tasks of an older run see a different run index and leave
+        std::vector<uint32_t> m_remainingPredecessorCounts;
+        std::vector<size_t> m_readySystems;
+        size_t m_doneSystemCount = 0;
+        uint64_t m_runIndex = 0;
+        uint32_t m_pendingTaskCount = 0;
+        float m_deltaTime = 0.0f;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+
+        std::chrono::steady_clock::time_point m_runStartTime;
+        std::vector<TraceEntry> m_trace;
+    };
+}
\ No newline at end of file
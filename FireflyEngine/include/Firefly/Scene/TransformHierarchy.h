@@ -0,0 +1,70 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include <glm/gtc/quaternion.hpp>
+
+namespace Firefly
+{
+    // parent/child relations between entities with a TransformComponent
+    // the nodes are kept in depth sorted arrays, so world matrices are computed level by level in linear order,
+    // only for dirty subtrees and in parallel within a level
+    // normal matrices are derived only for changed nodes, nodes with uniform scale skip the inverse
+    // local transforms have to be patched (Entity::PatchComponent) to be noticed
+    class TransformHierarchy
+    {
+    public:
+        TransformHierarchy(std::shared_ptr<entt::registry> entityRegistry);
+        ~TransformHierarchy();
+
+        // entt::null makes the child a root, its local transform is kept and becomes relative to the new parent
+        void SetParent(entt::entity child, entt::entity parent);
+        entt::entity GetParent(entt::entity entity) const;
+        void GetChildren(entt::entity entity, std::vector<entt::entity>& children) const;
+
+        void Update();
+
+        size_t GetNodeCount() const;
+        size_t GetLevelCount() const;
+
+    private:
+        static constexpr size_t s_grainSize = 256;
+        static constexpr float s_uniformScaleTolerance = 1e-5f;
+
+        void OnTransformChanged(entt::registry& registry, entt::entity entity);
+        void OnNodesChanged(entt::registry& registry, entt::entity entity);
+        void OnHierarchyRemoved(entt::registry& registry, entt::entity entity);
+
+        void Unlink(entt::entity entity);
+        void RebuildNodes();
+        void AddNode(entt::entity entity, int32_t parentIndex);
+        void UpdateNodes(size_t begin, size_t end);
+        void UpdateNormalMatrices();
+
+        // inverse transpose of the upper 3x3, batched over contiguous matrices
+        static void ComputeNormalMatrices(const glm::mat4* worldMatrices, glm::mat4* normalMatrices, size_t count);
+
+        std::shared_ptr<entt::registry> m_entityRegistry;
+
+        // level i is the range [m_levelOffsets[i], m_levelOffsets[i + 1])
+        std::vector<entt::entity> m_entities;
+        std::vector<int32_t> m_parentIndices;
+        std::vector<glm::vec3> m_positions;
+        std::vector<glm::quat> m_rotations;
+        std::vector<glm::vec3> m_scales;
+        std::vector<glm::mat4> m_worldMatrices;
+        std::vector<glm::mat4> m_normalMatrices;
+        std::vector<uint8_t> m_dirtyFlags;
+        std::vector<uint8_t> m_uniformScaleFlags;
+        std::vector<size_t> m_levelOffsets;
+        std::unordered_map<entt::entity, uint32_t> m_nodeIndices;
+
+        std::vector<uint32_t> m_normalBatchIndices;
+        std::vector<glm::mat4> m_normalBatchWorldMatrices;
+        std::vector<glm::mat4> m_normalBatchNormalMatrices;
+
+        std::vector<entt::entity> m_changedEntities;
+        bool m_areNodesDirty = true;
+        bool m_isWritingWorldMatrices = false;
+    };
+}
\ No newline at end of file
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <chrono>
+
 #include "Core/Core.h"
-#include "Event/Event.h"
+#include "Event/EventQueue.h"
 #include "Rendering/GraphicsContext.h"
 
 namespace Firefly
@@ -12,11 +14,13 @@ namespace Firefly
         Window(const std::string& title, int width, int height);
         virtual ~Window();
 
-        void SetEventCallback(const std::function<void(std::shared_ptr<Event>)>& eventCallback);
+        void SetEventCallback(const std::function<void(const Event&)>& eventCallback);
         void SetTitle(const std::string& title);
         void SetSize(int width, int height);
 
-        const std::function<void(std::shared_ptr<Event>)>& GetEventCallback();
+        const std::function<void(const Event&)>& GetEventCallback();
+        // the window callbacks queue their events, they are passed to the event callback once all events are polled
+        EventQueue& GetEventQueue();
         const std::string& GetTitle() const;
         virtual int GetWidth() const = 0;
         virtual int GetHeight() const = 0;
@@ -26,6 +30,14 @@ namespace Firefly
         int ToFireflyGamepadButtonCode(int keyCode) const;
 
         virtual void OnUpdate(float deltaTime) = 0;
+        // blocks until an event arrives or the timeout in seconds passed, polls the same events as OnUpdate
+        virtual void WaitEvents(float timeout) = 0;
+        virtual bool IsMinimized() const = 0;
+        virtual bool IsFocused() const = 0;
+        // when the events were polled last, the input of a frame is as old as this
+        std::chrono::steady_clock::time_point GetLastEventPollTime() const;
+        // timestamp of the newest key, mouse or gamepad event of the last dispatch, default when there was none
+        std::chrono::steady_clock::time_point GetNewestInputEventTime() const;
 
     protected:
         virtual void OnSetTitle(const std::string& title) = 0;
@@ -33,10 +45,14 @@ namespace Firefly
         virtual void SetupKeyCodeConversionMap() = 0;
         virtual void SetupMouseButtonCodeConversionMap() = 0;
         virtual void SetupGamepadButtonCodeConversionMap() = 0;
+        void DispatchEvents();
 
-        std::function<void(std::shared_ptr<Event>)> m_eventCallback;
+        std::function<void(const Event&)> m_eventCallback;
+        EventQueue m_eventQueue;
         std::shared_ptr<GraphicsContext> m_context;
         std::string m_title;
+        std::chrono::steady_clock::time_point m_lastEventPollTime;
+        std::chrono::steady_clock::time_point m_newestInputEventTime;
         std::unordered_map<int, int> m_keyCodeConversionMap; // SpecificKeyCode, FireflyKeyCode
         std::unordered_map<int, int> m_mouseButtonCodeConversionMap; // SpecificMouseButtonCode, FireflyMouseButtonCode
         std::unordered_map<int, int> m_gamepadButtonCodeConversionMap; // SpecificGamepadButtonCode, FireflyGamepadButtonCode
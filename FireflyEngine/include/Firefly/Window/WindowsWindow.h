@@ -12,6 +12,9 @@ namespace Firefly
         virtual ~WindowsWindow();
 
         virtual void OnUpdate(float deltaTime) override;
+        virtual void WaitEvents(float timeout) override;
+        virtual bool IsMinimized() const override;
+        virtual bool IsFocused() const override;
 
         virtual int GetHeight() const override;
         virtual int GetWidth() const override;
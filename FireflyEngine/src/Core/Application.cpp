@@ -4,6 +4,7 @@
 #include "Window/WindowsWindow.h"
 #include "Input/Input.h"
 #include "Core/ResourceRegistry.h"
+#include "Rendering/ResourceLoader.h"
 
 namespace Firefly
 {
@@ -13,10 +14,12 @@ namespace Firefly
         m_window->SetEventCallback(std::bind(&Application::OnEvent, this, std::placeholders::_1));
 
         RenderingAPI::Init(m_window);
+        ResourceLoader::Instance().Init();
     }
 
     Application::~Application()
     {
+        ResourceLoader::Instance().Destroy();
         MeshRegistry::Instance().DestroyResources();
         ShaderRegistry::Instance().DestroyResources();
         MaterialRegistry::Instance().DestroyResources();
@@ -28,8 +31,34 @@ namespace Firefly
     void Application::Update(float deltaTime)
     {
         m_window->SetTitle(std::to_string(1.f / deltaTime));
-        m_window->OnUpdate(deltaTime);
-        OnUpdate(deltaTime);
+        // resources uploaded while the previous frame was drawn replace their placeholders
+        ResourceLoader::Instance().Update();
+        OnFrameStart();
+        if (IsIdle())
+            m_window->WaitEvents(1.0f / m_backgroundFrameRate);
+        else
+            m_window->OnUpdate(deltaTime);
+        Input::UpdateSnapshots();
+
+        if (m_fixedTickRate <= 0.0f)
+        {
+            OnUpdate(deltaTime);
+            return;
+        }
+
+        float fixedDeltaTime = 1.0f / m_fixedTickRate;
+        m_accumulatedTime += deltaTime;
+        uint32_t stepCount = 0;
+        while (m_accumulatedTime >= fixedDeltaTime && stepCount < m_maxFixedStepsPerFrame)
+        {
+            OnFixedUpdate(fixedDeltaTime);
+            m_accumulatedTime -= fixedDeltaTime;
+            stepCount++;
+        }
+        if (m_accumulatedTime >= fixedDeltaTime)
+            m_accumulatedTime = std::fmod(m_accumulatedTime, fixedDeltaTime);
+
+        OnRender(deltaTime, m_accumulatedTime / fixedDeltaTime);
     }
 
     void Application::RequestShutdown()
@@ -42,28 +71,67 @@ namespace Firefly
         return m_isShutdownRequested;
     }
 
-    void Application::OnEvent(std::shared_ptr<Event> event)
+    void Application::SetFixedTickRate(float tickRate)
+    {
+        m_fixedTickRate = tickRate;
+        m_accumulatedTime = 0.0f;
+    }
+
+    float Application::GetFixedTickRate() const
+    {
+        return m_fixedTickRate;
+    }
+
+    void Application::SetMaxFixedStepsPerFrame(uint32_t maxStepCount)
+    {
+        m_maxFixedStepsPerFrame = maxStepCount;
+    }
+
+    void Application::SetTargetFrameRate(float frameRate)
+    {
+        m_targetFrameRate = frameRate;
+    }
+
+    void Application::SetBackgroundFrameRate(float frameRate)
+    {
+        m_backgroundFrameRate = frameRate;
+    }
+
+    bool Application::IsIdle() const
+    {
+        return m_backgroundFrameRate > 0.0f && (m_window->IsMinimized() || !m_window->IsFocused());
+    }
+
+    float Application::GetFrameRateLimit() const
+    {
+        if (IsIdle() && (m_targetFrameRate <= 0.0f || m_backgroundFrameRate < m_targetFrameRate))
+            return m_backgroundFrameRate;
+        return m_targetFrameRate;
+    }
+
+    void Application::OnEvent(const Event& event)
     {
         Input::OnEvent(event);
 
-        if (auto windowEvent = event->AsType<WindowEvent>())
+        switch (event.GetCategory())
         {
-            OnWindowEvent(windowEvent);
-
-            if (auto closeEvent = windowEvent->AsType<WindowCloseEvent>())
+        case EventCategory::Window:
+            // the renderer reads the cached size, possibly on the render thread
+            if (auto resizeEvent = event.AsType<WindowResizeEvent>())
+                RenderingAPI::GetContext()->SetSize(resizeEvent->GetWidth(), resizeEvent->GetHeight());
+            OnWindowEvent(event);
+            if (event.IsType<WindowCloseEvent>())
                 RequestShutdown();
-        }
-        else if (auto keyEvent = event->AsType<KeyEvent>())
-        {
-            OnKeyEvent(keyEvent);
-        }
-        else if (auto mouseEvent = event->AsType<MouseEvent>())
-        {
-            OnMouseEvent(mouseEvent);
-        }
-        else if (auto gamepadEvent = event->AsType<GamepadEvent>())
-        {
-            OnGamepadEvent(gamepadEvent);
+            break;
+        case EventCategory::Key:
+            OnKeyEvent(event);
+            break;
+        case EventCategory::Mouse:
+            OnMouseEvent(event);
+            break;
+        case EventCategory::Gamepad:
+            OnGamepadEvent(event);
+            break;
         }
     }
 }
\ No newline at end of file
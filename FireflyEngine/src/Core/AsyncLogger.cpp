@@ -0,0 +1,307 @@
+#include "pch.h"
+#include "Core/AsyncLogger.h"
+
+#include "Core/Logger.h"
+
+#include <spdlog/sinks/rotating_file_sink.h>
+
+namespace Firefly
+{
+    LogRing::LogRing(size_t capacity)
+    {
+        size_t powerOfTwoCapacity = 1;
+        while (powerOfTwoCapacity < capacity)
+            powerOfTwoCapacity *= 2;
+        m_buffer.resize(powerOfTwoCapacity);
+        m_mask = powerOfTwoCapacity - 1;
+    }
+
+    size_t LogRing::GetCapacity() const
+    {
+        return m_buffer.size();
+    }
+
+    bool LogRing::IsEmpty() const
+    {
+        return m_readPosition.load(std::memory_order_acquire) == m_writePosition.load(std::memory_order_acquire);
+    }
+
+    bool LogRing::TryWrite(const uint8_t* data, size_t size)
+    {
+        size_t writePosition = m_writePosition.load(std::memory_order_relaxed);
+        size_t readPosition = m_readPosition.load(std::memory_order_acquire);
+        if (m_buffer.size() - (writePosition - readPosition) < size)
+            return false;
+
+        CopyIn(writePosition, data, size);
+        m_writePosition.store(writePosition + size, std::memory_order_release);
+        return true;
+    }
+
+    bool LogRing::TryRead(std::vector<uint8_t>& record)
+    {
+        size_t readPosition = m_readPosition.load(std::memory_order_relaxed);
+        size_t writePosition = m_writePosition.load(std::memory_order_acquire);
+        if (readPosition == writePosition)
+            return false;
+
+        uint32_t size;
+        CopyOut(readPosition, reinterpret_cast<uint8_t*>(&size), sizeof(uint32_t));
+        record.resize(size);
+        CopyOut(readPosition, record.data(), size);
+        m_readPosition.store(readPosition + size, std::memory_order_release);
+        return true;
+    }
+
+    void LogRing::CopyIn(size_t position, const uint8_t* data, size_t size)
+    {
+        size_t offset = position & m_mask;
+        size_t firstPartSize = std::min(size, m_buffer.size() - offset);
+        memcpy(&m_buffer[offset], data, firstPartSize);
+        memcpy(m_buffer.data(), data + firstPartSize, size - firstPartSize);
+    }
+
+    void LogRing::CopyOut(size_t position, uint8_t* data, size_t size) const
+    {
+        size_t offset = position & m_mask;
+        size_t firstPartSize = std::min(size, m_buffer.size() - offset);
+        memcpy(data, &m_buffer[offset], firstPartSize);
+        memcpy(data + firstPartSize, m_buffer.data(), size - firstPartSize);
+    }
+
+    std::atomic<bool> AsyncLogger::s_isRunning = false;
+    size_t AsyncLogger::s_ringCapacity = 0;
+    std::vector<spdlog::sink_ptr> AsyncLogger::s_sinks;
+    std::vector<std::shared_ptr<LogRing>> AsyncLogger::s_rings;
+    std::mutex AsyncLogger::s_ringMutex;
+    std::mutex AsyncLogger::s_writeMutex;
+    std::mutex AsyncLogger::s_mutex;
+    std::condition_variable AsyncLogger::s_condition;
+    bool AsyncLogger::s_isStopRequested = false;
+    std::atomic<bool> AsyncLogger::s_isWaiting = false;
+    bool AsyncLogger::s_isWakeUpRequested = false;
+    std::thread AsyncLogger::s_thread;
+
+    void AsyncLogger::Start(const Description& description)
+    {
+        Stop();
+
+        s_sinks.clear();
+        if (description.isConsoleEnabled)
+            s_sinks.push_back(std::make_shared<spdlog::sinks::stdout_color_sink_mt>());
+        if (!description.filePath.empty())
+            s_sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(description.filePath, description.maxFileSize, description.maxFileCount));
+        for (auto& sink : s_sinks)
+            sink->set_pattern(Logger::s_pattern);
+
+        {
+            // rings of threads that logged before keep their capacity
+            std::lock_guard<std::mutex> lock(s_ringMutex);
+            s_ringCapacity = description.ringCapacity;
+        }
+
+        s_isStopRequested = false;
+        s_isWakeUpRequested = false;
+        s_thread = std::thread(&AsyncLogger::Run);
+        s_isRunning = true;
+    }
+
+    void AsyncLogger::Stop()
+    {
+        if (!s_isRunning)
+            return;
+
+        s_isRunning = false;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_isStopRequested = true;
+            s_condition.notify_all();
+        }
+        s_thread.join();
+    }
+
+    bool AsyncLogger::IsRunning()
+    {
+        return s_isRunning.load(std::memory_order_relaxed);
+    }
+
+    void AsyncLogger::Flush()
+    {
+        std::vector<std::shared_ptr<LogRing>> rings;
+        {
+            std::lock_guard<std::mutex> lock(s_ringMutex);
+            rings = s_rings;
+        }
+
+        WakeUp();
+        for (auto& ring : rings)
+        {
+            while (!ring->IsEmpty())
+                std::this_thread::yield();
+        }
+
+        // records read from the rings are written before the logging thread releases the mutex
+        std::lock_guard<std::mutex> lock(s_writeMutex);
+    }
+
+    std::string AsyncLogger::GetFormatErrorMessage(std::string_view format, const std::exception& exception)
+    {
+        return fmt::format("Failed to format the log message \"{}\": {}", format, exception.what());
+    }
+
+    std::vector<uint8_t>& AsyncLogger::GetThreadRecordBuffer()
+    {
+        thread_local std::vector<uint8_t> recordBuffer;
+        return recordBuffer;
+    }
+
+    void AsyncLogger::Enqueue(const std::vector<uint8_t>& record)
+    {
+        struct ThreadLogRing
+        {
+            std::shared_ptr<LogRing> ring;
+
+            ~ThreadLogRing()
+            {
+                if (ring)
+                    ring->m_isAbandoned = true;
+            }
+        };
+
+        thread_local ThreadLogRing threadLogRing;
+        if (!threadLogRing.ring)
+        {
+            std::lock_guard<std::mutex> lock(s_ringMutex);
+            threadLogRing.ring = std::make_shared<LogRing>(s_ringCapacity);
+            s_rings.push_back(threadLogRing.ring);
+        }
+
+        // a record that can never fit is written by the calling thread, the sinks are thread safe
+        if (record.size() > threadLogRing.ring->GetCapacity())
+        {
+            WriteRecord(FormatRecord(record));
+            return;
+        }
+
+        while (!threadLogRing.ring->TryWrite(record.data(), record.size()))
+            std::this_thread::yield();
+
+        // pairs with the fence of the logging thread, either it sees the record or the writer sees it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (s_isWaiting.load(std::memory_order_relaxed))
+            WakeUp();
+    }
+
+    void AsyncLogger::WakeUp()
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_isWakeUpRequested = true;
+        s_condition.notify_all();
+    }
+
+    bool AsyncLogger::AreRingsEmpty()
+    {
+        std::lock_guard<std::mutex> lock(s_ringMutex);
+        for (auto& ring : s_rings)
+        {
+            if (!ring->IsEmpty())
+                return false;
+        }
+        return true;
+    }
+
+    AsyncLogger::FormattedRecord AsyncLogger::FormatRecord(const std::vector<uint8_t>& record)
+    {
+        RecordHeader header;
+        memcpy(&header, record.data(), sizeof(RecordHeader));
+        std::string_view format(reinterpret_cast<const char*>(record.data() + sizeof(RecordHeader)), header.formatLength);
+
+        FormattedRecord formattedRecord;
+        formattedRecord.time = header.time;
+        formattedRecord.handle = header.handle;
+        formattedRecord.level = header.level;
+        // an exception would terminate the logging thread, the record reports the bad format string instead
+        try
+        {
+            formattedRecord.message = header.formatFunction(format, record.data() + sizeof(RecordHeader) + header.formatLength);
+        }
+        catch (const std::exception& exception)
+        {
+            formattedRecord.level = spdlog::level::err;
+            formattedRecord.message = GetFormatErrorMessage(format, exception);
+        }
+        return formattedRecord;
+    }
+
+    void AsyncLogger::WriteRecord(const FormattedRecord& record)
+    {
+        spdlog::details::log_msg message(record.time, spdlog::source_loc{}, record.handle->name(), record.level, record.message);
+        for (auto& sink : s_sinks)
+            sink->log(message);
+    }
+
+    void AsyncLogger::Run()
+    {
+        std::vector<uint8_t> record;
+        std::vector<FormattedRecord> formattedRecords;
+        while (true)
+        {
+            bool isStopRequested;
+            {
+                std::unique_lock<std::mutex> lock(s_mutex);
+                isStopRequested = s_isStopRequested;
+            }
+
+            std::vector<std::shared_ptr<LogRing>> rings;
+            {
+                std::lock_guard<std::mutex> lock(s_ringMutex);
+                rings = s_rings;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(s_writeMutex);
+                formattedRecords.clear();
+                for (auto& ring : rings)
+                {
+                    while (ring->TryRead(record))
+                        formattedRecords.push_back(FormatRecord(record));
+                }
+
+                // every ring is in order by itself, the threads are interleaved by their timestamps
+                std::stable_sort(formattedRecords.begin(), formattedRecords.end(), [](const FormattedRecord& a, const FormattedRecord& b)
+                    {
+                        return a.time < b.time;
+                    });
+                for (const auto& formattedRecord : formattedRecords)
+                    WriteRecord(formattedRecord);
+                if (!formattedRecords.empty())
+                {
+                    for (auto& sink : s_sinks)
+                        sink->flush();
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(s_ringMutex);
+                s_rings.erase(std::remove_if(s_rings.begin(), s_rings.end(), [](const std::shared_ptr<LogRing>& ring)
+                    {
+                        return ring->m_isAbandoned && ring->IsEmpty();
+                    }), s_rings.end());
+            }
+
+            if (!formattedRecords.empty())
+                continue;
+            if (isStopRequested)
+                return;
+
+            // announced before the rings are checked a last time, a record written after the check wakes the thread up
+            std::unique_lock<std::mutex> lock(s_mutex);
+            s_isWaiting.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (AreRingsEmpty())
+                s_condition.wait(lock, []() { return s_isWakeUpRequested || s_isStopRequested; });
+            s_isWaiting.store(false, std::memory_order_relaxed);
+            s_isWakeUpRequested = false;
+        }
+    }
+}
\ No newline at end of file
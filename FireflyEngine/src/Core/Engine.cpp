@@ -11,7 +11,9 @@ namespace Firefly
             return;
 
         Logger::Init();
-        Logger::Info(FIREFLY_ENGINE_NAME, "Version: {0}.{1}.{2}",
+        // console output would otherwise block the frame thread, e.g. during bursts of validation messages
+        AsyncLogger::Start(AsyncLogger::Description());
+        FIREFLY_LOG_INFO(FIREFLY_ENGINE_NAME, "Version: {0}.{1}.{2}",
             FIREFLY_ENGINE_VERSION_MAJOR, FIREFLY_ENGINE_VERSION_MINOR, FIREFLY_ENGINE_VERSION_PATCH);
 
         m_application = Firefly::InstantiateApplication();
@@ -25,6 +27,7 @@ namespace Firefly
             return;
 
         m_lastFrameTime = std::chrono::steady_clock::now();
+        m_frameLimiter.Reset();
         while (m_isRunning)
         {
             float deltaTime = CalculateDeltaTime();
@@ -33,6 +36,8 @@ namespace Firefly
 
             if (m_application->IsShutdownRequested())
                 m_isRunning = false;
+
+            m_frameLimiter.WaitForNextFrame(m_application->GetFrameRateLimit());
         }
     }
 
@@ -42,6 +47,7 @@ namespace Firefly
             return;
 
         delete m_application;
+        AsyncLogger::Stop();
     }
 
     float Engine::CalculateDeltaTime()
@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "Core/FrameLimiter.h"
+
+#ifdef FIREFLY_OS_WINDOWS
+#include <timeapi.h>
+#endif
+
+namespace Firefly
+{
+    FrameLimiter::~FrameLimiter()
+    {
+        SetTimerResolutionRaised(false);
+    }
+
+    void FrameLimiter::Reset()
+    {
+        m_nextFrameTime = std::chrono::steady_clock::now();
+    }
+
+    void FrameLimiter::WaitForNextFrame(float frameRate)
+    {
+        auto now = std::chrono::steady_clock::now();
+        SetTimerResolutionRaised(frameRate > 0.0f);
+        if (frameRate <= 0.0f)
+        {
+            m_nextFrameTime = now;
+            return;
+        }
+
+        // frames are scheduled on a fixed grid so the rate does not drift, a frame that ran late starts a new grid
+        auto frameDuration = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / frameRate));
+        m_nextFrameTime += frameDuration;
+        if (m_nextFrameTime < now)
+        {
+            m_nextFrameTime = now;
+            return;
+        }
+
+        SleepUntil(m_nextFrameTime);
+        while (std::chrono::steady_clock::now() < m_nextFrameTime)
+            std::this_thread::yield();
+    }
+
+    void FrameLimiter::SleepUntil(std::chrono::steady_clock::time_point time)
+    {
+        auto now = std::chrono::steady_clock::now();
+        while (time - now > m_sleepOvershoot + s_sleepDuration)
+        {
+            auto sleepStart = now;
+            std::this_thread::sleep_for(s_sleepDuration);
+            now = std::chrono::steady_clock::now();
+
+            // the estimate follows a worse scheduler at once and recovers slowly when it becomes more precise
+            std::chrono::duration<float> overshoot = now - sleepStart - s_sleepDuration;
+            m_sleepOvershoot = std::max(overshoot, m_sleepOvershoot * 0.99f);
+        }
+    }
+
+    void FrameLimiter::SetTimerResolutionRaised(bool isRaised)
+    {
+        if (isRaised == m_isTimerResolutionRaised)
+            return;
+
+#ifdef FIREFLY_OS_WINDOWS
+        if (isRaised)
+            timeBeginPeriod(1);
+        else
+            timeEndPeriod(1);
+#endif
+        m_isTimerResolutionRaised = isRaised;
+    }
+}
\ No newline at end of file
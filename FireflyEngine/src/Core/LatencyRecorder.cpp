@@ -0,0 +1,54 @@
+#include "pch.h"
+#include "Core/LatencyRecorder.h"
+
+namespace Firefly
+{
+    LatencyRecorder::LatencyRecorder(uint32_t capacity) :
+        m_capacity(capacity)
+    {
+        m_samples.reserve(m_capacity);
+    }
+
+    void LatencyRecorder::AddSample(float latency)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_samples.size() < m_capacity)
+            m_samples.push_back(latency);
+        else
+            m_samples[m_nextSampleIndex] = latency;
+        m_nextSampleIndex = (m_nextSampleIndex + 1) % m_capacity;
+    }
+
+    LatencyPercentiles LatencyRecorder::GetPercentiles() const
+    {
+        std::vector<float> samples;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            samples = m_samples;
+        }
+
+        LatencyPercentiles percentiles;
+        if (samples.empty())
+            return percentiles;
+
+        // nearest rank, a percentile is never lower than the share of samples it names
+        std::sort(samples.begin(), samples.end());
+        auto getPercentile = [&samples](float percentile)
+            {
+                size_t rank = static_cast<size_t>(std::ceil(percentile * samples.size()));
+                return samples[std::clamp<size_t>(rank, 1, samples.size()) - 1];
+            };
+        percentiles.p50 = getPercentile(0.50f);
+        percentiles.p95 = getPercentile(0.95f);
+        percentiles.p99 = getPercentile(0.99f);
+        percentiles.sampleCount = static_cast<uint32_t>(samples.size());
+        return percentiles;
+    }
+
+    void LatencyRecorder::Reset()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_samples.clear();
+        m_nextSampleIndex = 0;
+    }
+}
\ No newline at end of file
@@ -3,32 +3,33 @@
 
 namespace Firefly
 {
-    std::vector<std::shared_ptr<spdlog::logger>> Logger::s_loggers;
+    std::mutex Logger::s_mutex;
+    std::unordered_map<std::string, std::shared_ptr<spdlog::logger>> Logger::s_loggers;
+    spdlog::level::level_enum Logger::s_level = spdlog::level::trace;
 
     void Logger::Init()
     {
-        spdlog::set_pattern("%^[%T] %-8l (%n): %v%$");
+        spdlog::set_pattern(s_pattern);
     }
 
-    std::shared_ptr<spdlog::logger> Logger::GetLoggerByName(const std::string& name)
+    Logger::Handle Logger::GetHandle(const std::string& name)
     {
-        std::shared_ptr<spdlog::logger> newLogger = nullptr;
-        for (auto logger : s_loggers)
-        {
-            if (logger->name() == name)
-            {
-                newLogger = logger;
-                break;
-            }
-        }
+        std::lock_guard<std::mutex> lock(s_mutex);
+        auto iter = s_loggers.find(name);
+        if (iter != s_loggers.end())
+            return iter->second.get();
 
-        if (!newLogger)
-        {
-            newLogger = spdlog::stdout_color_mt(name);
-            newLogger->set_level(spdlog::level::trace);
-            s_loggers.push_back(newLogger);
-        }
+        std::shared_ptr<spdlog::logger> logger = spdlog::stdout_color_mt(name);
+        logger->set_level(s_level);
+        s_loggers.emplace(name, logger);
+        return logger.get();
+    }
 
-        return newLogger;
+    void Logger::SetLevel(spdlog::level::level_enum level)
+    {
+        std::lock_guard<std::mutex> lock(s_mutex);
+        s_level = level;
+        for (auto& [name, logger] : s_loggers)
+            logger->set_level(level);
     }
 }
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "pch.h"
+#include "Core/ThreadPool.h"
+
+namespace Firefly
+{
+    ThreadPool& ThreadPool::Instance()
+    {
+        static ThreadPool threadPool(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        return threadPool;
+    }
+
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        for (uint32_t i = 0; i < threadCount; i++)
+            m_threads.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isRunning = false;
+        }
+        m_condition.notify_all();
+
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    void ThreadPool::Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.push(std::move(task));
+        }
+        m_condition.notify_one();
+    }
+
+    uint32_t ThreadPool::GetThreadCount() const
+    {
+        return static_cast<uint32_t>(m_threads.size());
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return !m_isRunning || !m_tasks.empty(); });
+                if (!m_isRunning && m_tasks.empty())
+                    return;
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+}
\ No newline at end of file
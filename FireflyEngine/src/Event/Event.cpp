@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "Event/Event.h"
+
+#include "Event/WindowEvent.h"
+#include "Event/KeyEvent.h"
+#include "Event/MouseEvent.h"
+#include "Event/GamepadEvent.h"
+
+namespace Firefly
+{
+    EventCategory Event::GetCategory() const
+    {
+        if (IsType<WindowEvent>())
+            return EventCategory::Window;
+        if (IsType<KeyEvent>())
+            return EventCategory::Key;
+        if (IsType<MouseEvent>())
+            return EventCategory::Mouse;
+        return EventCategory::Gamepad;
+    }
+
+    std::string Event::ToString() const
+    {
+        switch (m_type)
+        {
+        case EventType::WindowResize:
+            return AsType<WindowResizeEvent>()->ToString();
+        case EventType::WindowClose:
+            return AsType<WindowCloseEvent>()->ToString();
+        case EventType::WindowMaximize:
+            return AsType<WindowMaximizeEvent>()->ToString();
+        case EventType::WindowMinimize:
+            return AsType<WindowMinimizeEvent>()->ToString();
+        case EventType::WindowRestore:
+            return AsType<WindowRestoreEvent>()->ToString();
+        case EventType::WindowMove:
+            return AsType<WindowMoveEvent>()->ToString();
+        case EventType::KeyPress:
+            return AsType<KeyPressEvent>()->ToString();
+        case EventType::KeyRelease:
+            return AsType<KeyReleaseEvent>()->ToString();
+        case EventType::KeyRepeat:
+            return AsType<KeyRepeatEvent>()->ToString();
+        case EventType::MouseButtonPress:
+            return AsType<MouseButtonPressEvent>()->ToString();
+        case EventType::MouseButtonRelease:
+            return AsType<MouseButtonReleaseEvent>()->ToString();
+        case EventType::MouseMove:
+            return AsType<MouseMoveEvent>()->ToString();
+        case EventType::MouseScroll:
+            return AsType<MouseScrollEvent>()->ToString();
+        case EventType::GamepadConnected:
+            return AsType<GamepadConnectedEvent>()->ToString();
+        case EventType::GamepadDisconnected:
+            return AsType<GamepadDisconnectedEvent>()->ToString();
+        case EventType::GamepadButtonPress:
+            return AsType<GamepadButtonPressEvent>()->ToString();
+        case EventType::GamepadButtonRelease:
+            return AsType<GamepadButtonReleaseEvent>()->ToString();
+        case EventType::GamepadAxisLeftMove:
+            return AsType<GamepadAxisLeftMoveEvent>()->ToString();
+        case EventType::GamepadAxisRightMove:
+            return AsType<GamepadAxisRightMoveEvent>()->ToString();
+        case EventType::GamepadTriggerLeftMove:
+            return AsType<GamepadTriggerLeftMoveEvent>()->ToString();
+        case EventType::GamepadTriggerRightMove:
+            return AsType<GamepadTriggerRightMoveEvent>()->ToString();
+        default:
+            return "UnknownEvent";
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "pch.h"
+#include "Event/EventQueue.h"
+
+#include "Event/MouseEvent.h"
+
+namespace Firefly
+{
+    void EventQueue::Push(const Event& event)
+    {
+        if (m_isMouseMoveCoalescingEnabled && event.IsType<MouseMoveEvent>() && !m_events.empty() && m_events.back().IsType<MouseMoveEvent>())
+        {
+            m_events.back() = event;
+            return;
+        }
+
+        m_events.push_back(event);
+    }
+
+    void EventQueue::SetMouseMoveCoalescingEnabled(bool enabled)
+    {
+        m_isMouseMoveCoalescingEnabled = enabled;
+    }
+
+    void EventQueue::Dispatch(const std::function<void(const Event&)>& callback)
+    {
+        // the event is copied out, a push from the callback may reallocate the storage
+        for (size_t i = 0; i < m_events.size(); i++)
+        {
+            Event event = m_events[i];
+            callback(event);
+        }
+        m_events.clear();
+    }
+}
\ No newline at end of file
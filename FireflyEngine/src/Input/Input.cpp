@@ -3,237 +3,218 @@
 
 namespace Firefly
 {
-    std::unordered_map<int, bool> Input::m_isKeyPressedMap;
-    std::unordered_map<int, Gamepad> Input::m_gamepadMap;
-    std::unordered_map<int, bool> Input::m_isMouseButtonPressedMap;
-    int Input::m_mousePositionX = 0;
-    int Input::m_mousePositionY = 0;
+    InputState Input::m_state;
+    std::array<std::string, FIREFLY_MAX_GAMEPADS> Input::m_gamepadNames;
+    std::array<InputSnapshot, 3> Input::m_snapshots;
+    std::atomic<uint32_t> Input::m_snapshotIndex = 0;
 
     bool Input::IsKeyPressed(int keyCode)
     {
-        auto iter = m_isKeyPressedMap.find(keyCode);
-        if (iter != m_isKeyPressedMap.end())
-            return iter->second;
-        else
-            return false;
+        return m_state.IsKeyPressed(keyCode);
     }
 
     bool Input::IsMouseButtonPressed(int mouseButton)
     {
-        auto iter = m_isMouseButtonPressedMap.find(mouseButton);
-        if (iter != m_isMouseButtonPressedMap.end())
-            return iter->second;
-        else
-            return false;
+        return m_state.IsMouseButtonPressed(mouseButton);
     }
 
     int Input::GetMousePositionX()
     {
-        return m_mousePositionX;
+        return m_state.mousePositionX;
     }
 
     int Input::GetMousePositionY()
     {
-        return m_mousePositionY;
+        return m_state.mousePositionY;
     }
 
     std::string Input::GetGamepadName(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetName();
+        if (m_state.IsGamepadConnected(gamepadNumber))
+            return m_gamepadNames[gamepadNumber];
         else
             return "";
     }
 
     bool Input::IsGamepadConnected(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return true;
-        else
-            return false;
+        return m_state.IsGamepadConnected(gamepadNumber);
     }
 
     bool Input::IsGamepadButtonPressed(int gamepadNumber, int gamepadButton)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.IsButtonPressed(gamepadButton);
-        else
-            return false;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad && gamepad->IsButtonPressed(gamepadButton);
     }
 
     float Input::GetGamepadAxisLeftX(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetAxisLeftX();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetAxisLeftX() : 0.0f;
     }
 
     float Input::GetGamepadAxisLeftY(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetAxisLeftY();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetAxisLeftY() : 0.0f;
     }
 
     float Input::GetGamepadAxisRightX(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetAxisRightX();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetAxisRightX() : 0.0f;
     }
 
     float Input::GetGamepadAxisRightY(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetAxisRightY();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetAxisRightY() : 0.0f;
     }
 
     float Input::GetGamepadTriggerLeft(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetTriggerLeft();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetTriggerLeft() : 0.0f;
     }
 
     float Input::GetGamepadTriggerRight(int gamepadNumber)
     {
-        auto iter = m_gamepadMap.find(gamepadNumber);
-        if (iter != m_gamepadMap.end())
-            return iter->second.GetTriggerRight();
-        else
-            return 0.0f;
+        const Gamepad* gamepad = m_state.GetGamepad(gamepadNumber);
+        return gamepad ? gamepad->GetTriggerRight() : 0.0f;
     }
 
-    void Input::OnEvent(std::shared_ptr<Event> event)
+    bool Input::WasKeyPressedThisFrame(int keyCode)
     {
-        if (auto mouseEvent = event->AsType<MouseEvent>())
-            OnMouseEvent(mouseEvent);
-        else if (auto keyEvent = event->AsType<KeyEvent>())
-            OnKeyEvent(keyEvent);
-        else if (auto gamepadEvent = event->AsType<GamepadEvent>())
-            OnGamepadEvent(gamepadEvent);
+        return GetSnapshot().WasKeyPressedThisFrame(keyCode);
     }
 
-    void Input::OnKeyEvent(std::shared_ptr<KeyEvent> keyEvent)
+    bool Input::WasKeyReleasedThisFrame(int keyCode)
     {
-        bool isKeyDown = false;
-        if (keyEvent->IsType<KeyPressEvent>() || keyEvent->IsType<KeyRepeatEvent>())
-            isKeyDown = true;
-
-        auto iter = m_isKeyPressedMap.find(keyEvent->GetKeyCode());
-        if (iter != m_isKeyPressedMap.end())
-            iter->second = isKeyDown;
-        else
-            m_isKeyPressedMap.insert(std::pair<int, bool>(keyEvent->GetKeyCode(), isKeyDown));
+        return GetSnapshot().WasKeyReleasedThisFrame(keyCode);
     }
 
-    void Input::OnMouseEvent(std::shared_ptr<MouseEvent> mouseEvent)
+    bool Input::WasMouseButtonPressedThisFrame(int mouseButton)
     {
-        if (auto mouseMoveEvent = mouseEvent->AsType<MouseMoveEvent>())
-            OnMouseMoveEvent(mouseMoveEvent);
-        else if (auto mouseButtonEvent = mouseEvent->AsType<MouseButtonEvent>())
-            OnMouseButtonEvent(mouseButtonEvent);
+        return GetSnapshot().WasMouseButtonPressedThisFrame(mouseButton);
     }
 
-    void Input::OnMouseMoveEvent(std::shared_ptr<MouseMoveEvent> mouseMoveEvent)
+    bool Input::WasMouseButtonReleasedThisFrame(int mouseButton)
     {
-        m_mousePositionX = mouseMoveEvent->GetXPos();
-        m_mousePositionY = mouseMoveEvent->GetYPos();
+        return GetSnapshot().WasMouseButtonReleasedThisFrame(mouseButton);
     }
 
-    void Input::OnMouseButtonEvent(std::shared_ptr<MouseButtonEvent> mouseButtonEvent)
+    bool Input::WasGamepadButtonPressedThisFrame(int gamepadNumber, int gamepadButton)
     {
-        bool isButtonDown = false;
-        if (mouseButtonEvent->IsType<MouseButtonPressEvent>())
-            isButtonDown = true;
-
-        auto iter = m_isMouseButtonPressedMap.find(mouseButtonEvent->GetButtonCode());
-        if (iter != m_isMouseButtonPressedMap.end())
-            iter->second = isButtonDown;
-        else
-            m_isMouseButtonPressedMap.insert(std::pair<int, bool>(mouseButtonEvent->GetButtonCode(), isButtonDown));
+        return GetSnapshot().WasGamepadButtonPressedThisFrame(gamepadNumber, gamepadButton);
     }
 
-    void Input::OnGamepadEvent(std::shared_ptr<GamepadEvent> gamepadEvent)
+    bool Input::WasGamepadButtonReleasedThisFrame(int gamepadNumber, int gamepadButton)
     {
-        if (gamepadEvent->IsType<GamepadConnectedEvent>())
-        {
-            auto iter = m_gamepadMap.find(gamepadEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                m_gamepadMap.erase(gamepadEvent->GetGamepadNumber());
-
-            m_gamepadMap.insert(std::pair<int, Gamepad>(gamepadEvent->GetGamepadNumber(), Gamepad(gamepadEvent->GetGamepadName())));
-        }
-        else if (gamepadEvent->IsType<GamepadDisconnectedEvent>())
-        {
-            auto iter = m_gamepadMap.find(gamepadEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                m_gamepadMap.erase(gamepadEvent->GetGamepadNumber());
-        }
-
-        if (auto gamepadButtonEvent = gamepadEvent->AsType<GamepadButtonEvent>())
-            OnGamepadButtonEvent(gamepadButtonEvent);
-        else if (auto gamepadAxisMoveEvent = gamepadEvent->AsType<GamepadAxisMoveEvent>())
-            OnGamepadAxisMoveEvent(gamepadAxisMoveEvent);
-        else if (auto gamepadTriggerMoveEvent = gamepadEvent->AsType<GamepadTriggerMoveEvent>())
-            OnGamepadTriggerMoveEvent(gamepadTriggerMoveEvent);
+        return GetSnapshot().WasGamepadButtonReleasedThisFrame(gamepadNumber, gamepadButton);
     }
 
-    void Input::OnGamepadButtonEvent(std::shared_ptr<GamepadButtonEvent> gamepadButtonEvent)
+    const InputSnapshot& Input::GetSnapshot()
     {
-        bool isButtonDown = false;
-        if (gamepadButtonEvent->IsType<GamepadButtonPressEvent>())
-            isButtonDown = true;
+        return m_snapshots[m_snapshotIndex.load(std::memory_order_acquire)];
+    }
 
-        auto pairKey = std::pair<int, int>(gamepadButtonEvent->GetGamepadNumber(), gamepadButtonEvent->GetButtonCode());
-        auto iter = m_gamepadMap.find(gamepadButtonEvent->GetGamepadNumber());
-        if (iter != m_gamepadMap.end())
-            iter->second.SetIsButtonPressed(gamepadButtonEvent->GetButtonCode(), isButtonDown);
+    void Input::UpdateSnapshots()
+    {
+        // the slot written now was published two updates ago, readers of the last two snapshots are not disturbed
+        uint32_t snapshotIndex = m_snapshotIndex.load(std::memory_order_relaxed);
+        uint32_t nextSnapshotIndex = (snapshotIndex + 1) % m_snapshots.size();
+        m_snapshots[nextSnapshotIndex].previous = m_snapshots[snapshotIndex].current;
+        m_snapshots[nextSnapshotIndex].current = m_state;
+        m_snapshotIndex.store(nextSnapshotIndex, std::memory_order_release);
     }
 
-    void Input::OnGamepadAxisMoveEvent(std::shared_ptr<GamepadAxisMoveEvent> gamepadAxisModeEvent)
+    void Input::OnEvent(const Event& event)
     {
-        if (gamepadAxisModeEvent->IsType<GamepadAxisLeftMoveEvent>())
+        switch (event.GetType())
+        {
+        case EventType::KeyPress:
+        case EventType::KeyRepeat:
+        case EventType::KeyRelease:
         {
-            auto iter = m_gamepadMap.find(gamepadAxisModeEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                iter->second.SetAxisLeft(gamepadAxisModeEvent->GetXPos(), gamepadAxisModeEvent->GetYPos());
+            int keyCode = event.AsType<KeyEvent>()->GetKeyCode();
+            if (keyCode >= 0 && keyCode <= FIREFLY_KEY_LAST)
+                m_state.pressedKeys[keyCode] = !event.IsType<KeyReleaseEvent>();
+            break;
         }
-        else if (gamepadAxisModeEvent->IsType<GamepadAxisRightMoveEvent>())
+        case EventType::MouseButtonPress:
+        case EventType::MouseButtonRelease:
         {
-            auto iter = m_gamepadMap.find(gamepadAxisModeEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                iter->second.SetAxisRight(gamepadAxisModeEvent->GetXPos(), gamepadAxisModeEvent->GetYPos());
+            int mouseButton = event.AsType<MouseButtonEvent>()->GetButtonCode();
+            if (mouseButton >= 0 && mouseButton <= FIREFLY_MOUSE_BUTTON_LAST)
+                m_state.pressedMouseButtons[mouseButton] = event.IsType<MouseButtonPressEvent>();
+            break;
         }
-    }
-
-    void Input::OnGamepadTriggerMoveEvent(std::shared_ptr<GamepadTriggerMoveEvent> gamepadTriggerModeEvent)
-    {
-        if (gamepadTriggerModeEvent->IsType<GamepadTriggerLeftMoveEvent>())
+        case EventType::MouseMove:
+        {
+            auto mouseMoveEvent = event.AsType<MouseMoveEvent>();
+            m_state.mousePositionX = mouseMoveEvent->GetXPos();
+            m_state.mousePositionY = mouseMoveEvent->GetYPos();
+            break;
+        }
+        case EventType::GamepadConnected:
+        {
+            // the name is only copied here, the per-frame gamepad state stays free of strings
+            auto connectedEvent = event.AsType<GamepadConnectedEvent>();
+            int gamepadNumber = connectedEvent->GetGamepadNumber();
+            if (gamepadNumber < 0 || gamepadNumber >= FIREFLY_MAX_GAMEPADS)
+                break;
+            m_state.connectedGamepads[gamepadNumber] = true;
+            m_state.gamepads[gamepadNumber] = Gamepad();
+            m_gamepadNames[gamepadNumber] = connectedEvent->GetGamepadName() ? connectedEvent->GetGamepadName() : "";
+            break;
+        }
+        case EventType::GamepadDisconnected:
         {
-            auto iter = m_gamepadMap.find(gamepadTriggerModeEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                iter->second.SetTriggerLeft(gamepadTriggerModeEvent->GetPos());
+            int gamepadNumber = event.AsType<GamepadEvent>()->GetGamepadNumber();
+            if (gamepadNumber >= 0 && gamepadNumber < FIREFLY_MAX_GAMEPADS)
+                m_state.connectedGamepads[gamepadNumber] = false;
+            break;
         }
-        else if (gamepadTriggerModeEvent->IsType<GamepadTriggerRightMoveEvent>())
+        case EventType::GamepadButtonPress:
+        case EventType::GamepadButtonRelease:
         {
-            auto iter = m_gamepadMap.find(gamepadTriggerModeEvent->GetGamepadNumber());
-            if (iter != m_gamepadMap.end())
-                iter->second.SetTriggerRight(gamepadTriggerModeEvent->GetPos());
+            auto buttonEvent = event.AsType<GamepadButtonEvent>();
+            if (Gamepad* gamepad = FindGamepad(buttonEvent->GetGamepadNumber()))
+                gamepad->SetIsButtonPressed(buttonEvent->GetButtonCode(), event.IsType<GamepadButtonPressEvent>());
+            break;
         }
+        case EventType::GamepadAxisLeftMove:
+        case EventType::GamepadAxisRightMove:
+        {
+            auto axisMoveEvent = event.AsType<GamepadAxisMoveEvent>();
+            Gamepad* gamepad = FindGamepad(axisMoveEvent->GetGamepadNumber());
+            if (gamepad && event.IsType<GamepadAxisLeftMoveEvent>())
+                gamepad->SetAxisLeft(axisMoveEvent->GetXPos(), axisMoveEvent->GetYPos());
+            else if (gamepad)
+                gamepad->SetAxisRight(axisMoveEvent->GetXPos(), axisMoveEvent->GetYPos());
+            break;
+        }
+        case EventType::GamepadTriggerLeftMove:
+        case EventType::GamepadTriggerRightMove:
+        {
+            auto triggerMoveEvent = event.AsType<GamepadTriggerMoveEvent>();
+            Gamepad* gamepad = FindGamepad(triggerMoveEvent->GetGamepadNumber());
+            if (gamepad && event.IsType<GamepadTriggerLeftMoveEvent>())
+                gamepad->SetTriggerLeft(triggerMoveEvent->GetPos());
+            else if (gamepad)
+                gamepad->SetTriggerRight(triggerMoveEvent->GetPos());
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    Gamepad* Input::FindGamepad(int gamepadNumber)
+    {
+        if (m_state.IsGamepadConnected(gamepadNumber))
+            return &m_state.gamepads[gamepadNumber];
+        else
+            return nullptr;
     }
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#include "pch.h"
+#include "Input/InputSnapshot.h"
+
+namespace Firefly
+{
+    bool InputState::IsKeyPressed(int keyCode) const
+    {
+        return keyCode >= 0 && keyCode <= FIREFLY_KEY_LAST && pressedKeys[keyCode];
+    }
+
+    bool InputState::IsMouseButtonPressed(int mouseButton) const
+    {
+        return mouseButton >= 0 && mouseButton <= FIREFLY_MOUSE_BUTTON_LAST && pressedMouseButtons[mouseButton];
+    }
+
+    bool InputState::IsGamepadConnected(int gamepadNumber) const
+    {
+        return gamepadNumber >= 0 && gamepadNumber < FIREFLY_MAX_GAMEPADS && connectedGamepads[gamepadNumber];
+    }
+
+    const Gamepad* InputState::GetGamepad(int gamepadNumber) const
+    {
+        return IsGamepadConnected(gamepadNumber) ? &gamepads[gamepadNumber] : nullptr;
+    }
+
+    bool InputSnapshot::WasKeyPressedThisFrame(int keyCode) const
+    {
+        return current.IsKeyPressed(keyCode) && !previous.IsKeyPressed(keyCode);
+    }
+
+    bool InputSnapshot::WasKeyReleasedThisFrame(int keyCode) const
+    {
+        return !current.IsKeyPressed(keyCode) && previous.IsKeyPressed(keyCode);
+    }
+
+    bool InputSnapshot::WasMouseButtonPressedThisFrame(int mouseButton) const
+    {
+        return current.IsMouseButtonPressed(mouseButton) && !previous.IsMouseButtonPressed(mouseButton);
+    }
+
+    bool InputSnapshot::WasMouseButtonReleasedThisFrame(int mouseButton) const
+    {
+        return !current.IsMouseButtonPressed(mouseButton) && previous.IsMouseButtonPressed(mouseButton);
+    }
+
+    bool InputSnapshot::WasGamepadButtonPressedThisFrame(int gamepadNumber, int gamepadButton) const
+    {
+        const Gamepad* currentGamepad = current.GetGamepad(gamepadNumber);
+        const Gamepad* previousGamepad = previous.GetGamepad(gamepadNumber);
+        return currentGamepad && currentGamepad->IsButtonPressed(gamepadButton) && !(previousGamepad && previousGamepad->IsButtonPressed(gamepadButton));
+    }
+
+    bool InputSnapshot::WasGamepadButtonReleasedThisFrame(int gamepadNumber, int gamepadButton) const
+    {
+        const Gamepad* currentGamepad = current.GetGamepad(gamepadNumber);
+        const Gamepad* previousGamepad = previous.GetGamepad(gamepadNumber);
+        return !(currentGamepad && currentGamepad->IsButtonPressed(gamepadButton)) && previousGamepad && previousGamepad->IsButtonPressed(gamepadButton);
+    }
+}
\ No newline at end of file
@@ -93,20 +93,20 @@ namespace Firefly
 
         if (texture->GetMipMapLevels() <= attachment.mipMapLevel)
         {
-            Logger::Warn("FrameBuffer", "Specified mip map level ({0}) for " + attachmentLabel + " is not compatible with the texture.",
+            FIREFLY_LOG_WARN("FrameBuffer", "Specified mip map level ({0}) for " + attachmentLabel + " is not compatible with the texture.",
                 attachment.mipMapLevel);
             attachment.mipMapLevel = texture->GetMipMapLevels() - 1;
         }
 
         if ((texture->GetType() != Texture::Type::TEXTURE_CUBE_MAP) && (attachment.arrayLayer > 0))
         {
-            Logger::Warn("FrameBuffer", "Specified array layer ({0}) for " + attachmentLabel + " is not compatible with the texture.",
+            FIREFLY_LOG_WARN("FrameBuffer", "Specified array layer ({0}) for " + attachmentLabel + " is not compatible with the texture.",
                 attachment.arrayLayer);
             attachment.arrayLayer = 0;
         }
         else if ((texture->GetType() == Texture::Type::TEXTURE_CUBE_MAP) && (attachment.arrayLayer >= 6))
         {
-            Logger::Warn("FrameBuffer", "Specified array layer ({0}) for " + attachmentLabel + " is not compatible with the cube map texture.",
+            FIREFLY_LOG_WARN("FrameBuffer", "Specified array layer ({0}) for " + attachmentLabel + " is not compatible with the cube map texture.",
                 attachment.arrayLayer);
             attachment.arrayLayer = 5;
         }
@@ -8,16 +8,41 @@ namespace Firefly
     void GraphicsContext::Init(std::shared_ptr<Window> window)
     {
         m_window = window;
+        SetSize(m_window->GetWidth(), m_window->GetHeight());
         OnInit(m_window);
     }
 
     uint32_t GraphicsContext::GetWidth() const
     {
-        return m_window->GetWidth();
+        return static_cast<uint32_t>(m_size.load() >> 32);
     }
 
     uint32_t GraphicsContext::GetHeight() const
     {
-        return m_window->GetHeight();
+        return static_cast<uint32_t>(m_size.load());
+    }
+
+    void GraphicsContext::SetSize(uint32_t width, uint32_t height)
+    {
+        m_size = (static_cast<uint64_t>(width) << 32) | height;
+    }
+
+    std::shared_ptr<Window> GraphicsContext::GetWindow() const
+    {
+        return m_window;
+    }
+
+    void GraphicsContext::SetPresentMode(PresentMode presentMode)
+    {
+        if (presentMode == m_presentMode)
+            return;
+
+        m_presentMode = presentMode;
+        OnSetPresentMode(presentMode);
+    }
+
+    GraphicsContext::PresentMode GraphicsContext::GetPresentMode() const
+    {
+        return m_presentMode;
     }
 }
\ No newline at end of file
@@ -1,14 +1,20 @@
 #include "pch.h"
 #include "Rendering/Material.h"
 
+#include "Core/ResourceRegistry.h"
+
 namespace Firefly
 {
+    std::atomic<uint64_t> Material::s_globalVersion = 0;
+
     Material::Material() :
         m_shader(nullptr),
         m_albedo(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)),
         m_roughness(0.0f),
         m_metalness(0.0f),
-        m_heightScale(0.1f)
+        m_heightScale(0.1f),
+        m_useTextures{},
+        m_version(0)
     {
     }
 
@@ -23,9 +29,20 @@ namespace Firefly
         return m_shader;
     }
 
+    uint32_t Material::GetVersion() const
+    {
+        return m_version;
+    }
+
+    uint64_t Material::GetGlobalVersion()
+    {
+        return s_globalVersion.load(std::memory_order_acquire);
+    }
+
     void Material::SetAlbedo(const glm::vec4& albedo)
     {
         m_albedo = albedo;
+        MarkChanged();
     }
 
     glm::vec4 Material::GetAlbedo() const
@@ -36,6 +53,7 @@ namespace Firefly
     void Material::SetRoughness(float roughness)
     {
         m_roughness = roughness;
+        MarkChanged();
     }
 
     float Material::GetRoughness() const
@@ -46,6 +64,7 @@ namespace Firefly
     void Material::SetMetalness(float metalness)
     {
         m_metalness = metalness;
+        MarkChanged();
     }
 
     float Material::GetMetalness() const
@@ -56,6 +75,7 @@ namespace Firefly
     void Material::SetHeightScale(float heightScale)
     {
         m_heightScale = heightScale;
+        MarkChanged();
     }
 
     float Material::GetHeightScale() const
@@ -68,40 +88,72 @@ namespace Firefly
         if (!texture)
             return;
 
-        m_textures[usage] = texture;
-        m_useTextures[usage] = true;
+        m_textures[static_cast<size_t>(usage)] = texture;
+        m_textureHandles[static_cast<size_t>(usage)] = TextureHandle();
+        m_useTextures[static_cast<size_t>(usage)] = true;
+        MarkChanged();
         OnSetTexture(texture, usage);
     }
 
-    std::shared_ptr<Texture> Material::GetTexture(TextureUsage usage)
+    void Material::SetTexture(TextureHandle texture, TextureUsage usage)
     {
-        if (m_textures.find(usage) != m_textures.end())
-            return m_textures[usage];
-        else
-            return nullptr;
+        SetTexture(TextureRegistry::Instance().Retrieve(texture), usage);
+        if (HasTexture(usage))
+            m_textureHandles[static_cast<size_t>(usage)] = texture;
     }
 
-    bool Material::HasTexture(TextureUsage usage)
+    void Material::RefreshTexture(TextureHandle texture)
     {
-        return m_textures.find(usage) != m_textures.end();
+        for (size_t i = 0; i < s_textureUsageCount; i++)
+        {
+            if (m_textureHandles[i] != texture)
+                continue;
+
+            std::shared_ptr<Texture> resource = TextureRegistry::Instance().Retrieve(texture);
+            if (!resource || resource == m_textures[i])
+                continue;
+
+            // disabled textures stay disabled
+            m_textures[i] = resource;
+            MarkChanged();
+            OnSetTexture(resource, static_cast<TextureUsage>(i));
+        }
+    }
+
+    std::shared_ptr<Texture> Material::GetTexture(TextureUsage usage) const
+    {
+        return m_textures[static_cast<size_t>(usage)];
+    }
+
+    bool Material::HasTexture(TextureUsage usage) const
+    {
+        return m_textures[static_cast<size_t>(usage)] != nullptr;
     }
 
     void Material::EnableTexture(bool enable, TextureUsage usage)
     {
-        if (m_textures.find(usage) != m_textures.end())
-            m_useTextures[usage] = enable;
+        if (HasTexture(usage))
+        {
+            m_useTextures[static_cast<size_t>(usage)] = enable;
+            MarkChanged();
+        }
     }
 
-    bool Material::IsTextureEnabled(TextureUsage usage)
+    bool Material::IsTextureEnabled(TextureUsage usage) const
     {
-        if (m_useTextures.find(usage) != m_useTextures.end())
-            return m_useTextures[usage];
-        else
-            return false;
+        return m_useTextures[static_cast<size_t>(usage)];
     }
 
     void Material::ClearTextures()
     {
-        m_textures.clear();
+        m_textures.fill(nullptr);
+        m_textureHandles.fill(TextureHandle());
+        MarkChanged();
+    }
+
+    void Material::MarkChanged()
+    {
+        m_version++;
+        s_globalVersion.fetch_add(1, std::memory_order_release);
     }
 }
\ No newline at end of file
@@ -11,10 +11,13 @@ namespace Firefly
     {
         m_vertexCount = vertices.size();
         m_indexCount = indices.size();
+        m_boundingBox = BoundingBox();
+        for (const auto& vertex : vertices)
+            m_boundingBox.Expand(vertex.position);
         OnInit(vertices, indices);
     }
 
-    void Mesh::Init(const std::string& path, bool flipTexCoords)
+    bool Mesh::ReadFile(const std::string& path, bool flipTexCoords, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
     {
         Assimp::Importer importer;
         auto importFlags = aiProcess_Triangulate | aiProcess_GenNormals | aiProcess_CalcTangentSpace;
@@ -24,64 +27,70 @@ namespace Firefly
 
         if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode)
         {
-            Logger::Error("FireflyEngine", "assimp error: {0}", importer.GetErrorString());
+            FIREFLY_LOG_ERROR("FireflyEngine", "assimp error: {0}", importer.GetErrorString());
+            return false;
         }
-        else
+        if (scene->mNumMeshes != 1)
         {
-            if (scene->mNumMeshes == 1)
-            {
-                aiMesh* mesh = scene->mMeshes[0];
-
-                std::vector<Vertex> vertices;
-                for (int i = 0; i < mesh->mNumVertices; i++)
-                {
-                    Vertex vertex;
-                    vertex.position.x = mesh->mVertices[i].x;
-                    vertex.position.y = mesh->mVertices[i].y;
-                    vertex.position.z = mesh->mVertices[i].z;
-                    vertex.normal.x = mesh->mNormals[i].x;
-                    vertex.normal.y = mesh->mNormals[i].y;
-                    vertex.normal.z = mesh->mNormals[i].z;
-                    if (mesh->mTextureCoords[0])
-                    {
-                        vertex.tangent.x = mesh->mTangents[i].x;
-                        vertex.tangent.y = mesh->mTangents[i].y;
-                        vertex.tangent.z = mesh->mTangents[i].z;
-                        vertex.bitangent.x = mesh->mBitangents[i].x;
-                        vertex.bitangent.y = mesh->mBitangents[i].y;
-                        vertex.bitangent.z = mesh->mBitangents[i].z;
-                        vertex.texCoords.x = mesh->mTextureCoords[0][i].x;
-                        vertex.texCoords.y = mesh->mTextureCoords[0][i].y;
-                    }
-                    else
-                    {
-                        vertex.tangent.x = 1.f;
-                        vertex.tangent.y = 0.f;
-                        vertex.tangent.z = 0.f;
-                        vertex.bitangent.x = 0.f;
-                        vertex.bitangent.y = 1.f;
-                        vertex.bitangent.z = 0.f;
-                        vertex.texCoords.x = 0.f;
-                        vertex.texCoords.y = 0.f;
-                    }
-                    vertices.push_back(vertex);
-                }
+            FIREFLY_LOG_ERROR("FireflyEngine", "assimp error: Only single mesh files are supported!");
+            return false;
+        }
 
-                std::vector<uint32_t> indices;
-                for (int i = 0; i < mesh->mNumFaces; i++)
-                {
-                    aiFace face = mesh->mFaces[i];
-                    for (int j = 0; j < 3; j++)
-                        indices.push_back(face.mIndices[j]);
-                }
+        aiMesh* mesh = scene->mMeshes[0];
 
-                Init(vertices, indices);
+        vertices.clear();
+        vertices.reserve(mesh->mNumVertices);
+        for (int i = 0; i < mesh->mNumVertices; i++)
+        {
+            Vertex vertex;
+            vertex.position.x = mesh->mVertices[i].x;
+            vertex.position.y = mesh->mVertices[i].y;
+            vertex.position.z = mesh->mVertices[i].z;
+            vertex.normal.x = mesh->mNormals[i].x;
+            vertex.normal.y = mesh->mNormals[i].y;
+            vertex.normal.z = mesh->mNormals[i].z;
+            if (mesh->mTextureCoords[0])
+            {
+                vertex.tangent.x = mesh->mTangents[i].x;
+                vertex.tangent.y = mesh->mTangents[i].y;
+                vertex.tangent.z = mesh->mTangents[i].z;
+                vertex.bitangent.x = mesh->mBitangents[i].x;
+                vertex.bitangent.y = mesh->mBitangents[i].y;
+                vertex.bitangent.z = mesh->mBitangents[i].z;
+                vertex.texCoords.x = mesh->mTextureCoords[0][i].x;
+                vertex.texCoords.y = mesh->mTextureCoords[0][i].y;
             }
             else
             {
-                Logger::Error("FireflyEngine", "assimp error: Only single mesh files are supported!");
+                vertex.tangent.x = 1.f;
+                vertex.tangent.y = 0.f;
+                vertex.tangent.z = 0.f;
+                vertex.bitangent.x = 0.f;
+                vertex.bitangent.y = 1.f;
+                vertex.bitangent.z = 0.f;
+                vertex.texCoords.x = 0.f;
+                vertex.texCoords.y = 0.f;
             }
+            vertices.push_back(vertex);
+        }
+
+        indices.clear();
+        indices.reserve(mesh->mNumFaces * 3);
+        for (int i = 0; i < mesh->mNumFaces; i++)
+        {
+            aiFace face = mesh->mFaces[i];
+            for (int j = 0; j < 3; j++)
+                indices.push_back(face.mIndices[j]);
         }
+        return true;
+    }
+
+    void Mesh::Init(const std::string& path, bool flipTexCoords)
+    {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        if (ReadFile(path, flipTexCoords, vertices, indices))
+            Init(vertices, indices);
     }
 
     uint32_t Mesh::GetVertexCount() const
@@ -93,4 +102,9 @@ namespace Firefly
     {
         return m_indexCount;
     }
+
+    const BoundingBox& Mesh::GetBoundingBox() const
+    {
+        return m_boundingBox;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "pch.h"
+#include "Rendering/MipMapGenerator.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FIREFLY_MIPMAP_SSE
+#endif
+
+namespace Firefly
+{
+    // fine enough that the darkest srgb values, where the curve is steepest, still round to the right byte
+    static constexpr uint32_t s_linearToSrgbTableSize = 16384;
+
+    struct ColorSpaceTables
+    {
+        ColorSpaceTables()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                float value = i / 255.0f;
+                unormToFloat[i] = value;
+                srgbToLinear[i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+            }
+
+            for (uint32_t i = 0; i < s_linearToSrgbTableSize; i++)
+            {
+                float value = i / static_cast<float>(s_linearToSrgbTableSize - 1);
+                float srgbValue = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+                linearToSrgb[i] = static_cast<uint8_t>(srgbValue * 255.0f + 0.5f);
+            }
+        }
+
+        float unormToFloat[256];
+        float srgbToLinear[256];
+        uint8_t linearToSrgb[s_linearToSrgbTableSize];
+    };
+
+    static const ColorSpaceTables& GetColorSpaceTables()
+    {
+        static ColorSpaceTables tables;
+        return tables;
+    }
+
+    // 2x2 box filter of rgba pixels
+    static inline void AveragePixels(const float* a, const float* b, const float* c, const float* d, float* average)
+    {
+#ifdef FIREFLY_MIPMAP_SSE
+        __m128 sum = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(a), _mm_loadu_ps(b)), _mm_add_ps(_mm_loadu_ps(c), _mm_loadu_ps(d)));
+        _mm_storeu_ps(average, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+        for (uint32_t i = 0; i < 4; i++)
+            average[i] = (a[i] + b[i] + c[i] + d[i]) * 0.25f;
+#endif
+    }
+
+    uint32_t MipMapGenerator::GenerateMipChain(const Texture::Description& description, std::vector<uint8_t>& pixels)
+    {
+        uint32_t mipMapLevels = Texture::GetMipMapLevelCount(description);
+        if (mipMapLevels == 1 || !IsFormatSupported(description.format) || description.sampleCount != Texture::SampleCount::SAMPLE_1)
+            return 1;
+
+        uint32_t arrayLayers = Texture::GetArrayLayerCount(description);
+        uint32_t bytePerPixel = Texture::GetBytePerPixel(description.format);
+        FIREFLY_ASSERT(pixels.size() == static_cast<size_t>(description.width) * description.height * arrayLayers * bytePerPixel, "Mip chains need the pixels of the first level of all array layers!");
+
+        // sized once up front, the levels read from the pixels while the next level is written
+        size_t chainByteSize = 0;
+        for (uint32_t level = 0; level < mipMapLevels; level++)
+            chainByteSize += static_cast<size_t>(std::max(description.width >> level, 1u)) * std::max(description.height >> level, 1u) * arrayLayers * bytePerPixel;
+        pixels.resize(chainByteSize);
+
+        size_t sourceOffset = 0;
+        for (uint32_t level = 1; level < mipMapLevels; level++)
+        {
+            uint32_t sourceWidth = std::max(description.width >> (level - 1), 1u);
+            uint32_t sourceHeight = std::max(description.height >> (level - 1), 1u);
+            uint32_t width = std::max(description.width >> level, 1u);
+            uint32_t height = std::max(description.height >> level, 1u);
+            size_t sourceLayerByteSize = static_cast<size_t>(sourceWidth) * sourceHeight * bytePerPixel;
+            size_t layerByteSize = static_cast<size_t>(width) * height * bytePerPixel;
+            size_t offset = sourceOffset + sourceLayerByteSize * arrayLayers;
+
+            for (uint32_t layer = 0; layer < arrayLayers; layer++)
+            {
+                const uint8_t* source = pixels.data() + sourceOffset + layer * sourceLayerByteSize;
+                uint8_t* destination = pixels.data() + offset + layer * layerByteSize;
+                if (description.format == Texture::Format::RGBA_32_FLOAT)
+                    DownsampleFloat(reinterpret_cast<const float*>(source), sourceWidth, sourceHeight, reinterpret_cast<float*>(destination), width, height);
+                else
+                    DownsampleUnorm(source, sourceWidth, sourceHeight, destination, width, height, bytePerPixel, IsNonLinearFormat(description.format));
+            }
+
+            sourceOffset = offset;
+        }
+
+        return mipMapLevels;
+    }
+
+    bool MipMapGenerator::IsFormatSupported(Texture::Format format)
+    {
+        switch (format)
+        {
+        case Texture::Format::R_8:
+        case Texture::Format::R_8_NON_LINEAR:
+        case Texture::Format::RG_8:
+        case Texture::Format::RG_8_NON_LINEAR:
+        case Texture::Format::RGBA_8:
+        case Texture::Format::RGBA_8_NON_LINEAR:
+        case Texture::Format::RGBA_32_FLOAT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool MipMapGenerator::IsNonLinearFormat(Texture::Format format)
+    {
+        return format == Texture::Format::R_8_NON_LINEAR || format == Texture::Format::RG_8_NON_LINEAR || format == Texture::Format::RGBA_8_NON_LINEAR;
+    }
+
+    void MipMapGenerator::DownsampleUnorm(const uint8_t* source, uint32_t sourceWidth, uint32_t sourceHeight,
+        uint8_t* destination, uint32_t width, uint32_t height, uint32_t channelCount, bool isNonLinear)
+    {
+        // srgb colors are averaged in linear space, otherwise the lower levels get darker, alpha is always linear
+        const ColorSpaceTables& tables = GetColorSpaceTables();
+        const float* colorTable = isNonLinear ? tables.srgbToLinear : tables.unormToFloat;
+
+        // images with fewer channels leave the rest of the four lanes at zero
+        float decodedPixels[4][4] = {};
+        float average[4];
+        for (uint32_t y = 0; y < height; y++)
+        {
+            // odd sizes clamp to the last row and column
+            const uint8_t* rows[2] = {
+                source + static_cast<size_t>(std::min(2 * y, sourceHeight - 1)) * sourceWidth * channelCount,
+                source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) * sourceWidth * channelCount
+            };
+
+            for (uint32_t x = 0; x < width; x++)
+            {
+                uint32_t columns[2] = { std::min(2 * x, sourceWidth - 1) * channelCount, std::min(2 * x + 1, sourceWidth - 1) * channelCount };
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    const uint8_t* pixel = rows[i / 2] + columns[i % 2];
+                    for (uint32_t channel = 0; channel < channelCount; channel++)
+                        decodedPixels[i][channel] = channel == 3 ? tables.unormToFloat[pixel[channel]] : colorTable[pixel[channel]];
+                }
+                AveragePixels(decodedPixels[0], decodedPixels[1], decodedPixels[2], decodedPixels[3], average);
+
+                uint8_t* pixel = destination + (static_cast<size_t>(y) * width + x) * channelCount;
+                for (uint32_t channel = 0; channel < channelCount; channel++)
+                {
+                    if (isNonLinear && channel != 3)
+                        pixel[channel] = tables.linearToSrgb[static_cast<uint32_t>(average[channel] * (s_linearToSrgbTableSize - 1) + 0.5f)];
+                    else
+                        pixel[channel] = static_cast<uint8_t>(average[channel] * 255.0f + 0.5f);
+                }
+            }
+        }
+    }
+
+    void MipMapGenerator::DownsampleFloat(const float* source, uint32_t sourceWidth, uint32_t sourceHeight,
+        float* destination, uint32_t width, uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const float* row0 = source + static_cast<size_t>(std::min(2 * y, sourceHeight - 1)) * sourceWidth * 4;
+            const float* row1 = source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) * sourceWidth * 4;
+            float* destinationRow = destination + static_cast<size_t>(y) * width * 4;
+            for (uint32_t x = 0; x < width; x++)
+            {
+                uint32_t column0 = std::min(2 * x, sourceWidth - 1) * 4;
+                uint32_t column1 = std::min(2 * x + 1, sourceWidth - 1) * 4;
+                AveragePixels(row0 + column0, row0 + column1, row1 + column0, row1 + column1, destinationRow + x * 4);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -25,7 +25,10 @@ namespace Firefly
         glFrontFace(GL_CCW);
         glCullFace(GL_BACK);
 
-        glfwSwapInterval(1); // 1: vsync, 0: unlimited
+        OnSetPresentMode(m_presentMode);
+
+        // rgtc and bptc are core, only the s3tc formats of BC1 and BC3 are an extension
+        m_isTextureCompressionSupported = IsExtensionSupported("GL_EXT_texture_compression_s3tc");
 
         PrintGpuInfo();
     }
@@ -34,15 +37,41 @@ namespace Firefly
     {
     }
 
+    void OpenGLContext::OnSetPresentMode(PresentMode presentMode)
+    {
+        // OpenGL only knows vsync on or off, mailbox presents unsynchronized as well
+        if (presentMode == PresentMode::Fifo || presentMode == PresentMode::FifoRelaxed)
+            glfwSwapInterval(1);
+        else
+            glfwSwapInterval(0);
+    }
+
     void OpenGLContext::SwapBuffers()
     {
         glfwSwapBuffers(m_glfwWindow);
     }
 
+    bool OpenGLContext::IsTextureCompressionSupported() const
+    {
+        return m_isTextureCompressionSupported;
+    }
+
+    bool OpenGLContext::IsExtensionSupported(const std::string& extension) const
+    {
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; i++)
+        {
+            if (extension == reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i)))
+                return true;
+        }
+        return false;
+    }
+
     void OpenGLContext::PrintGpuInfo()
     {
-        Logger::Info("OpenGL", "API Version: {0}", glGetString(GL_VERSION));
-        Logger::Info("OpenGL", "{0} {1}", glGetString(GL_VENDOR), glGetString(GL_RENDERER));
+        FIREFLY_LOG_INFO("OpenGL", "API Version: {0}", glGetString(GL_VERSION));
+        FIREFLY_LOG_INFO("OpenGL", "{0} {1}", glGetString(GL_VENDOR), glGetString(GL_RENDERER));
     }
 
     void GLAPIENTRY OpenGLContext::DebugMessengerCallback(
@@ -96,10 +125,10 @@ namespace Firefly
         case GL_DEBUG_SEVERITY_LOW:
             break;
         case GL_DEBUG_SEVERITY_MEDIUM:
-            Logger::Warn("OpenGL", outputMessage);
+            FIREFLY_LOG_WARN("OpenGL", outputMessage);
             break;
         case GL_DEBUG_SEVERITY_HIGH:
-            Logger::Error("OpenGL", outputMessage);
+            FIREFLY_LOG_ERROR("OpenGL", outputMessage);
             break;
         }
     }
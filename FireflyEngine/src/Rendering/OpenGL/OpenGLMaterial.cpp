@@ -50,6 +50,12 @@ namespace Firefly
             shader->SetUniform("heightTextureSampler", 5);
             std::dynamic_pointer_cast<OpenGLTexture>(GetTexture(TextureUsage::Height))->Bind(5);
         }
+        // slots 6 to 8 hold the environment maps of the renderer
+        if (IsTextureEnabled(TextureUsage::OcclusionRoughnessMetalness))
+        {
+            shader->SetUniform("occlusionRoughnessMetalnessTextureSampler", 9);
+            std::dynamic_pointer_cast<OpenGLTexture>(GetTexture(TextureUsage::OcclusionRoughnessMetalness))->Bind(9);
+        }
 
         shader->SetUniform("material.albedo", m_albedo);
         shader->SetUniform("material.roughness", m_roughness);
@@ -61,6 +67,7 @@ namespace Firefly
         shader->SetUniform("material.hasMetalnessTexture", (float)IsTextureEnabled(Material::TextureUsage::Metalness));
         shader->SetUniform("material.hasOcclusionTexture", (float)IsTextureEnabled(Material::TextureUsage::Occlusion));
         shader->SetUniform("material.hasHeightTexture", (float)IsTextureEnabled(Material::TextureUsage::Height));
+        shader->SetUniform("material.hasOcclusionRoughnessMetalnessTexture", (float)IsTextureEnabled(Material::TextureUsage::OcclusionRoughnessMetalness));
     }
 
     void OpenGLMaterial::OnInit()
@@ -53,14 +53,17 @@ namespace Firefly
             glDisable(GL_SAMPLE_SHADING);
         }
 
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        GLbitfield clearBitMask = GL_COLOR_BUFFER_BIT;
-        if (m_currentFrameBuffer->HasDepthStencilAttachment() && m_description.isDepthTestingEnabled)
+        if (m_description.isClearingEnabled)
         {
-            glClearDepth(1.0f);
-            clearBitMask |= GL_DEPTH_BUFFER_BIT;
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            GLbitfield clearBitMask = GL_COLOR_BUFFER_BIT;
+            if (m_currentFrameBuffer->HasDepthStencilAttachment() && m_description.isDepthTestingEnabled)
+            {
+                glClearDepth(1.0f);
+                clearBitMask |= GL_DEPTH_BUFFER_BIT;
+            }
+            glClear(clearBitMask);
         }
-        glClear(clearBitMask);
     }
 
     void OpenGLRenderPass::OnEnd()
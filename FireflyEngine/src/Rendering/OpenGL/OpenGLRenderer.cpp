@@ -5,9 +5,6 @@
 #include "Rendering/OpenGL/OpenGLMesh.h"
 #include "Rendering/OpenGL/OpenGLMaterial.h"
 #include "Rendering/OpenGL/OpenGLShader.h"
-#include "Scene/Components/TransformComponent.h"
-#include "Scene/Components/MeshComponent.h"
-#include "Scene/Components/MaterialComponent.h"
 
 #include <stb_image.h>
 
@@ -41,23 +38,20 @@ namespace Firefly
         DestroyRenderPass();
     }
 
-    void OpenGLRenderer::BeginDrawRecording()
+    bool OpenGLRenderer::IsRenderThreadSupported() const
     {
-        m_entities.clear();
+        return false;
     }
 
-    void OpenGLRenderer::RecordDraw(const Entity& entity)
+    void OpenGLRenderer::DrawFrame(const FramePacket& framePacket)
     {
-        if (entity.HasComponents<MeshComponent, MaterialComponent, TransformComponent>())
-            m_entities.push_back(entity);
-    }
-
-    void OpenGLRenderer::EndDrawRecording()
-    {
-    }
+        for (const auto& [objectIndex, objectData] : framePacket.objectDataDeltas)
+        {
+            if (objectIndex >= m_objectData.size())
+                m_objectData.resize(objectIndex + 1);
+            m_objectData[objectIndex] = objectData;
+        }
 
-    void OpenGLRenderer::SubmitDraw(std::shared_ptr<Camera> camera)
-    {
         uint32_t newWindowWidth = m_openGLContext->GetWidth();
         uint32_t newWindowHeight = m_openGLContext->GetHeight();
         if (newWindowWidth == 0 || newWindowHeight == 0)
@@ -74,11 +68,11 @@ namespace Firefly
 
         m_mainRenderPass->Begin(m_mainFrameBuffer);
 
-        for (size_t i = 0; i < m_entities.size(); i++)
+        const SceneData& sceneData = framePacket.sceneData;
+        for (const FrameDraw& draw : framePacket.draws)
         {
-            glm::mat4 modelMatrix = m_entities[i].GetComponent<TransformComponent>().m_transform;
-            std::shared_ptr<OpenGLMesh> mesh = std::dynamic_pointer_cast<OpenGLMesh>(m_entities[i].GetComponent<MeshComponent>().m_mesh);
-            std::shared_ptr<OpenGLMaterial> material = std::dynamic_pointer_cast<OpenGLMaterial>(m_entities[i].GetComponent<MaterialComponent>().m_material);
+            OpenGLMesh* mesh = dynamic_cast<OpenGLMesh*>(draw.mesh);
+            OpenGLMaterial* material = dynamic_cast<OpenGLMaterial*>(draw.material);
             std::shared_ptr<OpenGLShader> shader = std::dynamic_pointer_cast<OpenGLShader>(material->GetShader());
 
             material->Bind();
@@ -92,13 +86,13 @@ namespace Firefly
             shader->SetUniform("brdfLUT", 8);
             m_brdfLUT->Bind(8);
 
-            shader->SetUniform("scene.viewMatrix", camera->GetViewMatrix());
-            shader->SetUniform("scene.projectionMatrix", camera->GetProjectionMatrix());
-            shader->SetUniform("scene.viewProjectionMatrix", camera->GetProjectionMatrix() * camera->GetViewMatrix());
-            shader->SetUniform("scene.cameraPosition", glm::vec4(camera->GetPosition(), 1.0f));
+            shader->SetUniform("scene.viewMatrix", sceneData.viewMatrix);
+            shader->SetUniform("scene.projectionMatrix", sceneData.projectionMatrix);
+            shader->SetUniform("scene.viewProjectionMatrix", sceneData.viewProjectionMatrix);
+            shader->SetUniform("scene.cameraPosition", sceneData.cameraPosition);
 
-            shader->SetUniform("object.modelMatrix", modelMatrix);
-            shader->SetUniform("object.normalMatrix", glm::mat4(glm::transpose(glm::inverse(glm::mat3(modelMatrix)))));
+            shader->SetUniform("object.modelMatrix", m_objectData[draw.objectIndex].modelMatrix);
+            shader->SetUniform("object.normalMatrix", m_objectData[draw.objectIndex].normalMatrix);
 
             mesh->Bind();
 
@@ -107,8 +101,8 @@ namespace Firefly
 
         // RENDER ENVIRONMENT MAP AS BACKGROUND
         m_environmentCubeMapShader->Bind();
-        m_environmentCubeMapShader->SetUniform("view", camera->GetViewMatrix());
-        m_environmentCubeMapShader->SetUniform("projection", camera->GetProjectionMatrix());
+        m_environmentCubeMapShader->SetUniform("view", sceneData.viewMatrix);
+        m_environmentCubeMapShader->SetUniform("projection", sceneData.projectionMatrix);
         m_environmentCubeMapShader->SetUniform("environmentMap", 0);
         m_environmentCubeMap->Bind(0);
 
@@ -130,6 +124,18 @@ namespace Firefly
         glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
 
         m_openGLContext->SwapBuffers();
+        RecordPresent(framePacket);
+
+        // opengl gives no completion signal without a sync object per frame, only the present is timed
+        FrameTiming frameTiming;
+        frameTiming.inputEventTime = framePacket.inputEventTime;
+        frameTiming.presentTime = std::chrono::steady_clock::now();
+        RecordFrameTiming(frameTiming);
+    }
+
+    void OpenGLRenderer::WaitForSubmittedFrames()
+    {
+        glFinish();
     }
 
     void OpenGLRenderer::CreateRenderPass()
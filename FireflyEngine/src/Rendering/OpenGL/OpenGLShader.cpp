@@ -22,6 +22,8 @@ namespace Firefly
             m_shaderModules.push_back(CreateShaderModule(shaderCode.geometry, GL_GEOMETRY_SHADER));
         if (!shaderCode.fragment.empty())
             m_shaderModules.push_back(CreateShaderModule(shaderCode.fragment, GL_FRAGMENT_SHADER));
+        if (!shaderCode.compute.empty())
+            m_shaderModules.push_back(CreateShaderModule(shaderCode.compute, GL_COMPUTE_SHADER));
 
         LinkShaders();
     }
@@ -157,6 +159,9 @@ namespace Firefly
         case GL_FRAGMENT_SHADER:
             shaderName = "fragment";
             break;
+        case GL_COMPUTE_SHADER:
+            shaderName = "compute";
+            break;
         }
 
         return shaderName;
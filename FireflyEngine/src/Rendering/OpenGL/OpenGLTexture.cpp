@@ -1,6 +1,16 @@
 #include "pch.h"
 #include "Rendering/OpenGL/OpenGLTexture.h"
 
+// EXT_texture_compression_s3tc and EXT_texture_sRGB are not part of the core profile the loader was generated for
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
 namespace Firefly
 {
     OpenGLTexture::OpenGLTexture() :
@@ -36,7 +46,7 @@ namespace Firefly
         return m_textureView;
     }
 
-    void OpenGLTexture::OnInit(void* pixelData)
+    void OpenGLTexture::OnInit(void* pixelData, uint32_t pixelDataMipLevels)
     {
         m_baseFormat = ConvertToOpenGLBaseFormat(m_description.format);
         m_internalFormat = ConvertToOpenGLInternalFormat(m_description.format);
@@ -44,25 +54,44 @@ namespace Firefly
         m_sampleCount = ConvertToSampleCountNumber(m_description.sampleCount);
         m_textureType = ConvertToOpenGLTextureType(m_description.type, m_sampleCount);
 
-        CreateTexture(pixelData);
+        CreateTexture(pixelData, pixelDataMipLevels);
         CreateTextureView();
         if (m_description.useSampler)
             CreateSampler();
     }
 
-    void OpenGLTexture::CreateTexture(void* pixelData)
+    void OpenGLTexture::CreateTexture(void* pixelData, uint32_t pixelDataMipLevels)
     {
         bool wasPixelDataInitiallyEmpty = pixelData == nullptr;
         if (wasPixelDataInitiallyEmpty)
             pixelData = malloc(GetTextureByteSize(m_description.width, m_description.height, m_description.type, m_description.format));
 
+        // block compressed levels can not be generated, they are only uploaded as a complete chain
+        bool isCompressed = IsCompressedFormat(m_description.format);
+        FIREFLY_ASSERT(!isCompressed || wasPixelDataInitiallyEmpty || pixelDataMipLevels == m_mipMapLevels, "Block compressed OpenGL textures need pixel data of all {0} mip levels!", m_mipMapLevels);
+
         glCreateTextures(m_textureType, 1, &m_texture);
 
+        // the rows of single and two channel images are tightly packed, the default of four byte rows would skew them
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+        size_t levelOffset = 0;
         switch (m_textureType)
         {
         case GL_TEXTURE_2D:
             glTextureStorage2D(m_texture, m_mipMapLevels, m_internalFormat, m_description.width, m_description.height);
-            glTextureSubImage2D(m_texture, 0, 0, 0, m_description.width, m_description.height, m_baseFormat, m_pixelDataType, pixelData);
+            for (uint32_t level = 0; level < pixelDataMipLevels; level++)
+            {
+                uint32_t levelWidth = std::max(m_description.width >> level, 1u);
+                uint32_t levelHeight = std::max(m_description.height >> level, 1u);
+                size_t levelByteSize = GetTextureByteSize(levelWidth, levelHeight, m_description.type, m_description.format);
+                void* levelPixelData = reinterpret_cast<unsigned char*>(pixelData) + levelOffset;
+                if (isCompressed)
+                    glCompressedTextureSubImage2D(m_texture, level, 0, 0, levelWidth, levelHeight, m_internalFormat, levelByteSize, levelPixelData);
+                else
+                    glTextureSubImage2D(m_texture, level, 0, 0, levelWidth, levelHeight, m_baseFormat, m_pixelDataType, levelPixelData);
+                levelOffset += levelByteSize;
+            }
             break;
         case GL_TEXTURE_2D_MULTISAMPLE:
             glTextureStorage2DMultisample(m_texture, m_sampleCount, m_internalFormat, m_description.width, m_description.height, GL_TRUE);
@@ -70,11 +99,21 @@ namespace Firefly
             break;
         case GL_TEXTURE_CUBE_MAP:
             glTextureStorage2D(m_texture, m_mipMapLevels, m_internalFormat, m_description.width, m_description.height);
-            for (size_t i = 0; i < 6; i++)
+            for (uint32_t level = 0; level < pixelDataMipLevels; level++)
             {
-                uint32_t offset = i * m_description.width * m_description.height * GetBytePerPixel(m_description.format);
-                void* offsetPixelData = (reinterpret_cast<unsigned char*>(pixelData) + offset);
-                glTextureSubImage3D(m_texture, 0, 0, 0, i, m_description.width, m_description.height, 1, m_baseFormat, m_pixelDataType, offsetPixelData);
+                uint32_t levelWidth = std::max(m_description.width >> level, 1u);
+                uint32_t levelHeight = std::max(m_description.height >> level, 1u);
+                size_t faceByteSize = GetImageByteSize(m_description.format, levelWidth, levelHeight);
+                for (size_t i = 0; i < 6; i++)
+                {
+                    size_t offset = levelOffset + i * faceByteSize;
+                    void* offsetPixelData = (reinterpret_cast<unsigned char*>(pixelData) + offset);
+                    if (isCompressed)
+                        glCompressedTextureSubImage3D(m_texture, level, 0, 0, i, levelWidth, levelHeight, 1, m_internalFormat, faceByteSize, offsetPixelData);
+                    else
+                        glTextureSubImage3D(m_texture, level, 0, 0, i, levelWidth, levelHeight, 1, m_baseFormat, m_pixelDataType, offsetPixelData);
+                }
+                levelOffset += GetTextureByteSize(levelWidth, levelHeight, m_description.type, m_description.format);
             }
             break;
         }
@@ -82,7 +121,8 @@ namespace Firefly
         glTextureParameteri(m_texture, GL_TEXTURE_BASE_LEVEL, 0);
         glTextureParameteri(m_texture, GL_TEXTURE_MAX_LEVEL, m_mipMapLevels - 1);
 
-        if (m_description.useSampler && m_description.sampler.isMipMappingEnabled)
+        // a complete chain from the loader already holds the filtered levels
+        if (m_description.useSampler && m_description.sampler.isMipMappingEnabled && pixelDataMipLevels < m_mipMapLevels && !isCompressed)
             glGenerateTextureMipmap(m_texture);
 
         if (wasPixelDataInitiallyEmpty)
@@ -117,7 +157,7 @@ namespace Firefly
 
             if (m_description.sampler.maxAnisotropy > maxAnisotropyLimit)
             {
-                Logger::Warn("OpenGL", "Max. anisotropy ({0}) is bigger than the device limit ({1}).", m_description.sampler.maxAnisotropy, maxAnisotropyLimit);
+                FIREFLY_LOG_WARN("OpenGL", "Max. anisotropy ({0}) is bigger than the device limit ({1}).", m_description.sampler.maxAnisotropy, maxAnisotropyLimit);
                 m_description.sampler.maxAnisotropy = maxAnisotropyLimit;
             }
             maxAnisotropy = m_description.sampler.maxAnisotropy;
@@ -160,21 +200,30 @@ namespace Firefly
         case Format::R_8_NON_LINEAR:
         case Format::R_16_FLOAT:
         case Format::R_32_FLOAT:
+        case Format::BC4_R:
             return GL_RED;
         case Format::RG_8:
         case Format::RG_8_NON_LINEAR:
         case Format::RG_16_FLOAT:
         case Format::RG_32_FLOAT:
+        case Format::BC5_RG:
             return GL_RG;
         case Format::RGB_8:
         case Format::RGB_8_NON_LINEAR:
         case Format::RGB_16_FLOAT:
         case Format::RGB_32_FLOAT:
+        case Format::BC6H_RGB_FLOAT:
             return GL_RGB;
         case Format::RGBA_8:
         case Format::RGBA_8_NON_LINEAR:
         case Format::RGBA_16_FLOAT:
         case Format::RGBA_32_FLOAT:
+        case Format::BC1_RGBA:
+        case Format::BC1_RGBA_NON_LINEAR:
+        case Format::BC3_RGBA:
+        case Format::BC3_RGBA_NON_LINEAR:
+        case Format::BC7_RGBA:
+        case Format::BC7_RGBA_NON_LINEAR:
             return GL_RGBA;
         case Format::DEPTH_32_FLOAT:
             return GL_DEPTH_COMPONENT;
@@ -190,7 +239,7 @@ namespace Firefly
         case Format::R_8:
             return GL_R8;
         case Format::R_8_NON_LINEAR:
-            Logger::Warn("OpenGL", "Non linear format with only 1 component is not supported -> linear format GL_R8 is used instead");
+            FIREFLY_LOG_WARN("OpenGL", "Non linear format with only 1 component is not supported -> linear format GL_R8 is used instead");
             return GL_R8;
         case Format::R_16_FLOAT:
             return GL_R16F;
@@ -199,7 +248,7 @@ namespace Firefly
         case Format::RG_8:
             return GL_RG8;
         case Format::RG_8_NON_LINEAR:
-            Logger::Warn("OpenGL", "Non linear format with only 2 components is not supported -> linear format GL_RG8 is used instead");
+            FIREFLY_LOG_WARN("OpenGL", "Non linear format with only 2 components is not supported -> linear format GL_RG8 is used instead");
             return GL_RG8;
         case Format::RG_16_FLOAT:
             return GL_RG16F;
@@ -221,6 +270,24 @@ namespace Firefly
             return GL_RGBA16F;
         case Format::RGBA_32_FLOAT:
             return GL_RGBA32F;
+        case Format::BC1_RGBA:
+            return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+        case Format::BC1_RGBA_NON_LINEAR:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT;
+        case Format::BC3_RGBA:
+            return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+        case Format::BC3_RGBA_NON_LINEAR:
+            return GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT;
+        case Format::BC4_R:
+            return GL_COMPRESSED_RED_RGTC1;
+        case Format::BC5_RG:
+            return GL_COMPRESSED_RG_RGTC2;
+        case Format::BC6H_RGB_FLOAT:
+            return GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT;
+        case Format::BC7_RGBA:
+            return GL_COMPRESSED_RGBA_BPTC_UNORM;
+        case Format::BC7_RGBA_NON_LINEAR:
+            return GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
         case Format::DEPTH_32_FLOAT:
             return GL_DEPTH_COMPONENT32F;
         case Format::DEPTH_24_STENCIL_8:
@@ -240,6 +307,14 @@ namespace Firefly
         case Format::RGB_8_NON_LINEAR:
         case Format::RGBA_8:
         case Format::RGBA_8_NON_LINEAR:
+        case Format::BC1_RGBA:
+        case Format::BC1_RGBA_NON_LINEAR:
+        case Format::BC3_RGBA:
+        case Format::BC3_RGBA_NON_LINEAR:
+        case Format::BC4_R:
+        case Format::BC5_RG:
+        case Format::BC7_RGBA:
+        case Format::BC7_RGBA_NON_LINEAR:
             return GL_UNSIGNED_BYTE;
         case Format::R_16_FLOAT:
         case Format::RG_16_FLOAT:
@@ -250,6 +325,7 @@ namespace Firefly
         case Format::RG_32_FLOAT:
         case Format::RGB_32_FLOAT:
         case Format::RGBA_32_FLOAT:
+        case Format::BC6H_RGB_FLOAT:
         case Format::DEPTH_32_FLOAT:
             return GL_FLOAT;
         case Format::DEPTH_24_STENCIL_8:
@@ -260,7 +336,7 @@ namespace Firefly
     GLenum OpenGLTexture::ConvertToOpenGLTextureType(Type type, uint32_t sampleCount)
     {
         if (type != Type::TEXTURE_2D && sampleCount > 1)
-            Logger::Warn("OpenGL", "Sample count > 1 is ignored for non TEXTURE_2D types");
+            FIREFLY_LOG_WARN("OpenGL", "Sample count > 1 is ignored for non TEXTURE_2D types");
 
         switch (type)
         {
@@ -327,7 +403,7 @@ namespace Firefly
 
     size_t OpenGLTexture::GetTextureByteSize(uint32_t width, uint32_t height, Type type, Format format)
     {
-        size_t textureSize = width * height * GetBytePerPixel(format);
+        size_t textureSize = GetImageByteSize(format, width, height);
         if (type == Texture::Type::TEXTURE_CUBE_MAP)
             textureSize *= 6;
         return textureSize;
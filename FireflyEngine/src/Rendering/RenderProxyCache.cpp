@@ -0,0 +1,238 @@
+#include "pch.h"
+#include "Rendering/RenderProxyCache.h"
+
+#include "Core/ResourceRegistry.h"
+#include "Scene/Scene.h"
+#include "Scene/Components/TransformComponent.h"
+#include "Scene/Components/MeshComponent.h"
+#include "Scene/Components/MaterialComponent.h"
+
+namespace Firefly
+{
+    RenderProxyCache::RenderProxyCache(std::shared_ptr<Scene> scene) :
+        m_entityRegistry(scene->m_entityRegistry)
+    {
+        m_entityRegistry->on_construct<TransformComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_update<TransformComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_destroy<TransformComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_construct<MeshComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_update<MeshComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_destroy<MeshComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_construct<MaterialComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_update<MaterialComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+        m_entityRegistry->on_destroy<MaterialComponent>().connect<&RenderProxyCache::OnEntityChanged>(*this);
+
+        for (auto entity : m_entityRegistry->view<TransformComponent, MeshComponent, MaterialComponent>())
+            OnEntityChanged(*m_entityRegistry, entity);
+    }
+
+    RenderProxyCache::~RenderProxyCache()
+    {
+        m_entityRegistry->on_construct<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_update<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_construct<MeshComponent>().disconnect(this);
+        m_entityRegistry->on_update<MeshComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<MeshComponent>().disconnect(this);
+        m_entityRegistry->on_construct<MaterialComponent>().disconnect(this);
+        m_entityRegistry->on_update<MaterialComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<MaterialComponent>().disconnect(this);
+    }
+
+    void RenderProxyCache::Update()
+    {
+        // the signals fire before a component is removed, so the entity is only checked now
+        for (auto entity : m_pendingEntities)
+        {
+            bool isRenderable = m_entityRegistry->valid(entity) && m_entityRegistry->has<TransformComponent, MeshComponent, MaterialComponent>(entity);
+            auto proxyIndex = m_proxyIndices.find(entity);
+            if (proxyIndex != m_proxyIndices.end())
+            {
+                if (isRenderable)
+                    WriteProxy(proxyIndex->second, entity);
+                else
+                    RemoveProxy(proxyIndex->second);
+            }
+            else if (isRenderable)
+            {
+                uint32_t newProxyIndex = static_cast<uint32_t>(m_proxies.size());
+                m_proxies.emplace_back();
+                m_proxyChangedFlags.push_back(0);
+                m_proxyIndices[entity] = newProxyIndex;
+                WriteProxy(newProxyIndex, entity);
+            }
+        }
+        m_pendingEntities.clear();
+        m_pendingEntitySet.clear();
+
+        // removals can shrink the array below indices that changed earlier in this update
+        m_changedProxyIndices.erase(std::remove_if(m_changedProxyIndices.begin(), m_changedProxyIndices.end(),
+            [this](uint32_t index) { return index >= m_proxies.size(); }), m_changedProxyIndices.end());
+    }
+
+    void RenderProxyCache::ClearChanges()
+    {
+        for (auto index : m_changedProxyIndices)
+        {
+            if (index < m_proxyChangedFlags.size())
+                m_proxyChangedFlags[index] = 0;
+        }
+        m_changedProxyIndices.clear();
+        m_changedMaterialIndices.clear();
+    }
+
+    void RenderProxyCache::BeginFixedStep()
+    {
+        // the transforms written by the previous step become the current matrices first
+        m_isInterpolationEnabled = true;
+        Update();
+
+        // the last frame drew them interpolated, so they are packed once more at rest
+        for (auto entity : m_movingEntities)
+        {
+            uint32_t proxyIndex = GetProxyIndex(entity);
+            if (proxyIndex == s_invalidIndex)
+                continue;
+
+            m_proxies[proxyIndex].previousModelMatrix = m_proxies[proxyIndex].modelMatrix;
+            MarkProxyChanged(proxyIndex);
+        }
+        m_movingEntities.clear();
+    }
+
+    uint32_t RenderProxyCache::GetProxyIndex(entt::entity entity) const
+    {
+        auto proxyIndex = m_proxyIndices.find(entity);
+        return proxyIndex != m_proxyIndices.end() ? proxyIndex->second : s_invalidIndex;
+    }
+
+    const std::vector<RenderProxy>& RenderProxyCache::GetProxies() const
+    {
+        return m_proxies;
+    }
+
+    const std::vector<uint32_t>& RenderProxyCache::GetChangedProxyIndices() const
+    {
+        return m_changedProxyIndices;
+    }
+
+    const std::unordered_set<entt::entity>& RenderProxyCache::GetMovingEntities() const
+    {
+        return m_movingEntities;
+    }
+
+    const std::vector<MaterialHandle>& RenderProxyCache::GetMaterials() const
+    {
+        return m_materials;
+    }
+
+    const std::vector<uint32_t>& RenderProxyCache::GetChangedMaterialIndices() const
+    {
+        return m_changedMaterialIndices;
+    }
+
+    void RenderProxyCache::OnEntityChanged(entt::registry& registry, entt::entity entity)
+    {
+        if (m_pendingEntitySet.insert(entity).second)
+            m_pendingEntities.push_back(entity);
+    }
+
+    void RenderProxyCache::WriteProxy(uint32_t proxyIndex, entt::entity entity)
+    {
+        auto [transform, mesh, material] = m_entityRegistry->get<TransformComponent, MeshComponent, MaterialComponent>(entity);
+        RenderProxy& proxy = m_proxies[proxyIndex];
+        // a new proxy has nothing to move from
+        bool isNewProxy = proxy.entity == entt::null;
+
+        if (proxy.material != material.m_material)
+        {
+            uint32_t materialIndex = material.m_material ? AcquireMaterialIndex(material.m_material) : 0;
+            if (proxy.material)
+                ReleaseMaterialIndex(proxy.materialIndex);
+            proxy.material = material.m_material;
+            proxy.materialIndex = materialIndex;
+        }
+
+        proxy.entity = entity;
+        proxy.mesh = mesh.m_mesh;
+        proxy.modelMatrix = transform.m_transform;
+        proxy.normalMatrix = transform.m_normalMatrix;
+        if (isNewProxy || !m_isInterpolationEnabled)
+            proxy.previousModelMatrix = proxy.modelMatrix;
+        else if (proxy.previousModelMatrix != proxy.modelMatrix)
+            m_movingEntities.insert(entity);
+        const Mesh* meshResource = MeshRegistry::Instance().Get(mesh.m_mesh);
+        proxy.worldBox = meshResource ? meshResource->GetBoundingBox().Transformed(transform.m_transform) : BoundingBox();
+        MarkProxyChanged(proxyIndex);
+    }
+
+    void RenderProxyCache::RemoveProxy(uint32_t proxyIndex)
+    {
+        if (m_proxies[proxyIndex].material)
+            ReleaseMaterialIndex(m_proxies[proxyIndex].materialIndex);
+        m_proxyIndices.erase(m_proxies[proxyIndex].entity);
+        m_movingEntities.erase(m_proxies[proxyIndex].entity);
+
+        uint32_t lastProxyIndex = static_cast<uint32_t>(m_proxies.size() - 1);
+        if (proxyIndex != lastProxyIndex)
+        {
+            m_proxies[proxyIndex] = std::move(m_proxies[lastProxyIndex]);
+            m_proxyIndices[m_proxies[proxyIndex].entity] = proxyIndex;
+            MarkProxyChanged(proxyIndex);
+        }
+        m_proxies.pop_back();
+        m_proxyChangedFlags.pop_back();
+    }
+
+    void RenderProxyCache::MarkProxyChanged(uint32_t proxyIndex)
+    {
+        if (m_proxyChangedFlags[proxyIndex])
+            return;
+
+        m_proxyChangedFlags[proxyIndex] = 1;
+        m_changedProxyIndices.push_back(proxyIndex);
+    }
+
+    uint32_t RenderProxyCache::AcquireMaterialIndex(MaterialHandle material)
+    {
+        uint32_t slot = material.GetIndex();
+        if (slot >= m_materialIndices.size())
+            m_materialIndices.resize(slot + 1, s_invalidIndex);
+
+        uint32_t materialIndex = m_materialIndices[slot];
+        if (materialIndex != s_invalidIndex && m_materials[materialIndex] == material)
+        {
+            m_materialReferenceCounts[materialIndex]++;
+            return materialIndex;
+        }
+
+        uint32_t newMaterialIndex;
+        if (!m_freeMaterialIndices.empty())
+        {
+            newMaterialIndex = m_freeMaterialIndices.back();
+            m_freeMaterialIndices.pop_back();
+        }
+        else
+        {
+            newMaterialIndex = static_cast<uint32_t>(m_materials.size());
+            m_materials.emplace_back();
+            m_materialReferenceCounts.push_back(0);
+        }
+
+        m_materials[newMaterialIndex] = material;
+        m_materialReferenceCounts[newMaterialIndex] = 1;
+        m_materialIndices[slot] = newMaterialIndex;
+        m_changedMaterialIndices.push_back(newMaterialIndex);
+        return newMaterialIndex;
+    }
+
+    void RenderProxyCache::ReleaseMaterialIndex(uint32_t materialIndex)
+    {
+        if (--m_materialReferenceCounts[materialIndex] > 0)
+            return;
+
+        m_materialIndices[m_materials[materialIndex].GetIndex()] = s_invalidIndex;
+        m_materials[materialIndex] = MaterialHandle();
+        m_freeMaterialIndices.push_back(materialIndex);
+    }
+}
\ No newline at end of file
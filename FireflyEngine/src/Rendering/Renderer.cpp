@@ -0,0 +1,289 @@
+#include "pch.h"
+#include "Rendering/Renderer.h"
+
+#include "Core/ResourceRegistry.h"
+#include "Rendering/RenderingAPI.h"
+#include "Rendering/ResourceLoader.h"
+#include "Scene/Components/TransformComponent.h"
+
+namespace Firefly
+{
+    void Renderer::SetScene(std::shared_ptr<Scene> scene)
+    {
+        m_renderProxies = std::make_unique<RenderProxyCache>(scene);
+        m_materialDataVersions.clear();
+    }
+
+    void Renderer::SetRenderThreadEnabled(bool enabled)
+    {
+        if (enabled == IsRenderThreadEnabled())
+            return;
+
+        if (!enabled)
+        {
+            StopRenderThread();
+            return;
+        }
+
+        if (!IsRenderThreadSupported())
+        {
+            FIREFLY_LOG_WARN("Renderer", "The rendering API does not support a render thread, frames are drawn on the main thread");
+            return;
+        }
+
+        m_isRenderThreadStopRequested = false;
+        m_renderThread = std::thread(&Renderer::RunRenderThread, this);
+    }
+
+    bool Renderer::IsRenderThreadEnabled() const
+    {
+        return m_renderThread.joinable();
+    }
+
+    void Renderer::BeginFixedStep()
+    {
+        FIREFLY_ASSERT(m_renderProxies, "The renderer needs a scene, call SetScene first!");
+        m_renderProxies->BeginFixedStep();
+    }
+
+    void Renderer::BeginDrawRecording(float interpolationAlpha)
+    {
+        FIREFLY_ASSERT(m_renderProxies, "The renderer needs a scene, call SetScene first!");
+        FramePacket& framePacket = m_framePackets[m_recordingPacketIndex];
+        framePacket.draws.clear();
+        framePacket.objectDataDeltas.clear();
+        framePacket.materialDataDeltas.clear();
+
+        // only the proxies that changed since the last frame are packed again
+        m_renderProxies->Update();
+        const std::vector<RenderProxy>& proxies = m_renderProxies->GetProxies();
+        const std::unordered_set<entt::entity>& movingEntities = m_renderProxies->GetMovingEntities();
+        for (uint32_t proxyIndex : m_renderProxies->GetChangedProxyIndices())
+        {
+            if (movingEntities.count(proxies[proxyIndex].entity))
+                continue;
+
+            ObjectData objectData;
+            objectData.modelMatrix = proxies[proxyIndex].modelMatrix;
+            objectData.normalMatrix = proxies[proxyIndex].normalMatrix;
+            framePacket.objectDataDeltas.emplace_back(proxyIndex, objectData);
+        }
+
+        // moving entities are packed every frame, the culling still uses their bounds of the newest step
+        for (auto entity : movingEntities)
+        {
+            uint32_t proxyIndex = m_renderProxies->GetProxyIndex(entity);
+            framePacket.objectDataDeltas.emplace_back(proxyIndex, InterpolateObjectData(proxies[proxyIndex], interpolationAlpha));
+        }
+
+        // slots that got another material are packed right away, the others only when their material changed
+        const std::vector<MaterialHandle>& materials = m_renderProxies->GetMaterials();
+        const MaterialRegistry& materialRegistry = MaterialRegistry::Instance();
+        m_materialDataVersions.resize(materials.size());
+        for (uint32_t materialIndex : m_renderProxies->GetChangedMaterialIndices())
+        {
+            if (const Material* material = materialRegistry.Get(materials[materialIndex]))
+                WriteMaterialData(materialIndex, *material);
+        }
+
+        if (m_materialGlobalVersion != Material::GetGlobalVersion())
+        {
+            m_materialGlobalVersion = Material::GetGlobalVersion();
+            for (size_t i = 0; i < materials.size(); i++)
+            {
+                const Material* material = materialRegistry.Get(materials[i]);
+                if (material && material->GetVersion() != m_materialDataVersions[i])
+                    WriteMaterialData(static_cast<uint32_t>(i), *material);
+            }
+        }
+
+        m_renderProxies->ClearChanges();
+    }
+
+    void Renderer::RecordDraw(const Entity& entity)
+    {
+        uint32_t proxyIndex = m_renderProxies->GetProxyIndex(entity.GetId());
+        if (proxyIndex == RenderProxyCache::s_invalidIndex)
+            return;
+
+        // resources removed from their registry no longer resolve and are skipped
+        const RenderProxy& proxy = m_renderProxies->GetProxies()[proxyIndex];
+        FrameDraw draw;
+        draw.mesh = MeshRegistry::Instance().Get(proxy.mesh);
+        draw.material = MaterialRegistry::Instance().Get(proxy.material);
+        if (!draw.mesh || !draw.material)
+            return;
+
+        draw.materialIndex = proxy.materialIndex;
+        draw.objectIndex = proxyIndex;
+        draw.worldBox = proxy.worldBox;
+        m_framePackets[m_recordingPacketIndex].draws.push_back(draw);
+    }
+
+    void Renderer::EndDrawRecording()
+    {
+    }
+
+    void Renderer::SubmitDraw(std::shared_ptr<Camera> camera)
+    {
+        FramePacket& framePacket = m_framePackets[m_recordingPacketIndex];
+        framePacket.sceneData.viewMatrix = camera->GetViewMatrix();
+        framePacket.sceneData.projectionMatrix = camera->GetProjectionMatrix();
+        framePacket.sceneData.viewProjectionMatrix = camera->GetProjectionMatrix() * camera->GetViewMatrix();
+        framePacket.sceneData.cameraPosition = glm::vec4(camera->GetPosition(), 1.0f);
+        framePacket.inputTime = RenderingAPI::GetContext()->GetWindow()->GetLastEventPollTime();
+        framePacket.inputEventTime = RenderingAPI::GetContext()->GetWindow()->GetNewestInputEventTime();
+
+        if (!IsRenderThreadEnabled())
+        {
+            ResourceLoader::Instance().UploadDecodedResources();
+            DrawFrame(framePacket);
+            return;
+        }
+
+        // the other packet is free again once the render thread finished drawing it
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return !m_isPacketPending; });
+        m_isPacketPending = true;
+        m_recordingPacketIndex = 1 - m_recordingPacketIndex;
+        m_condition.notify_all();
+    }
+
+    void Renderer::SetLowLatencyEnabled(bool enabled)
+    {
+        m_isLowLatencyEnabled = enabled;
+    }
+
+    bool Renderer::IsLowLatencyEnabled() const
+    {
+        return m_isLowLatencyEnabled;
+    }
+
+    void Renderer::WaitForFrameSlot()
+    {
+        if (!m_isLowLatencyEnabled)
+            return;
+
+        // the render thread has to be idle, it would reset the fences that are waited on
+        if (IsRenderThreadEnabled())
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return !m_isPacketPending; });
+        }
+
+        WaitForSubmittedFrames();
+    }
+
+    float Renderer::GetInputToPresentLatency() const
+    {
+        return m_inputToPresentLatency;
+    }
+
+    LatencyPercentiles Renderer::GetInputToPresentPercentiles() const
+    {
+        return m_inputToPresentLatencies.GetPercentiles();
+    }
+
+    LatencyPercentiles Renderer::GetInputToGpuCompletionPercentiles() const
+    {
+        return m_inputToGpuCompletionLatencies.GetPercentiles();
+    }
+
+    void Renderer::ResetLatencyPercentiles()
+    {
+        m_inputToPresentLatencies.Reset();
+        m_inputToGpuCompletionLatencies.Reset();
+    }
+
+    void Renderer::RecordPresent(const FramePacket& framePacket)
+    {
+        std::chrono::duration<float> latency = std::chrono::steady_clock::now() - framePacket.inputTime;
+
+        // exponential moving average over roughly the last 30 frames
+        float averageLatency = m_inputToPresentLatency;
+        if (averageLatency == 0.0f)
+            averageLatency = latency.count();
+        m_inputToPresentLatency = averageLatency + (latency.count() - averageLatency) / 30.0f;
+    }
+
+    void Renderer::RecordFrameTiming(const FrameTiming& frameTiming)
+    {
+        std::chrono::steady_clock::time_point unknownTime;
+        if (frameTiming.inputEventTime == unknownTime)
+            return;
+
+        if (frameTiming.presentTime != unknownTime)
+            m_inputToPresentLatencies.AddSample(std::chrono::duration<float>(frameTiming.presentTime - frameTiming.inputEventTime).count());
+        if (frameTiming.gpuCompletionTime != unknownTime)
+            m_inputToGpuCompletionLatencies.AddSample(std::chrono::duration<float>(frameTiming.gpuCompletionTime - frameTiming.inputEventTime).count());
+    }
+
+    void Renderer::StopRenderThread()
+    {
+        if (!IsRenderThreadEnabled())
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isRenderThreadStopRequested = true;
+            m_condition.notify_all();
+        }
+        m_renderThread.join();
+    }
+
+    void Renderer::RunRenderThread()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            // a pending packet is still drawn when stopping, its deltas must not get lost
+            m_condition.wait(lock, [this]() { return m_isPacketPending || m_isRenderThreadStopRequested; });
+            if (!m_isPacketPending)
+                return;
+
+            const FramePacket& framePacket = m_framePackets[1 - m_recordingPacketIndex];
+            lock.unlock();
+            // uploads submit to the graphics queue, so they run on the thread that owns it
+            ResourceLoader::Instance().UploadDecodedResources();
+            DrawFrame(framePacket);
+            lock.lock();
+
+            m_isPacketPending = false;
+            m_condition.notify_all();
+        }
+    }
+
+    ObjectData Renderer::InterpolateObjectData(const RenderProxy& proxy, float interpolationAlpha)
+    {
+        // the world matrices are decomposed, so rotations are interpolated on the sphere instead of per element
+        TransformComponent previous(proxy.previousModelMatrix);
+        TransformComponent current(proxy.modelMatrix);
+        float alpha = std::clamp(interpolationAlpha, 0.0f, 1.0f);
+
+        ObjectData objectData;
+        objectData.modelMatrix = TransformComponent::ComposeMatrix(
+            glm::mix(previous.m_position, current.m_position, alpha),
+            glm::slerp(previous.m_rotation, current.m_rotation, alpha),
+            glm::mix(previous.m_scale, current.m_scale, alpha));
+        objectData.normalMatrix = TransformComponent::ComputeNormalMatrix(objectData.modelMatrix);
+        return objectData;
+    }
+
+    void Renderer::WriteMaterialData(uint32_t materialIndex, const Material& material)
+    {
+        MaterialData materialData;
+        materialData.albedo = material.GetAlbedo();
+        materialData.roughness = material.GetRoughness();
+        materialData.metalness = material.GetMetalness();
+        materialData.heightScale = material.GetHeightScale();
+        materialData.hasAlbedoTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Albedo);
+        materialData.hasNormalTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Normal);
+        materialData.hasRoughnessTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Roughness);
+        materialData.hasMetalnessTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Metalness);
+        materialData.hasOcclusionTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Occlusion);
+        materialData.hasHeightTexture = (float)material.IsTextureEnabled(Material::TextureUsage::Height);
+        materialData.hasOcclusionRoughnessMetalnessTexture = (float)material.IsTextureEnabled(Material::TextureUsage::OcclusionRoughnessMetalness);
+        m_framePackets[m_recordingPacketIndex].materialDataDeltas.emplace_back(materialIndex, materialData);
+        m_materialDataVersions[materialIndex] = material.GetVersion();
+    }
+}
\ No newline at end of file
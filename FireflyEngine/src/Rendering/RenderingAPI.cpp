@@ -134,7 +134,7 @@ namespace Firefly
         return texture;
     }
 
-    std::shared_ptr<Texture> RenderingAPI::CreateTexture(const Texture::Description& description)
+    std::shared_ptr<Texture> RenderingAPI::CreateTexture(const Texture::Description& description, void* pixelData, uint32_t pixelDataMipLevels)
     {
         std::shared_ptr<Texture> texture;
 
@@ -145,7 +145,7 @@ namespace Firefly
         texture = std::make_shared<VulkanTexture>();
 #endif
 
-        texture->Init(description);
+        texture->Init(description, pixelData, pixelDataMipLevels);
         return texture;
     }
 
@@ -0,0 +1,419 @@
+#include "pch.h"
+#include "Rendering/ResourceLoader.h"
+
+#include "Core/ResourceRegistry.h"
+#include "Rendering/RenderingAPI.h"
+#include "Rendering/MeshGenerator.h"
+#include "Rendering/MipMapGenerator.h"
+#include "Rendering/TextureCompressor.h"
+
+namespace Firefly
+{
+    ResourceLoader& ResourceLoader::Instance()
+    {
+        static ResourceLoader resourceLoader;
+        return resourceLoader;
+    }
+
+    void ResourceLoader::Init()
+    {
+        // half of the cores decode, the others stay free for the frame work on the shared thread pool
+        m_decodeThreadPool = std::make_unique<ThreadPool>(std::max(std::thread::hardware_concurrency() / 2, 1u));
+        m_isDestroyRequested = false;
+
+        m_isTextureCompressionSupported = RenderingAPI::GetContext()->IsTextureCompressionSupported();
+        if (!m_isTextureCompressionSupported)
+        {
+            FIREFLY_LOG_WARN("FireflyEngine", "Block compressed textures are not supported, textures are loaded uncompressed");
+            m_isTextureCompressionEnabled = false;
+        }
+
+        m_placeholderMesh = MeshGenerator::CreateBox();
+
+        // a flat normal for linear textures and mid grey for colors, neutral enough for every texture usage
+        Texture::Description description;
+        description.width = 1;
+        description.height = 1;
+        description.useSampler = true;
+        description.format = Texture::Format::RGBA_8;
+        uint8_t linearPixel[] = { 128, 128, 255, 255 };
+        m_linearPlaceholderTexture = RenderingAPI::CreateTexture(description, linearPixel);
+        description.format = Texture::Format::RGBA_8_NON_LINEAR;
+        uint8_t nonLinearPixel[] = { 128, 128, 128, 255 };
+        m_nonLinearPlaceholderTexture = RenderingAPI::CreateTexture(description, nonLinearPixel);
+        // unoccluded, half rough and not metallic, the flat normal of the linear placeholder would read as metal
+        description.format = Texture::Format::RGBA_8;
+        uint8_t occlusionRoughnessMetalnessPixel[] = { 255, 128, 0, 255 };
+        m_occlusionRoughnessMetalnessPlaceholderTexture = RenderingAPI::CreateTexture(description, occlusionRoughnessMetalnessPixel);
+    }
+
+    void ResourceLoader::Destroy()
+    {
+        m_isDestroyRequested = true;
+        m_decodeThreadPool.reset();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodedMeshes.clear();
+        m_decodedTextures.clear();
+        for (auto& [handle, mesh] : m_uploadedMeshes)
+            mesh->Destroy();
+        m_uploadedMeshes.clear();
+        for (auto& [handle, texture] : m_uploadedTextures)
+            texture->Destroy();
+        m_uploadedTextures.clear();
+
+        // the placeholders are shared between slots, they must not be destroyed once per slot by the registries
+        for (auto handle : m_pendingMeshes)
+            MeshRegistry::Instance().Remove(handle);
+        m_pendingMeshes.clear();
+        for (auto handle : m_pendingTextures)
+            TextureRegistry::Instance().Remove(handle);
+        m_pendingTextures.clear();
+        m_pendingCount = 0;
+
+        m_placeholderMesh->Destroy();
+        m_linearPlaceholderTexture->Destroy();
+        m_nonLinearPlaceholderTexture->Destroy();
+        m_occlusionRoughnessMetalnessPlaceholderTexture->Destroy();
+    }
+
+    MeshHandle ResourceLoader::LoadMeshAsync(const std::string& path, bool flipTexCoords)
+    {
+        MeshHandle handle;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            handle = MeshRegistry::Instance().GetHandle(path);
+            if (handle)
+                return handle;
+
+            handle = MeshRegistry::Instance().Insert(path, m_placeholderMesh);
+            m_pendingMeshes.push_back(handle);
+            m_pendingCount++;
+        }
+
+        m_decodeThreadPool->Submit([this, handle, path, flipTexCoords]()
+            {
+                if (m_isDestroyRequested)
+                    return;
+
+                DecodedMesh decodedMesh;
+                decodedMesh.handle = handle;
+                if (!Mesh::ReadFile(path, flipTexCoords, decodedMesh.vertices, decodedMesh.indices))
+                {
+                    m_pendingCount--;
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_decodedMeshes.push_back(std::move(decodedMesh));
+            });
+        return handle;
+    }
+
+    TextureHandle ResourceLoader::LoadTextureAsync(const std::string& path, bool useLinearColorSpace, Texture::Format compressedFormat, uint32_t channelCount)
+    {
+        std::shared_ptr<Texture> placeholder = useLinearColorSpace ? m_linearPlaceholderTexture : m_nonLinearPlaceholderTexture;
+        return SubmitTextureDecode(path, placeholder, [this, path, useLinearColorSpace, compressedFormat, channelCount](DecodedTexture& decodedTexture)
+            {
+                return DecodeTexture(path, useLinearColorSpace, compressedFormat, channelCount, decodedTexture);
+            });
+    }
+
+    TextureHandle ResourceLoader::LoadTextureAsync(const std::string& path, Material::TextureUsage usage)
+    {
+        bool useLinearColorSpace = usage != Material::TextureUsage::Albedo;
+
+        // the usage decides instead of the file, grey maps are often saved as rgb
+        uint32_t channelCount = 4;
+        switch (usage)
+        {
+        case Material::TextureUsage::Normal:
+            channelCount = 2;
+            break;
+        case Material::TextureUsage::Roughness:
+        case Material::TextureUsage::Metalness:
+        case Material::TextureUsage::Occlusion:
+        case Material::TextureUsage::Height:
+            channelCount = 1;
+            break;
+        default:
+            break;
+        }
+
+        Texture::Format compressedFormat = Texture::Format::NONE;
+        if (m_isTextureCompressionEnabled)
+            compressedFormat = TextureCompressor::SelectFormat(usage, useLinearColorSpace ? Texture::Format::RGBA_8 : Texture::Format::RGBA_8_NON_LINEAR);
+        return LoadTextureAsync(path, useLinearColorSpace, compressedFormat, channelCount);
+    }
+
+    TextureHandle ResourceLoader::LoadOcclusionRoughnessMetalnessAsync(const std::string& occlusionPath, const std::string& roughnessPath, const std::string& metalnessPath)
+    {
+        FIREFLY_ASSERT(!occlusionPath.empty() || !roughnessPath.empty() || !metalnessPath.empty(), "Packing occlusion, roughness and metalness needs at least one image!");
+
+        Texture::Format compressedFormat = Texture::Format::NONE;
+        if (m_isTextureCompressionEnabled)
+            compressedFormat = TextureCompressor::SelectFormat(Material::TextureUsage::OcclusionRoughnessMetalness, Texture::Format::RGBA_8);
+
+        std::array<std::string, 3> paths = { occlusionPath, roughnessPath, metalnessPath };
+        std::string name = occlusionPath + "|" + roughnessPath + "|" + metalnessPath;
+        return SubmitTextureDecode(name, m_occlusionRoughnessMetalnessPlaceholderTexture, [this, paths, compressedFormat](DecodedTexture& decodedTexture)
+            {
+                return DecodeOcclusionRoughnessMetalness(paths, compressedFormat, decodedTexture);
+            });
+    }
+
+    std::vector<TextureHandle> ResourceLoader::LoadTextures(const std::vector<TextureRequest>& requests)
+    {
+        std::vector<TextureHandle> handles(requests.size());
+        std::vector<DecodedTexture> decodedTextures(requests.size());
+        std::vector<uint8_t> isDecoded(requests.size(), 0);
+
+        // one file per chunk, file sizes differ too much to batch them, the calling thread decodes as well
+        ThreadPool::Instance().ParallelFor(requests.size(), 1, [this, &requests, &handles, &decodedTextures, &isDecoded](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    handles[i] = TextureRegistry::Instance().GetHandle(requests[i].path);
+                    if (!handles[i])
+                        isDecoded[i] = DecodeTexture(requests[i].path, requests[i].useLinearColorSpace, requests[i].compressedFormat, requests[i].channelCount, decodedTextures[i]);
+                }
+            });
+
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            if (!isDecoded[i])
+                continue;
+
+            DecodedTexture& decodedTexture = decodedTextures[i];
+            std::shared_ptr<Texture> texture = RenderingAPI::CreateTexture(decodedTexture.description, decodedTexture.pixels.data(), decodedTexture.mipMapLevels);
+            decodedTexture.pixels = {};
+
+            // a path that is requested twice or got loaded meanwhile keeps the texture inserted first
+            std::lock_guard<std::mutex> lock(m_mutex);
+            handles[i] = TextureRegistry::Instance().Insert(requests[i].path, texture);
+            if (TextureRegistry::Instance().Get(handles[i]) != texture.get())
+                texture->Destroy();
+        }
+
+        return handles;
+    }
+
+    void ResourceLoader::SetCpuMipMappingEnabled(bool enabled)
+    {
+        m_isCpuMipMappingEnabled = enabled;
+    }
+
+    bool ResourceLoader::IsCpuMipMappingEnabled() const
+    {
+        return m_isCpuMipMappingEnabled;
+    }
+
+    void ResourceLoader::SetTextureCompressionEnabled(bool enabled)
+    {
+        m_isTextureCompressionEnabled = enabled && m_isTextureCompressionSupported;
+    }
+
+    bool ResourceLoader::IsTextureCompressionEnabled() const
+    {
+        return m_isTextureCompressionEnabled;
+    }
+
+    void ResourceLoader::UploadDecodedResources()
+    {
+        std::vector<DecodedMesh> decodedMeshes;
+        std::vector<DecodedTexture> decodedTextures;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            size_t meshCount = std::min<size_t>(m_decodedMeshes.size(), s_maxUploadsPerFrame);
+            std::move(m_decodedMeshes.end() - meshCount, m_decodedMeshes.end(), std::back_inserter(decodedMeshes));
+            m_decodedMeshes.resize(m_decodedMeshes.size() - meshCount);
+
+            size_t textureCount = std::min<size_t>(m_decodedTextures.size(), s_maxUploadsPerFrame - meshCount);
+            std::move(m_decodedTextures.end() - textureCount, m_decodedTextures.end(), std::back_inserter(decodedTextures));
+            m_decodedTextures.resize(m_decodedTextures.size() - textureCount);
+        }
+        if (decodedMeshes.empty() && decodedTextures.empty())
+            return;
+
+        std::vector<std::pair<MeshHandle, std::shared_ptr<Mesh>>> uploadedMeshes;
+        for (auto& decodedMesh : decodedMeshes)
+            uploadedMeshes.emplace_back(decodedMesh.handle, RenderingAPI::CreateMesh(std::move(decodedMesh.vertices), std::move(decodedMesh.indices)));
+
+        std::vector<std::pair<TextureHandle, std::shared_ptr<Texture>>> uploadedTextures;
+        for (auto& decodedTexture : decodedTextures)
+            uploadedTextures.emplace_back(decodedTexture.handle, RenderingAPI::CreateTexture(decodedTexture.description, decodedTexture.pixels.data(), decodedTexture.mipMapLevels));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_uploadedMeshes.insert(m_uploadedMeshes.end(), uploadedMeshes.begin(), uploadedMeshes.end());
+        m_uploadedTextures.insert(m_uploadedTextures.end(), uploadedTextures.begin(), uploadedTextures.end());
+    }
+
+    void ResourceLoader::Update()
+    {
+        m_replacedMeshes.clear();
+
+        std::vector<std::pair<MeshHandle, std::shared_ptr<Mesh>>> uploadedMeshes;
+        std::vector<std::pair<TextureHandle, std::shared_ptr<Texture>>> uploadedTextures;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_uploadedMeshes.empty() && m_uploadedTextures.empty())
+                return;
+
+            std::swap(uploadedMeshes, m_uploadedMeshes);
+            std::swap(uploadedTextures, m_uploadedTextures);
+            for (auto& [handle, mesh] : uploadedMeshes)
+                RemovePending(handle);
+            for (auto& [handle, texture] : uploadedTextures)
+                RemovePending(handle);
+        }
+
+        // a slot that was removed while its file loaded has no one left to draw the resource
+        for (auto& [handle, mesh] : uploadedMeshes)
+        {
+            if (MeshRegistry::Instance().Replace(handle, mesh))
+                m_replacedMeshes.push_back(handle);
+            else
+                mesh->Destroy();
+            m_pendingCount--;
+        }
+
+        std::vector<TextureHandle> replacedTextures;
+        for (auto& [handle, texture] : uploadedTextures)
+        {
+            if (TextureRegistry::Instance().Replace(handle, texture))
+                replacedTextures.push_back(handle);
+            else
+                texture->Destroy();
+            m_pendingCount--;
+        }
+
+        if (!replacedTextures.empty())
+        {
+            MaterialRegistry::Instance().Each([&replacedTextures](MaterialHandle materialHandle, const std::shared_ptr<Material>& material)
+                {
+                    for (auto textureHandle : replacedTextures)
+                        material->RefreshTexture(textureHandle);
+                });
+        }
+    }
+
+    const std::vector<MeshHandle>& ResourceLoader::GetReplacedMeshes() const
+    {
+        return m_replacedMeshes;
+    }
+
+    uint32_t ResourceLoader::GetPendingCount() const
+    {
+        return m_pendingCount;
+    }
+
+    TextureHandle ResourceLoader::SubmitTextureDecode(const std::string& name, std::shared_ptr<Texture> placeholder, std::function<bool(DecodedTexture&)> decode)
+    {
+        TextureHandle handle;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            handle = TextureRegistry::Instance().GetHandle(name);
+            if (handle)
+                return handle;
+
+            handle = TextureRegistry::Instance().Insert(name, placeholder);
+            m_pendingTextures.push_back(handle);
+            m_pendingCount++;
+        }
+
+        m_decodeThreadPool->Submit([this, handle, decode = std::move(decode)]()
+            {
+                if (m_isDestroyRequested)
+                    return;
+
+                DecodedTexture decodedTexture;
+                decodedTexture.handle = handle;
+                if (!decode(decodedTexture))
+                {
+                    m_pendingCount--;
+                    return;
+                }
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_decodedTextures.push_back(std::move(decodedTexture));
+            });
+        return handle;
+    }
+
+    bool ResourceLoader::DecodeTexture(const std::string& path, bool useLinearColorSpace, Texture::Format compressedFormat, uint32_t channelCount, DecodedTexture& decodedTexture) const
+    {
+        if (!Texture::ReadImage(path, useLinearColorSpace, decodedTexture.description, decodedTexture.pixels, channelCount))
+            return false;
+
+        PrepareDecodedTexture(path, compressedFormat, decodedTexture);
+        return true;
+    }
+
+    bool ResourceLoader::DecodeOcclusionRoughnessMetalness(const std::array<std::string, 3>& paths, Texture::Format compressedFormat, DecodedTexture& decodedTexture) const
+    {
+        // the values of missing maps, occlusion and roughness are sampled as they are and metalness is off
+        static constexpr uint8_t fallbackValues[3] = { 255, 255, 0 };
+
+        std::array<std::vector<uint8_t>, 3> channels;
+        Texture::Description& description = decodedTexture.description;
+        bool hasDescription = false;
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            if (paths[i].empty())
+                continue;
+
+            Texture::Description channelDescription;
+            if (!Texture::ReadImage(paths[i], true, channelDescription, channels[i], 1))
+                return false;
+
+            if (!hasDescription)
+            {
+                description = channelDescription;
+                hasDescription = true;
+            }
+            else if (channelDescription.width != description.width || channelDescription.height != description.height)
+            {
+                FIREFLY_LOG_ERROR("FireflyEngine", "Image {0} is {1}x{2}, the other packed images are {3}x{4}", paths[i], channelDescription.width, channelDescription.height, description.width, description.height);
+                return false;
+            }
+        }
+
+        size_t pixelCount = static_cast<size_t>(description.width) * description.height;
+        description.format = Texture::Format::RGBA_8;
+        decodedTexture.pixels.resize(pixelCount * 4);
+        for (uint32_t channel = 0; channel < 3; channel++)
+        {
+            const std::vector<uint8_t>& values = channels[channel];
+            for (size_t i = 0; i < pixelCount; i++)
+                decodedTexture.pixels[i * 4 + channel] = values.empty() ? fallbackValues[channel] : values[i];
+        }
+        for (size_t i = 0; i < pixelCount; i++)
+            decodedTexture.pixels[i * 4 + 3] = 255;
+
+        PrepareDecodedTexture(paths[0] + "|" + paths[1] + "|" + paths[2], compressedFormat, decodedTexture);
+        return true;
+    }
+
+    void ResourceLoader::PrepareDecodedTexture(const std::string& name, Texture::Format compressedFormat, DecodedTexture& decodedTexture) const
+    {
+        // compressed levels can not be generated by the gpu, they need the chain even without cpu mip mapping, explicitly
+        // requested formats are dropped as well when the gpu can not sample them
+        bool isCompressionRequested = compressedFormat != Texture::Format::NONE && m_isTextureCompressionSupported;
+        if (m_isCpuMipMappingEnabled || isCompressionRequested)
+            decodedTexture.mipMapLevels = MipMapGenerator::GenerateMipChain(decodedTexture.description, decodedTexture.pixels);
+
+        // e.g. hdr images keep their float pixels
+        if (isCompressionRequested && !TextureCompressor::Compress(decodedTexture.description, decodedTexture.pixels, decodedTexture.mipMapLevels, compressedFormat))
+            FIREFLY_LOG_WARN("FireflyEngine", "Image {0} can not be compressed to {1}, it stays {2}", name, Texture::ConvertFormatToString(compressedFormat), Texture::ConvertFormatToString(decodedTexture.description.format));
+    }
+
+    void ResourceLoader::RemovePending(MeshHandle handle)
+    {
+        m_pendingMeshes.erase(std::remove(m_pendingMeshes.begin(), m_pendingMeshes.end(), handle), m_pendingMeshes.end());
+    }
+
+    void ResourceLoader::RemovePending(TextureHandle handle)
+    {
+        m_pendingTextures.erase(std::remove(m_pendingTextures.begin(), m_pendingTextures.end(), handle), m_pendingTextures.end());
+    }
+}
\ No newline at end of file
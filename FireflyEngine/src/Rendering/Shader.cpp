@@ -23,7 +23,7 @@ namespace Firefly
         std::ifstream file(path, std::ios::ate | std::ios::binary);
         if (!file.is_open())
         {
-            Logger::Error("FireflyEngine", "Failed to open shader file: {0}!", path);
+            FIREFLY_LOG_ERROR("FireflyEngine", "Failed to open shader file: {0}!", path);
             return shaderCode;
         }
 
@@ -0,0 +1,366 @@
+#include "pch.h"
+#include "Rendering/SoftwareOcclusionCuller.h"
+
+#include "Core/ThreadPool.h"
+
+#include <emmintrin.h>
+
+namespace Firefly
+{
+    static constexpr float s_minClipW = 1e-5f;
+
+    std::shared_ptr<OccluderMesh> OccluderMesh::CreateBox(const BoundingBox& box)
+    {
+        std::shared_ptr<OccluderMesh> occluderMesh = std::make_shared<OccluderMesh>();
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            occluderMesh->m_positions.push_back(glm::vec3(
+                (i & 1) ? box.m_max.x : box.m_min.x,
+                (i & 2) ? box.m_max.y : box.m_min.y,
+                (i & 4) ? box.m_max.z : box.m_min.z));
+        }
+        occluderMesh->m_indices = {
+            0, 2, 6, 0, 6, 4,
+            1, 5, 7, 1, 7, 3,
+            0, 4, 5, 0, 5, 1,
+            2, 3, 7, 2, 7, 6,
+            0, 1, 3, 0, 3, 2,
+            4, 6, 7, 4, 7, 5 };
+        return occluderMesh;
+    }
+
+    SoftwareOcclusionCuller::SoftwareOcclusionCuller(uint32_t width, uint32_t height)
+    {
+        SetResolution(width, height);
+        BeginFrame(glm::mat4(1.f));
+    }
+
+    void SoftwareOcclusionCuller::SetResolution(uint32_t width, uint32_t height)
+    {
+        m_tileCountX = std::max((width + s_tileWidth - 1) / s_tileWidth, 1u);
+        m_tileCountY = std::max((height + s_tileHeight - 1) / s_tileHeight, 1u);
+        m_width = m_tileCountX * s_tileWidth;
+        m_height = m_tileCountY * s_tileHeight;
+        m_tiles.resize(m_tileCountX * m_tileCountY);
+    }
+
+    void SoftwareOcclusionCuller::BeginFrame(const glm::mat4& viewProjection)
+    {
+        m_viewProjection = viewProjection;
+        m_occluders.clear();
+        for (auto& tile : m_tiles)
+        {
+            tile.zMax0 = std::numeric_limits<float>::max();
+            tile.zMax1 = 0.f;
+            tile.mask = 0;
+        }
+    }
+
+    void SoftwareOcclusionCuller::AddOccluder(std::shared_ptr<OccluderMesh> occluderMesh, const glm::mat4& transform)
+    {
+        if (occluderMesh && !occluderMesh->m_indices.empty())
+            m_occluders.push_back({ occluderMesh, transform });
+    }
+
+    void SoftwareOcclusionCuller::RasterizeOccluders()
+    {
+        m_vertexOffsets.resize(m_occluders.size() + 1);
+        m_triangleOffsets.resize(m_occluders.size() + 1);
+        m_vertexOffsets[0] = 0;
+        m_triangleOffsets[0] = 0;
+        for (size_t i = 0; i < m_occluders.size(); i++)
+        {
+            m_vertexOffsets[i + 1] = m_vertexOffsets[i] + m_occluders[i].mesh->m_positions.size();
+            m_triangleOffsets[i + 1] = m_triangleOffsets[i] + m_occluders[i].mesh->m_indices.size() / 3;
+        }
+        m_screenVertices.resize(m_vertexOffsets.back());
+        m_triangles.resize(m_triangleOffsets.back());
+
+        ThreadPool& threadPool = ThreadPool::Instance();
+        threadPool.ParallelFor(m_occluders.size(), 16, [this](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    TransformOccluder(i);
+                    SetupTriangles(i);
+                }
+            });
+
+        // every thread owns a band of tile rows, so tiles are never shared between threads
+        uint32_t bandCount = std::min(m_tileCountY, 2 * (threadPool.GetThreadCount() + 1));
+        uint32_t bandTileCountY = (m_tileCountY + bandCount - 1) / bandCount;
+        threadPool.ParallelFor(m_tileCountY, bandTileCountY, [this](size_t begin, size_t end)
+            {
+                int32_t minTileY = static_cast<int32_t>(begin);
+                int32_t maxTileY = static_cast<int32_t>(end) - 1;
+                for (const auto& triangle : m_triangles)
+                {
+                    if (triangle.minTileX > triangle.maxTileX || triangle.minTileY > maxTileY || triangle.maxTileY < minTileY)
+                        continue;
+                    RasterizeTriangle(triangle, std::max(triangle.minTileY, minTileY), std::min(triangle.maxTileY, maxTileY));
+                }
+            });
+    }
+
+    bool SoftwareOcclusionCuller::IsVisible(const BoundingBox& box) const
+    {
+        glm::vec2 screenMin = glm::vec2(std::numeric_limits<float>::max());
+        glm::vec2 screenMax = glm::vec2(-std::numeric_limits<float>::max());
+        float zMin = std::numeric_limits<float>::max();
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            glm::vec4 corner = glm::vec4(
+                (i & 1) ? box.m_max.x : box.m_min.x,
+                (i & 2) ? box.m_max.y : box.m_min.y,
+                (i & 4) ? box.m_max.z : box.m_min.z, 1.f);
+            glm::vec4 clip = m_viewProjection * corner;
+
+            // boxes that reach behind the camera are always treated as visible
+            if (clip.w <= s_minClipW)
+                return true;
+
+            glm::vec2 screen = glm::vec2((clip.x / clip.w * 0.5f + 0.5f) * m_width, (clip.y / clip.w * 0.5f + 0.5f) * m_height);
+            screenMin = glm::min(screenMin, screen);
+            screenMax = glm::max(screenMax, screen);
+            zMin = std::min(zMin, clip.z / clip.w);
+        }
+
+        if (screenMax.x < 0.f || screenMax.y < 0.f || screenMin.x >= m_width || screenMin.y >= m_height)
+            return false;
+
+        int32_t minX = static_cast<int32_t>(std::max(screenMin.x, 0.f));
+        int32_t minY = static_cast<int32_t>(std::max(screenMin.y, 0.f));
+        int32_t maxX = static_cast<int32_t>(std::min(screenMax.x, m_width - 1.f));
+        int32_t maxY = static_cast<int32_t>(std::min(screenMax.y, m_height - 1.f));
+
+        for (int32_t tileY = minY / s_tileHeight; tileY <= maxY / static_cast<int32_t>(s_tileHeight); tileY++)
+        {
+            int32_t rowBegin = std::max(minY - tileY * static_cast<int32_t>(s_tileHeight), 0);
+            int32_t rowEnd = std::min(maxY - tileY * static_cast<int32_t>(s_tileHeight), static_cast<int32_t>(s_tileHeight) - 1);
+
+            for (int32_t tileX = minX / s_tileWidth; tileX <= maxX / static_cast<int32_t>(s_tileWidth); tileX++)
+            {
+                const Tile& tile = m_tiles[tileY * m_tileCountX + tileX];
+                if (zMin > tile.zMax0)
+                    continue;
+
+                int32_t columnBegin = std::max(minX - tileX * static_cast<int32_t>(s_tileWidth), 0);
+                int32_t columnEnd = std::min(maxX - tileX * static_cast<int32_t>(s_tileWidth), static_cast<int32_t>(s_tileWidth) - 1);
+                uint32_t rowMask = ((1u << (columnEnd - columnBegin + 1)) - 1) << columnBegin;
+                uint32_t rectMask = 0;
+                for (int32_t row = rowBegin; row <= rowEnd; row++)
+                    rectMask |= rowMask << (row * s_tileWidth);
+
+                // the covered pixels all lie in the working layer
+                if ((rectMask & ~tile.mask) == 0 && zMin > tile.zMax1)
+                    continue;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void SoftwareOcclusionCuller::FilterVisible(std::vector<entt::entity>& entities, const SceneSpatialIndex& spatialIndex)
+    {
+        m_visibility.resize(entities.size());
+        ThreadPool::Instance().ParallelFor(entities.size(), 256, [this, &entities, &spatialIndex](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; i++)
+                {
+                    BoundingBox box;
+                    m_visibility[i] = !spatialIndex.GetBoundingBox(entities[i], box) || IsVisible(box);
+                }
+            });
+
+        size_t visibleCount = 0;
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            if (m_visibility[i])
+                entities[visibleCount++] = entities[i];
+        }
+        entities.resize(visibleCount);
+    }
+
+    void SoftwareOcclusionCuller::GetDepthBuffer(std::vector<float>& depthBuffer) const
+    {
+        depthBuffer.resize(m_width * m_height);
+        for (uint32_t y = 0; y < m_height; y++)
+        {
+            for (uint32_t x = 0; x < m_width; x++)
+            {
+                const Tile& tile = m_tiles[(y / s_tileHeight) * m_tileCountX + x / s_tileWidth];
+                uint32_t bit = (y % s_tileHeight) * s_tileWidth + x % s_tileWidth;
+                depthBuffer[y * m_width + x] = (tile.mask >> bit) & 1 ? tile.zMax1 : tile.zMax0;
+            }
+        }
+    }
+
+    uint32_t SoftwareOcclusionCuller::GetWidth() const
+    {
+        return m_width;
+    }
+
+    uint32_t SoftwareOcclusionCuller::GetHeight() const
+    {
+        return m_height;
+    }
+
+    void SoftwareOcclusionCuller::TransformOccluder(size_t occluderIndex)
+    {
+        const Occluder& occluder = m_occluders[occluderIndex];
+        glm::mat4 modelViewProjection = m_viewProjection * occluder.transform;
+
+        glm::vec4* screenVertices = &m_screenVertices[m_vertexOffsets[occluderIndex]];
+        for (size_t i = 0; i < occluder.mesh->m_positions.size(); i++)
+        {
+            glm::vec4 clip = modelViewProjection * glm::vec4(occluder.mesh->m_positions[i], 1.f);
+            if (clip.w <= s_minClipW)
+            {
+                screenVertices[i] = glm::vec4(0.f);
+                continue;
+            }
+
+            screenVertices[i] = glm::vec4(
+                (clip.x / clip.w * 0.5f + 0.5f) * m_width,
+                (clip.y / clip.w * 0.5f + 0.5f) * m_height,
+                clip.z / clip.w,
+                clip.w);
+        }
+    }
+
+    void SoftwareOcclusionCuller::SetupTriangles(size_t occluderIndex)
+    {
+        const Occluder& occluder = m_occluders[occluderIndex];
+        const glm::vec4* screenVertices = &m_screenVertices[m_vertexOffsets[occluderIndex]];
+        Triangle* triangles = &m_triangles[m_triangleOffsets[occluderIndex]];
+
+        for (size_t i = 0; i < occluder.mesh->m_indices.size() / 3; i++)
+        {
+            Triangle& triangle = triangles[i];
+            triangle.minTileX = 1;
+            triangle.maxTileX = 0;
+
+            glm::vec4 v0 = screenVertices[occluder.mesh->m_indices[i * 3 + 0]];
+            glm::vec4 v1 = screenVertices[occluder.mesh->m_indices[i * 3 + 1]];
+            glm::vec4 v2 = screenVertices[occluder.mesh->m_indices[i * 3 + 2]];
+
+            // triangles crossing the near plane are skipped, leaving out an occluder is always conservative
+            if (v0.w <= s_minClipW || v1.w <= s_minClipW || v2.w <= s_minClipW)
+                continue;
+
+            float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+            if (std::abs(area) < 1e-6f)
+                continue;
+            if (area < 0.f)
+            {
+                std::swap(v1, v2);
+                area = -area;
+            }
+
+            glm::vec2 screenMin = glm::min(glm::min(glm::vec2(v0), glm::vec2(v1)), glm::vec2(v2));
+            glm::vec2 screenMax = glm::max(glm::max(glm::vec2(v0), glm::vec2(v1)), glm::vec2(v2));
+            if (screenMax.x < 0.f || screenMax.y < 0.f || screenMin.x >= m_width || screenMin.y >= m_height)
+                continue;
+
+            // edge functions are positive on the inner side of a counter clockwise triangle
+            triangle.edgeA = glm::vec3(v0.y - v1.y, v1.y - v2.y, v2.y - v0.y);
+            triangle.edgeB = glm::vec3(v1.x - v0.x, v2.x - v1.x, v0.x - v2.x);
+            triangle.edgeC = glm::vec3(
+                -(triangle.edgeA.x * v0.x + triangle.edgeB.x * v0.y),
+                -(triangle.edgeA.y * v1.x + triangle.edgeB.y * v1.y),
+                -(triangle.edgeA.z * v2.x + triangle.edgeB.z * v2.y));
+
+            float depthSlopeX = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+            float depthSlopeY = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+            triangle.depthPlane = glm::vec3(depthSlopeX, depthSlopeY, v0.z - depthSlopeX * v0.x - depthSlopeY * v0.y);
+            triangle.zMax = std::max(std::max(v0.z, v1.z), v2.z);
+
+            triangle.minTileX = static_cast<int32_t>(std::max(screenMin.x, 0.f)) / s_tileWidth;
+            triangle.minTileY = static_cast<int32_t>(std::max(screenMin.y, 0.f)) / s_tileHeight;
+            triangle.maxTileX = static_cast<int32_t>(std::min(screenMax.x, m_width - 1.f)) / s_tileWidth;
+            triangle.maxTileY = static_cast<int32_t>(std::min(screenMax.y, m_height - 1.f)) / s_tileHeight;
+        }
+    }
+
+    void SoftwareOcclusionCuller::RasterizeTriangle(const Triangle& triangle, int32_t minTileY, int32_t maxTileY)
+    {
+        const __m128 columnOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 edgeA[3] = { _mm_set1_ps(triangle.edgeA.x), _mm_set1_ps(triangle.edgeA.y), _mm_set1_ps(triangle.edgeA.z) };
+
+        for (int32_t tileY = minTileY; tileY <= maxTileY; tileY++)
+        {
+            for (int32_t tileX = triangle.minTileX; tileX <= triangle.maxTileX; tileX++)
+            {
+                float tileLeft = static_cast<float>(tileX * s_tileWidth);
+                float tileBottom = static_cast<float>(tileY * s_tileHeight);
+
+                // trivial reject and accept with the edge values at the outermost pixel centers of the tile
+                bool isFullyCovered = true;
+                bool isOutside = false;
+                for (int32_t edge = 0; edge < 3; edge++)
+                {
+                    float value = triangle.edgeA[edge] * (tileLeft + 0.5f) + triangle.edgeB[edge] * (tileBottom + 0.5f) + triangle.edgeC[edge];
+                    float stepX = triangle.edgeA[edge] * (s_tileWidth - 1);
+                    float stepY = triangle.edgeB[edge] * (s_tileHeight - 1);
+                    float maxValue = value + std::max(stepX, 0.f) + std::max(stepY, 0.f);
+                    float minValue = value + std::min(stepX, 0.f) + std::min(stepY, 0.f);
+                    isOutside |= maxValue < 0.f;
+                    isFullyCovered &= minValue >= 0.f;
+                }
+                if (isOutside)
+                    continue;
+
+                uint32_t coverage = ~0u;
+                if (!isFullyCovered)
+                {
+                    coverage = 0;
+                    for (uint32_t row = 0; row < s_tileHeight; row++)
+                    {
+                        float y = tileBottom + row + 0.5f;
+                        __m128 rowValue[3];
+                        for (int32_t edge = 0; edge < 3; edge++)
+                            rowValue[edge] = _mm_set1_ps(triangle.edgeB[edge] * y + triangle.edgeC[edge]);
+
+                        for (uint32_t column = 0; column < s_tileWidth; column += 4)
+                        {
+                            __m128 x = _mm_add_ps(_mm_set1_ps(tileLeft + column), columnOffsets);
+                            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[0], x), rowValue[0]), zero);
+                            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[1], x), rowValue[1]), zero));
+                            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA[2], x), rowValue[2]), zero));
+                            coverage |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << (row * s_tileWidth + column);
+                        }
+                    }
+                }
+
+                // conservative depth of the triangle in this tile: the depth plane maximum over the tile corners
+                float zTile = triangle.depthPlane.x * tileLeft + triangle.depthPlane.y * tileBottom + triangle.depthPlane.z +
+                    std::max(triangle.depthPlane.x * s_tileWidth, 0.f) + std::max(triangle.depthPlane.y * s_tileHeight, 0.f);
+                UpdateTile(m_tiles[tileY * m_tileCountX + tileX], coverage, std::min(zTile, triangle.zMax));
+            }
+        }
+    }
+
+    void SoftwareOcclusionCuller::UpdateTile(Tile& tile, uint32_t coverage, float zTriangle)
+    {
+        if (coverage == 0 || zTriangle >= tile.zMax0)
+            return;
+
+        // drop the working layer when the triangle is much closer to the camera than the working layer
+        if (tile.mask != 0 && tile.zMax1 - zTriangle > tile.zMax0 - tile.zMax1)
+            tile.mask = 0;
+
+        tile.zMax1 = tile.mask == 0 ? zTriangle : std::max(tile.zMax1, zTriangle);
+        tile.mask |= coverage;
+
+        // a fully covered working layer becomes the new reference layer
+        if (tile.mask == ~0u)
+        {
+            tile.zMax0 = tile.zMax1;
+            tile.zMax1 = 0.f;
+            tile.mask = 0;
+        }
+    }
+}
\ No newline at end of file
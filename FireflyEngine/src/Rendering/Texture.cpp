@@ -6,7 +6,7 @@
 
 namespace Firefly
 {
-    void Texture::Init(const std::string& path, bool useLinearColorSpace)
+    bool Texture::ReadImage(const std::string& path, bool useLinearColorSpace, Description& description, std::vector<uint8_t>& pixels, uint32_t channelCount)
     {
         int width, height, channels;
 
@@ -18,49 +18,101 @@ namespace Firefly
         if (stbi_is_hdr(path.c_str()))
         {
             pixelData = stbi_loadf(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-            m_description.format = Format::RGBA_32_FLOAT;
+            description.format = Format::RGBA_32_FLOAT;
+            channelCount = 4;
         }
         else
         {
+            // stbi turns two requested channels into grey and alpha, so images are always expanded to rgba and
+            // the first channels are packed afterwards
             pixelData = stbi_load(path.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-            if (useLinearColorSpace)
-                m_description.format = Format::RGBA_8;
-            else
-                m_description.format = Format::RGBA_8_NON_LINEAR;
-        }
+            if (channelCount == 0)
+                channelCount = static_cast<uint32_t>(channels);
+            // there are no three channel 8 bit formats most gpus can sample
+            if (channelCount == 3 || channelCount > 4)
+                channelCount = 4;
 
-        FIREFLY_ASSERT(pixelData, "Failed to load image: " + path);
-
-        m_description.type = Type::TEXTURE_2D;
-        m_description.width = width;
-        m_description.height = height;
-        m_description.sampleCount = SampleCount::SAMPLE_1;
-        m_description.useAsAttachment = false;
-        m_description.useSampler = true;
-        m_description.sampler.isMipMappingEnabled = true;
-        m_description.sampler.isAnisotropicFilteringEnabled = true;
-        m_description.sampler.maxAnisotropy = 16;
-        m_description.sampler.wrapMode = WrapMode::REPEAT;
-        m_description.sampler.magnificationFilterMode = FilterMode::LINEAR;
-        m_description.sampler.minificationFilterMode = FilterMode::LINEAR;
-        m_description.sampler.mipMapFilterMode = FilterMode::LINEAR;
+            switch (channelCount)
+            {
+            case 1:
+                description.format = useLinearColorSpace ? Format::R_8 : Format::R_8_NON_LINEAR;
+                break;
+            case 2:
+                description.format = useLinearColorSpace ? Format::RG_8 : Format::RG_8_NON_LINEAR;
+                break;
+            default:
+                description.format = useLinearColorSpace ? Format::RGBA_8 : Format::RGBA_8_NON_LINEAR;
+                break;
+            }
+        }
 
-        CalcMipMapLevels();
-        CalcArrayLayers();
+        if (!pixelData)
+        {
+            FIREFLY_LOG_ERROR("FireflyEngine", "Failed to load image {0}: {1}", path, stbi_failure_reason());
+            return false;
+        }
 
-        OnInit(pixelData);
+        description.type = Type::TEXTURE_2D;
+        description.width = width;
+        description.height = height;
+        description.sampleCount = SampleCount::SAMPLE_1;
+        description.useAsAttachment = false;
+        description.useSampler = true;
+        description.sampler.isMipMappingEnabled = true;
+        description.sampler.isAnisotropicFilteringEnabled = true;
+        description.sampler.maxAnisotropy = 16;
+        description.sampler.wrapMode = WrapMode::REPEAT;
+        description.sampler.magnificationFilterMode = FilterMode::LINEAR;
+        description.sampler.minificationFilterMode = FilterMode::LINEAR;
+        description.sampler.mipMapFilterMode = FilterMode::LINEAR;
 
+        size_t byteSize = static_cast<size_t>(width) * height * GetBytePerPixel(description.format);
+        if (channelCount == 4)
+        {
+            pixels.assign(static_cast<uint8_t*>(pixelData), static_cast<uint8_t*>(pixelData) + byteSize);
+        }
+        else
+        {
+            const uint8_t* rgbaPixels = static_cast<uint8_t*>(pixelData);
+            size_t pixelCount = static_cast<size_t>(width) * height;
+            pixels.resize(byteSize);
+            for (size_t i = 0; i < pixelCount; i++)
+                for (uint32_t channel = 0; channel < channelCount; channel++)
+                    pixels[i * channelCount + channel] = rgbaPixels[i * 4 + channel];
+        }
         stbi_image_free(pixelData);
+        return true;
+    }
+
+    void Texture::Init(const std::string& path, bool useLinearColorSpace)
+    {
+        Description description;
+        std::vector<uint8_t> pixels;
+        bool isRead = ReadImage(path, useLinearColorSpace, description, pixels);
+        FIREFLY_ASSERT(isRead, "Failed to load image: {0}", path);
+
+        Init(description, pixels.data());
     }
 
     void Texture::Init(const Texture::Description& description)
+    {
+        Init(description, nullptr);
+    }
+
+    void Texture::Init(const Texture::Description& description, void* pixelData)
+    {
+        Init(description, pixelData, 1);
+    }
+
+    void Texture::Init(const Texture::Description& description, void* pixelData, uint32_t pixelDataMipLevels)
     {
         m_description = description;
 
         CalcMipMapLevels();
         CalcArrayLayers();
 
-        OnInit(nullptr);
+        FIREFLY_ASSERT(pixelDataMipLevels == 1 || pixelDataMipLevels == m_mipMapLevels, "Texture pixel data needs either the first mip level or all {0} levels, not {1}!", m_mipMapLevels, pixelDataMipLevels);
+        OnInit(pixelData, pixelDataMipLevels);
     }
 
     uint32_t Texture::GetWidth()
@@ -152,6 +204,33 @@ namespace Firefly
         case Format::RGBA_32_FLOAT:
             formatName = "RGBA_32_FLOAT";
             break;
+        case Format::BC1_RGBA:
+            formatName = "BC1_RGBA";
+            break;
+        case Format::BC1_RGBA_NON_LINEAR:
+            formatName = "BC1_RGBA_NON_LINEAR";
+            break;
+        case Format::BC3_RGBA:
+            formatName = "BC3_RGBA";
+            break;
+        case Format::BC3_RGBA_NON_LINEAR:
+            formatName = "BC3_RGBA_NON_LINEAR";
+            break;
+        case Format::BC4_R:
+            formatName = "BC4_R";
+            break;
+        case Format::BC5_RG:
+            formatName = "BC5_RG";
+            break;
+        case Format::BC6H_RGB_FLOAT:
+            formatName = "BC6H_RGB_FLOAT";
+            break;
+        case Format::BC7_RGBA:
+            formatName = "BC7_RGBA";
+            break;
+        case Format::BC7_RGBA_NON_LINEAR:
+            formatName = "BC7_RGBA_NON_LINEAR";
+            break;
         case Format::DEPTH_32_FLOAT:
             formatName = "DEPTH_32_FLOAT";
             break;
@@ -184,18 +263,28 @@ namespace Firefly
         return false;
     }
 
+    uint32_t Texture::GetMipMapLevelCount(const Description& description)
+    {
+        if (description.useSampler && description.sampler.isMipMappingEnabled)
+            return static_cast<uint32_t>(std::floor(std::log2(std::max(description.width, description.height)))) + 1;
+        return 1;
+    }
+
+    uint32_t Texture::GetArrayLayerCount(const Description& description)
+    {
+        if (description.type == Type::TEXTURE_CUBE_MAP)
+            return 6;
+        return 1;
+    }
+
     void Texture::CalcMipMapLevels()
     {
-        m_mipMapLevels = 1;
-        if (m_description.useSampler && m_description.sampler.isMipMappingEnabled)
-            m_mipMapLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(m_description.width, m_description.height)))) + 1;
+        m_mipMapLevels = GetMipMapLevelCount(m_description);
     }
 
     void Texture::CalcArrayLayers()
     {
-        m_arrayLayers = 1;
-        if (m_description.type == Type::TEXTURE_CUBE_MAP)
-            m_arrayLayers = 6;
+        m_arrayLayers = GetArrayLayerCount(m_description);
     }
 
     uint32_t Texture::ConvertToSampleCountNumber(Texture::SampleCount sampleCount)
@@ -249,6 +338,41 @@ namespace Firefly
             return 12;
         case Format::RGBA_32_FLOAT:
             return 16;
+        default:
+            return 0;
+        }
+    }
+
+    bool Texture::IsCompressedFormat(Texture::Format format)
+    {
+        return GetBlockByteSize(format) != 0;
+    }
+
+    uint32_t Texture::GetBlockByteSize(Texture::Format format)
+    {
+        switch (format)
+        {
+        case Format::BC1_RGBA:
+        case Format::BC1_RGBA_NON_LINEAR:
+        case Format::BC4_R:
+            return 8;
+        case Format::BC3_RGBA:
+        case Format::BC3_RGBA_NON_LINEAR:
+        case Format::BC5_RG:
+        case Format::BC6H_RGB_FLOAT:
+        case Format::BC7_RGBA:
+        case Format::BC7_RGBA_NON_LINEAR:
+            return 16;
+        default:
+            return 0;
         }
     }
+
+    size_t Texture::GetImageByteSize(Texture::Format format, uint32_t width, uint32_t height)
+    {
+        // partial blocks at the edges of small mip levels still take a whole block
+        if (IsCompressedFormat(format))
+            return static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4) * GetBlockByteSize(format);
+        return static_cast<size_t>(width) * height * GetBytePerPixel(format);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,354 @@
+#include "pch.h"
+#include "Rendering/TextureCompressor.h"
+
+namespace Firefly
+{
+    // interpolation weights of the 4 bit indices of bc7, out of 64
+    static constexpr int32_t s_bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    // endpoints on the diagonal of the bounding box that follows the correlation of every channel with the channel
+    // of the largest range, pulled in a little since the interpolated values rarely reach the extremes
+    static void FindEndpoints(const uint8_t* texels, uint32_t channelCount, int32_t insetDivisor, int32_t* endpoint0, int32_t* endpoint1)
+    {
+        int32_t minValues[4] = { 255, 255, 255, 255 };
+        int32_t maxValues[4] = { 0, 0, 0, 0 };
+        int32_t sums[4] = { 0, 0, 0, 0 };
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            for (uint32_t channel = 0; channel < channelCount; channel++)
+            {
+                int32_t value = texels[i * 4 + channel];
+                minValues[channel] = std::min(minValues[channel], value);
+                maxValues[channel] = std::max(maxValues[channel], value);
+                sums[channel] += value;
+            }
+        }
+
+        uint32_t referenceChannel = 0;
+        for (uint32_t channel = 1; channel < channelCount; channel++)
+        {
+            if (maxValues[channel] - minValues[channel] > maxValues[referenceChannel] - minValues[referenceChannel])
+                referenceChannel = channel;
+        }
+
+        for (uint32_t channel = 0; channel < channelCount; channel++)
+        {
+            // scaled by the texel count instead of dividing the sums into means
+            int32_t covariance = 0;
+            for (uint32_t i = 0; i < 16; i++)
+                covariance += (texels[i * 4 + referenceChannel] * 16 - sums[referenceChannel]) * (texels[i * 4 + channel] * 16 - sums[channel]) / 16;
+
+            endpoint0[channel] = maxValues[channel];
+            endpoint1[channel] = minValues[channel];
+            if (covariance < 0)
+                std::swap(endpoint0[channel], endpoint1[channel]);
+
+            int32_t inset = (endpoint0[channel] - endpoint1[channel]) / insetDivisor;
+            endpoint0[channel] -= inset;
+            endpoint1[channel] += inset;
+        }
+    }
+
+    static uint32_t FindNearestEntry(const uint8_t* texel, const int32_t (*palette)[4], uint32_t entryCount, uint32_t channelCount)
+    {
+        uint32_t nearestEntry = 0;
+        int32_t nearestError = std::numeric_limits<int32_t>::max();
+        for (uint32_t entry = 0; entry < entryCount; entry++)
+        {
+            int32_t error = 0;
+            for (uint32_t channel = 0; channel < channelCount; channel++)
+            {
+                int32_t difference = texel[channel] - palette[entry][channel];
+                error += difference * difference;
+            }
+
+            if (error < nearestError)
+            {
+                nearestError = error;
+                nearestEntry = entry;
+            }
+        }
+        return nearestEntry;
+    }
+
+    Texture::Format TextureCompressor::SelectFormat(Material::TextureUsage usage, Texture::Format format)
+    {
+        if (!IsSourceFormatSupported(format))
+            return Texture::Format::NONE;
+
+        switch (usage)
+        {
+        case Material::TextureUsage::Albedo:
+            return format == Texture::Format::RGBA_8_NON_LINEAR ? Texture::Format::BC7_RGBA_NON_LINEAR : Texture::Format::BC7_RGBA;
+        case Material::TextureUsage::Normal:
+            return Texture::Format::BC5_RG;
+        case Material::TextureUsage::Roughness:
+        case Material::TextureUsage::Metalness:
+        case Material::TextureUsage::Occlusion:
+        case Material::TextureUsage::Height:
+            return Texture::Format::BC4_R;
+        case Material::TextureUsage::OcclusionRoughnessMetalness:
+            return Texture::Format::BC7_RGBA;
+        }
+        return Texture::Format::NONE;
+    }
+
+    bool TextureCompressor::IsFormatSupported(Texture::Format format)
+    {
+        switch (format)
+        {
+        case Texture::Format::BC1_RGBA:
+        case Texture::Format::BC1_RGBA_NON_LINEAR:
+        case Texture::Format::BC3_RGBA:
+        case Texture::Format::BC3_RGBA_NON_LINEAR:
+        case Texture::Format::BC4_R:
+        case Texture::Format::BC5_RG:
+        case Texture::Format::BC7_RGBA:
+        case Texture::Format::BC7_RGBA_NON_LINEAR:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool TextureCompressor::IsSourceFormatSupported(Texture::Format format)
+    {
+        switch (format)
+        {
+        case Texture::Format::R_8:
+        case Texture::Format::RG_8:
+        case Texture::Format::RGBA_8:
+        case Texture::Format::RGBA_8_NON_LINEAR:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool TextureCompressor::Compress(Texture::Description& description, std::vector<uint8_t>& pixels, uint32_t mipMapLevels, Texture::Format format)
+    {
+        if (!IsFormatSupported(format) || mipMapLevels != Texture::GetMipMapLevelCount(description))
+            return false;
+        if (!IsSourceFormatSupported(description.format))
+            return false;
+
+        uint32_t arrayLayers = Texture::GetArrayLayerCount(description);
+        size_t compressedByteSize = 0;
+        for (uint32_t level = 0; level < mipMapLevels; level++)
+            compressedByteSize += Texture::GetImageByteSize(format, std::max(description.width >> level, 1u), std::max(description.height >> level, 1u)) * arrayLayers;
+
+        std::vector<uint8_t> blocks(compressedByteSize);
+        uint32_t blockByteSize = Texture::GetBlockByteSize(format);
+        uint32_t channelCount = Texture::GetBytePerPixel(description.format);
+        const uint8_t* source = pixels.data();
+        uint8_t* block = blocks.data();
+        uint8_t texels[16 * 4];
+        for (uint32_t level = 0; level < mipMapLevels; level++)
+        {
+            uint32_t width = std::max(description.width >> level, 1u);
+            uint32_t height = std::max(description.height >> level, 1u);
+            for (uint32_t layer = 0; layer < arrayLayers; layer++)
+            {
+                for (uint32_t blockY = 0; blockY < height; blockY += 4)
+                {
+                    for (uint32_t blockX = 0; blockX < width; blockX += 4)
+                    {
+                        // blocks that reach over the edge of small levels repeat the last row and column,
+                        // channels missing in the source are zero with an opaque alpha
+                        for (uint32_t i = 0; i < 16; i++)
+                        {
+                            uint32_t x = std::min(blockX + i % 4, width - 1);
+                            uint32_t y = std::min(blockY + i / 4, height - 1);
+                            uint8_t* texel = texels + i * 4;
+                            texel[0] = texel[1] = texel[2] = 0;
+                            texel[3] = 255;
+                            memcpy(texel, source + (static_cast<size_t>(y) * width + x) * channelCount, channelCount);
+                        }
+
+                        switch (format)
+                        {
+                        case Texture::Format::BC1_RGBA:
+                        case Texture::Format::BC1_RGBA_NON_LINEAR:
+                            EncodeBC1Block(texels, block);
+                            break;
+                        case Texture::Format::BC3_RGBA:
+                        case Texture::Format::BC3_RGBA_NON_LINEAR:
+                            EncodeBC4Block(texels, 3, block);
+                            EncodeBC1Block(texels, block + 8);
+                            break;
+                        case Texture::Format::BC4_R:
+                            EncodeBC4Block(texels, 0, block);
+                            break;
+                        case Texture::Format::BC5_RG:
+                            EncodeBC4Block(texels, 0, block);
+                            EncodeBC4Block(texels, 1, block + 8);
+                            break;
+                        default:
+                            EncodeBC7Block(texels, block);
+                            break;
+                        }
+                        block += blockByteSize;
+                    }
+                }
+                source += static_cast<size_t>(width) * height * channelCount;
+            }
+        }
+
+        pixels = std::move(blocks);
+        description.format = format;
+        return true;
+    }
+
+    void TextureCompressor::EncodeBC1Block(const uint8_t* texels, uint8_t* block)
+    {
+        // opaque four color mode, alpha is either dropped or stored in the alpha block of bc3
+        int32_t endpoints[2][4];
+        FindEndpoints(texels, 3, 16, endpoints[0], endpoints[1]);
+
+        uint16_t colors[2];
+        int32_t palette[4][4] = {};
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            uint32_t red = (std::clamp(endpoints[i][0], 0, 255) * 31 + 127) / 255;
+            uint32_t green = (std::clamp(endpoints[i][1], 0, 255) * 63 + 127) / 255;
+            uint32_t blue = (std::clamp(endpoints[i][2], 0, 255) * 31 + 127) / 255;
+            colors[i] = static_cast<uint16_t>((red << 11) | (green << 5) | blue);
+            palette[i][0] = (red << 3) | (red >> 2);
+            palette[i][1] = (green << 2) | (green >> 4);
+            palette[i][2] = (blue << 3) | (blue >> 2);
+        }
+
+        // the first color has to be the bigger one, equal colors would select the three color mode
+        if (colors[0] < colors[1])
+        {
+            std::swap(colors[0], colors[1]);
+            std::swap(palette[0], palette[1]);
+        }
+
+        uint32_t indices = 0;
+        if (colors[0] != colors[1])
+        {
+            for (uint32_t channel = 0; channel < 3; channel++)
+            {
+                palette[2][channel] = (2 * palette[0][channel] + palette[1][channel]) / 3;
+                palette[3][channel] = (palette[0][channel] + 2 * palette[1][channel]) / 3;
+            }
+
+            for (uint32_t i = 0; i < 16; i++)
+                indices |= FindNearestEntry(texels + i * 4, palette, 4, 3) << (i * 2);
+        }
+
+        block[0] = colors[0] & 0xFF;
+        block[1] = colors[0] >> 8;
+        block[2] = colors[1] & 0xFF;
+        block[3] = colors[1] >> 8;
+        for (uint32_t i = 0; i < 4; i++)
+            block[4 + i] = (indices >> (i * 8)) & 0xFF;
+    }
+
+    void TextureCompressor::EncodeBC4Block(const uint8_t* texels, uint32_t channel, uint8_t* block)
+    {
+        int32_t minValue = 255;
+        int32_t maxValue = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            minValue = std::min<int32_t>(minValue, texels[i * 4 + channel]);
+            maxValue = std::max<int32_t>(maxValue, texels[i * 4 + channel]);
+        }
+
+        // the bigger value first selects the eight value mode, index 0 and 1 are the endpoints and 2 to 7 lie
+        // in between, going from the first towards the second endpoint
+        uint64_t indices = 0;
+        int32_t range = maxValue - minValue;
+        if (range > 0)
+        {
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                int32_t step = ((texels[i * 4 + channel] - minValue) * 14 + range) / (2 * range);
+                uint64_t index = step == 7 ? 0 : (step == 0 ? 1 : 8 - step);
+                indices |= index << (i * 3);
+            }
+        }
+
+        block[0] = static_cast<uint8_t>(maxValue);
+        block[1] = static_cast<uint8_t>(minValue);
+        for (uint32_t i = 0; i < 6; i++)
+            block[2 + i] = (indices >> (i * 8)) & 0xFF;
+    }
+
+    void TextureCompressor::EncodeBC7Block(const uint8_t* texels, uint8_t* block)
+    {
+        // mode 6 only, a single subset with 7 bit rgba endpoints, a p bit per endpoint and 4 bit indices
+        int32_t endpoints[2][4];
+        FindEndpoints(texels, 4, 32, endpoints[0], endpoints[1]);
+
+        // the p bit is the shared lowest bit of all channels, the one with less error is kept
+        int32_t quantizedEndpoints[2][4];
+        uint32_t pBits[2];
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            int32_t bestError = std::numeric_limits<int32_t>::max();
+            for (uint32_t pBit = 0; pBit < 2; pBit++)
+            {
+                int32_t quantized[4];
+                int32_t error = 0;
+                for (uint32_t channel = 0; channel < 4; channel++)
+                {
+                    quantized[channel] = std::clamp((endpoints[i][channel] - static_cast<int32_t>(pBit) + 1) / 2, 0, 127);
+                    int32_t difference = ((quantized[channel] << 1) | pBit) - endpoints[i][channel];
+                    error += difference * difference;
+                }
+
+                if (error < bestError)
+                {
+                    bestError = error;
+                    pBits[i] = pBit;
+                    memcpy(quantizedEndpoints[i], quantized, sizeof(quantized));
+                }
+            }
+        }
+
+        int32_t palette[16][4];
+        for (uint32_t entry = 0; entry < 16; entry++)
+        {
+            for (uint32_t channel = 0; channel < 4; channel++)
+            {
+                int32_t value0 = (quantizedEndpoints[0][channel] << 1) | pBits[0];
+                int32_t value1 = (quantizedEndpoints[1][channel] << 1) | pBits[1];
+                palette[entry][channel] = ((64 - s_bc7Weights[entry]) * value0 + s_bc7Weights[entry] * value1 + 32) >> 6;
+            }
+        }
+
+        uint32_t indices[16];
+        for (uint32_t i = 0; i < 16; i++)
+            indices[i] = FindNearestEntry(texels + i * 4, palette, 16, 4);
+
+        // the highest index bit of the first texel is implied zero, swapping the endpoints mirrors the indices
+        if (indices[0] >= 8)
+        {
+            std::swap(quantizedEndpoints[0], quantizedEndpoints[1]);
+            std::swap(pBits[0], pBits[1]);
+            for (uint32_t i = 0; i < 16; i++)
+                indices[i] = 15 - indices[i];
+        }
+
+        memset(block, 0, 16);
+        uint32_t bitPosition = 0;
+        auto writeBits = [block, &bitPosition](uint32_t value, uint32_t bitCount)
+            {
+                for (uint32_t i = 0; i < bitCount; i++, bitPosition++)
+                    block[bitPosition / 8] |= ((value >> i) & 1) << (bitPosition % 8);
+            };
+
+        writeBits(1 << 6, 7);
+        for (uint32_t channel = 0; channel < 4; channel++)
+        {
+            writeBits(quantizedEndpoints[0][channel], 7);
+            writeBits(quantizedEndpoints[1][channel], 7);
+        }
+        writeBits(pBits[0], 1);
+        writeBits(pBits[1], 1);
+        for (uint32_t i = 0; i < 16; i++)
+            writeBits(indices[i], i == 0 ? 3 : 4);
+    }
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "Rendering/Vulkan/VulkanContext.h"
 
+#include "Rendering/Material.h"
 #include "Rendering/Vulkan/VulkanSwapchain.h"
 #include "Window/WindowsWindow.h"
 
@@ -39,6 +40,16 @@ namespace Firefly
 
     bool VulkanContext::BeginScreenFrame()
     {
+        if (m_isSwapchainRecreationRequested.exchange(false))
+        {
+            m_device->WaitIdle();
+            DestroySwapchain();
+            CreateSwapchain();
+            return false;
+        }
+
+        ObserveCompletedScreenFrames();
+
         vk::Result result = m_device->GetHandle().acquireNextImageKHR(m_swapchain->GetHandle(), UINT64_MAX, m_isNewImageAvailableSemaphores[m_currentFrameIndex], nullptr, &m_currentImageIndex);
         if (result == vk::Result::eErrorOutOfDateKHR || result == vk::Result::eSuboptimalKHR)
         {
@@ -49,10 +60,15 @@ namespace Firefly
         }
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to aquire next image from the swapchain!");
 
-        // wait until the indexed command buffer is not used anymore before recording new commands to it
+        // wait until the indexed command buffer is not used anymore before recording new commands to it, a frame that was
+        // not seen complete before finished at the latest when the wait returns
         m_device->GetHandle().waitForFences(1, &m_isScreenCommandBufferAvailableFences[m_currentImageIndex], true, UINT64_MAX);
+        ObserveCompletedScreenFrames();
         m_device->GetHandle().resetFences(1, &m_isScreenCommandBufferAvailableFences[m_currentImageIndex]);
 
+        m_completedScreenFrameTiming = m_screenFrameTimings[m_currentImageIndex];
+        m_screenFrameTimings[m_currentImageIndex] = {};
+
         m_screenCommandBuffers[m_currentImageIndex].reset({});
         vk::CommandBufferBeginInfo commandBufferBeginInfo{};
         commandBufferBeginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
@@ -64,7 +80,7 @@ namespace Firefly
         return true;
     }
 
-    bool VulkanContext::EndScreenFrame()
+    bool VulkanContext::EndScreenFrame(std::chrono::steady_clock::time_point inputEventTime)
     {
         m_screenCommandBuffers[m_currentImageIndex].end();
 
@@ -100,8 +116,13 @@ namespace Firefly
         }
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to present the image with the present queue!");
 
+        // the present time is when the image was queued, the presentation engine shows it at the next possible refresh
+        m_screenFrameTimings[m_currentImageIndex].inputEventTime = inputEventTime;
+        m_screenFrameTimings[m_currentImageIndex].presentTime = std::chrono::steady_clock::now();
+
         m_currentFrameIndex = (m_currentFrameIndex + 1) % m_swapchain->GetImageCount();
 
+        ObserveCompletedScreenFrames();
         return true;
     }
 
@@ -137,6 +158,34 @@ namespace Firefly
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to submit commands to the graphics queue!");
     }
 
+    void VulkanContext::WaitForSubmittedScreenFrames()
+    {
+        ObserveCompletedScreenFrames();
+        m_device->GetHandle().waitForFences(m_isScreenCommandBufferAvailableFences.size(), m_isScreenCommandBufferAvailableFences.data(), true, UINT64_MAX);
+        ObserveCompletedScreenFrames();
+    }
+
+    void VulkanContext::ObserveCompletedScreenFrames()
+    {
+        // presented frames without a completion time are in flight or finished since the last poll
+        std::chrono::steady_clock::time_point unknownTime;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < m_screenFrameTimings.size(); i++)
+        {
+            FrameTiming& frameTiming = m_screenFrameTimings[i];
+            if (frameTiming.presentTime == unknownTime || frameTiming.gpuCompletionTime != unknownTime)
+                continue;
+
+            if (m_device->GetHandle().getFenceStatus(m_isScreenCommandBufferAvailableFences[i]) == vk::Result::eSuccess)
+                frameTiming.gpuCompletionTime = now;
+        }
+    }
+
+    FrameTiming VulkanContext::GetCompletedScreenFrameTiming() const
+    {
+        return m_completedScreenFrameTiming;
+    }
+
     vk::CommandBuffer VulkanContext::GetCurrentCommandBuffer()
     {
         return m_currentCommandBuffer;
@@ -172,6 +221,16 @@ namespace Firefly
         return m_descriptorPool;
     }
 
+    bool VulkanContext::IsTextureCompressionSupported() const
+    {
+        return m_device->IsTextureCompressionBCEnabled();
+    }
+
+    void VulkanContext::OnSetPresentMode(PresentMode presentMode)
+    {
+        m_isSwapchainRecreationRequested = true;
+    }
+
     void VulkanContext::CreateInstance()
     {
         std::string appName = "Sandbox";
@@ -276,8 +335,25 @@ namespace Firefly
 
     void VulkanContext::CreateSwapchain()
     {
+        vk::PresentModeKHR presentMode = vk::PresentModeKHR::eFifoRelaxed;
+        switch (m_presentMode)
+        {
+        case PresentMode::Fifo:
+            presentMode = vk::PresentModeKHR::eFifo;
+            break;
+        case PresentMode::FifoRelaxed:
+            presentMode = vk::PresentModeKHR::eFifoRelaxed;
+            break;
+        case PresentMode::Mailbox:
+            presentMode = vk::PresentModeKHR::eMailbox;
+            break;
+        case PresentMode::Immediate:
+            presentMode = vk::PresentModeKHR::eImmediate;
+            break;
+        }
+
         m_swapchain = std::make_shared<VulkanSwapchain>();
-        m_swapchain->Init(m_device->GetHandle(), m_device->GetPhysicalDevice(), m_surface, m_window->GetWidth(), m_window->GetHeight());
+        m_swapchain->Init(m_device->GetHandle(), m_device->GetPhysicalDevice(), m_surface, GetWidth(), GetHeight(), presentMode);
     }
 
     void VulkanContext::DestroySwapchain()
@@ -330,6 +406,9 @@ namespace Firefly
 
     void VulkanContext::CreateDescriptorPool()
     {
+        // the renderer and its passes allocate a fixed number of sets, every material a set of texture bindings per swapchain image
+        uint32_t materialSetCount = static_cast<uint32_t>(Material::s_maxMaterialCount) * m_swapchain->GetImageCount();
+
         vk::DescriptorPoolSize uniformBufferDescriptorPoolSize{};
         uniformBufferDescriptorPoolSize.type = vk::DescriptorType::eUniformBuffer;
         uniformBufferDescriptorPoolSize.descriptorCount = 100;
@@ -340,13 +419,23 @@ namespace Firefly
 
         vk::DescriptorPoolSize imageSamplerDescriptorPoolSize{};
         imageSamplerDescriptorPoolSize.type = vk::DescriptorType::eCombinedImageSampler;
-        imageSamplerDescriptorPoolSize.descriptorCount = 100;
+        imageSamplerDescriptorPoolSize.descriptorCount = 100 + materialSetCount * static_cast<uint32_t>(Material::s_textureUsageCount);
+
+        vk::DescriptorPoolSize storageBufferDescriptorPoolSize{};
+        storageBufferDescriptorPoolSize.type = vk::DescriptorType::eStorageBuffer;
+        storageBufferDescriptorPoolSize.descriptorCount = 100;
+
+        vk::DescriptorPoolSize storageImageDescriptorPoolSize{};
+        storageImageDescriptorPoolSize.type = vk::DescriptorType::eStorageImage;
+        storageImageDescriptorPoolSize.descriptorCount = 100;
 
         std::vector<vk::DescriptorPoolSize> descriptorPoolSizes =
         {
             uniformBufferDescriptorPoolSize,
             uniformBufferDynamicDescriptorPoolSize,
-            imageSamplerDescriptorPoolSize
+            imageSamplerDescriptorPoolSize,
+            storageBufferDescriptorPoolSize,
+            storageImageDescriptorPoolSize
         };
 
         vk::DescriptorPoolCreateInfo descriptorPoolCreateInfo{};
@@ -354,7 +443,7 @@ namespace Firefly
         descriptorPoolCreateInfo.flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind; // Needed in order to update textures on the fly
         descriptorPoolCreateInfo.poolSizeCount = descriptorPoolSizes.size();
         descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizes.data();
-        descriptorPoolCreateInfo.maxSets = 1000;
+        descriptorPoolCreateInfo.maxSets = 100 + materialSetCount;
 
         vk::Result result = m_device->GetHandle().createDescriptorPool(&descriptorPoolCreateInfo, nullptr, &m_descriptorPool);
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to create Vulkan descriptor pool!");
@@ -379,6 +468,7 @@ namespace Firefly
         m_isNewImageAvailableSemaphores.resize(m_swapchain->GetImageCount());
         m_isRenderedImageAvailableSemaphores.resize(m_swapchain->GetImageCount());
         m_isScreenCommandBufferAvailableFences.resize(m_swapchain->GetImageCount());
+        m_screenFrameTimings.assign(m_swapchain->GetImageCount(), {});
         for (size_t i = 0; i < m_swapchain->GetImageCount(); i++)
         {
             vk::Result result = m_device->GetHandle().createSemaphore(&semaphoreCreateInfo, nullptr, &m_isNewImageAvailableSemaphores[i]);
@@ -434,8 +524,8 @@ namespace Firefly
             break;
         }
 
-        Logger::Info("Vulkan", "API Version: {0}.{1}.{2}", VK_VERSION_MAJOR(deviceProperties.apiVersion), VK_VERSION_MINOR(deviceProperties.apiVersion), VK_VERSION_PATCH(deviceProperties.apiVersion));
-        Logger::Info("Vulkan", "{0} {1}", vendorName, deviceProperties.deviceName);
+        FIREFLY_LOG_INFO("Vulkan", "API Version: {0}.{1}.{2}", VK_VERSION_MAJOR(deviceProperties.apiVersion), VK_VERSION_MINOR(deviceProperties.apiVersion), VK_VERSION_PATCH(deviceProperties.apiVersion));
+        FIREFLY_LOG_INFO("Vulkan", "{0} {1}", vendorName, deviceProperties.deviceName);
     }
 
     std::vector<const char*> VulkanContext::GetRequiredInstanceExtensions() const
@@ -516,10 +606,10 @@ namespace Firefly
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT:
             break;
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
-            Logger::Warn("Vulkan", message);
+            FIREFLY_LOG_WARN("Vulkan", message);
             break;
         case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
-            Logger::Error("Vulkan", message);
+            FIREFLY_LOG_ERROR("Vulkan", message);
             break;
         }
         return VK_FALSE;
@@ -57,13 +57,21 @@ namespace Firefly
         requiredDeviceFeatures.samplerAnisotropy = true;
         requiredDeviceFeatures.sampleRateShading = true;
         requiredDeviceFeatures.geometryShader = true;
+        // optional, e.g. mobile gpus only have ETC2 or ASTC, textures are uploaded uncompressed without it
+        m_isTextureCompressionBCEnabled = physicalDevice.getFeatures().textureCompressionBC;
+        requiredDeviceFeatures.textureCompressionBC = m_isTextureCompressionBCEnabled;
 
-        vk::PhysicalDeviceDescriptorIndexingFeatures descriptorIndexingFeatures{};
-        descriptorIndexingFeatures.descriptorBindingPartiallyBound = true;
-        descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = true;
+        // the occlusion culled draws are issued with a gpu written draw count
+        auto supportedFeatures = physicalDevice.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features>();
+        FIREFLY_ASSERT(supportedFeatures.get<vk::PhysicalDeviceVulkan12Features>().drawIndirectCount, "Vulkan device does not support indirect draw counts!");
+
+        vk::PhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.descriptorBindingPartiallyBound = true;
+        vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = true;
+        vulkan12Features.drawIndirectCount = true;
 
         vk::PhysicalDeviceFeatures2 requiredDeviceFeatures2{};
-        requiredDeviceFeatures2.pNext = &descriptorIndexingFeatures;
+        requiredDeviceFeatures2.pNext = &vulkan12Features;
         requiredDeviceFeatures2.features = requiredDeviceFeatures;
 
         m_device = VulkanUtils::CreateDevice(physicalDevice, requiredDeviceExtensions, requiredDeviceLayers, requiredDeviceFeatures2, queueCreateInfos);
@@ -104,6 +112,11 @@ namespace Firefly
         return m_presentQueueFamilyIndex;
     }
 
+    bool VulkanDevice::IsTextureCompressionBCEnabled() const
+    {
+        return m_isTextureCompressionBCEnabled;
+    }
+
     void VulkanDevice::WaitIdle()
     {
         m_device.waitIdle();
@@ -3,6 +3,7 @@
 
 #include "Rendering/RenderingAPI.h"
 #include "Rendering/Vulkan/VulkanContext.h"
+#include "Rendering/Vulkan/VulkanSwapchain.h"
 #include "Rendering/Vulkan/VulkanTexture.h"
 
 namespace Firefly
@@ -20,9 +21,42 @@ namespace Firefly
         m_device.destroyDescriptorSetLayout(m_materialTexturesDescriptorSetLayout);
     }
 
-    vk::DescriptorSet VulkanMaterial::GetTexturesDescriptorSet() const
+    vk::DescriptorSet VulkanMaterial::GetTexturesDescriptorSet(uint32_t imageIndex)
     {
-        return m_materialTexturesDescriptorSet;
+        FIREFLY_ASSERT(imageIndex < m_materialTexturesDescriptorSets.size(), "The swapchain has more images than the material has descriptor sets!");
+
+        // the version is only behind after a texture changed, every other draw of the material skips the lock
+        if (m_descriptorSetTextureVersions[imageIndex] != m_textureVersion.load(std::memory_order_acquire))
+        {
+            std::vector<vk::DescriptorImageInfo> descriptorImageInfos;
+            std::vector<vk::WriteDescriptorSet> writeDescriptorSets;
+            descriptorImageInfos.reserve(s_textureUsageCount);
+
+            std::lock_guard<std::mutex> lock(m_textureMutex);
+            for (uint32_t binding = 0; binding < s_textureUsageCount; binding++)
+            {
+                if (!m_textureImageInfos[binding].imageView)
+                    continue;
+
+                descriptorImageInfos.push_back(m_textureImageInfos[binding]);
+
+                vk::WriteDescriptorSet writeDescriptorSet{};
+                writeDescriptorSet.dstSet = m_materialTexturesDescriptorSets[imageIndex];
+                writeDescriptorSet.dstBinding = binding;
+                writeDescriptorSet.dstArrayElement = 0;
+                writeDescriptorSet.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+                writeDescriptorSet.descriptorCount = 1;
+                writeDescriptorSet.pBufferInfo = nullptr;
+                writeDescriptorSet.pImageInfo = &descriptorImageInfos.back();
+                writeDescriptorSet.pTexelBufferView = nullptr;
+                writeDescriptorSets.push_back(writeDescriptorSet);
+            }
+
+            m_device.updateDescriptorSets(writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
+            m_descriptorSetTextureVersions[imageIndex] = m_textureVersion.load(std::memory_order_relaxed);
+        }
+
+        return m_materialTexturesDescriptorSets[imageIndex];
     }
 
     void VulkanMaterial::OnInit()
@@ -69,6 +103,13 @@ namespace Firefly
         heightTextureLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eFragment;
         heightTextureLayoutBinding.pImmutableSamplers = nullptr;
 
+        vk::DescriptorSetLayoutBinding occlusionRoughnessMetalnessTextureLayoutBinding{};
+        occlusionRoughnessMetalnessTextureLayoutBinding.binding = 6;
+        occlusionRoughnessMetalnessTextureLayoutBinding.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+        occlusionRoughnessMetalnessTextureLayoutBinding.descriptorCount = 1;
+        occlusionRoughnessMetalnessTextureLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eFragment;
+        occlusionRoughnessMetalnessTextureLayoutBinding.pImmutableSamplers = nullptr;
+
         std::vector<vk::DescriptorSetLayoutBinding> bindings =
         {
             albedoTextureLayoutBinding,
@@ -76,12 +117,13 @@ namespace Firefly
             roughnessTextureLayoutBinding,
             metalnessTextureLayoutBinding,
             occlusionTextureLayoutBinding,
-            heightTextureLayoutBinding
+            heightTextureLayoutBinding,
+            occlusionRoughnessMetalnessTextureLayoutBinding
         };
 
-        // PartiallyBound: (PhysicalDeviceDescriptorIndexingFeatures.descriptorBindingPartiallyBound needs to be enabled)
+        // PartiallyBound: (PhysicalDeviceVulkan12Features.descriptorBindingPartiallyBound needs to be enabled)
         // -> Allows to update only part of the combined image sampler descriptors with actual data 
-        // UpdateAfterBind: (PhysicalDeviceDescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind needs to be enabled)
+        // UpdateAfterBind: (PhysicalDeviceVulkan12Features.descriptorBindingSampledImageUpdateAfterBind needs to be enabled)
         // -> Allows to update a combined image sampler descriptor on the fly -> corres. flag needs to be set in DescriptorSetLayoutCreateInfo and DescriptorPoolCreateInfo
         std::vector<vk::DescriptorBindingFlags> bindingFlags(bindings.size(), vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eUpdateAfterBind);
         vk::DescriptorSetLayoutBindingFlagsCreateInfo layoutBindingFlagsCreateInfo{};
@@ -97,12 +139,19 @@ namespace Firefly
         vk::Result result = m_device.createDescriptorSetLayout(&materialTexturesDescriptorSetLayoutCreateInfo, nullptr, &m_materialTexturesDescriptorSetLayout);
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor set layout!");
 
+        // one set per swapchain image, like the scene data sets, the image fence tells when a set can be written again
+        std::shared_ptr<VulkanContext> vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
+        uint32_t imageCount = vkContext->GetSwapchain()->GetImageCount();
+        m_materialTexturesDescriptorSets.resize(imageCount);
+        m_descriptorSetTextureVersions.assign(imageCount, 0);
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts(imageCount, m_materialTexturesDescriptorSetLayout);
+
         vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{};
         descriptorSetAllocateInfo.pNext = nullptr;
         descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
-        descriptorSetAllocateInfo.descriptorSetCount = 1;
-        descriptorSetAllocateInfo.pSetLayouts = &m_materialTexturesDescriptorSetLayout;
-        result = m_device.allocateDescriptorSets(&descriptorSetAllocateInfo, &m_materialTexturesDescriptorSet);
+        descriptorSetAllocateInfo.descriptorSetCount = imageCount;
+        descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+        result = m_device.allocateDescriptorSets(&descriptorSetAllocateInfo, m_materialTexturesDescriptorSets.data());
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
     }
 
@@ -129,6 +178,9 @@ namespace Firefly
         case TextureUsage::Height:
             binding = 5;
             break;
+        case TextureUsage::OcclusionRoughnessMetalness:
+            binding = 6;
+            break;
         }
 
         std::shared_ptr<VulkanTexture> vkTexture = std::dynamic_pointer_cast<VulkanTexture>(texture);
@@ -138,16 +190,9 @@ namespace Firefly
         descriptorImageInfo.imageView = vkTexture->GetImageView();
         descriptorImageInfo.sampler = vkTexture->GetSampler();
 
-        vk::WriteDescriptorSet writeDescriptorSet{};
-        writeDescriptorSet.dstSet = m_materialTexturesDescriptorSet;
-        writeDescriptorSet.dstBinding = binding;
-        writeDescriptorSet.dstArrayElement = 0;
-        writeDescriptorSet.descriptorType = vk::DescriptorType::eCombinedImageSampler;
-        writeDescriptorSet.descriptorCount = 1;
-        writeDescriptorSet.pBufferInfo = nullptr;
-        writeDescriptorSet.pImageInfo = &descriptorImageInfo;
-        writeDescriptorSet.pTexelBufferView = nullptr;
-
-        m_device.updateDescriptorSets(1, &writeDescriptorSet, 0, nullptr);
+        // the sets may be bound by frames in flight, the thread that draws writes them in GetTexturesDescriptorSet
+        std::lock_guard<std::mutex> lock(m_textureMutex);
+        m_textureImageInfos[binding] = descriptorImageInfo;
+        m_textureVersion.fetch_add(1, std::memory_order_release);
     }
 }
\ No newline at end of file
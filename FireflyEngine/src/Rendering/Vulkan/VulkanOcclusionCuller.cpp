@@ -0,0 +1,557 @@
+#include "pch.h"
+#include "Rendering/Vulkan/VulkanOcclusionCuller.h"
+
+#include "Rendering/RenderingAPI.h"
+#include "Rendering/Vulkan/VulkanShader.h"
+#include "Rendering/Vulkan/VulkanSwapchain.h"
+#include "Rendering/Vulkan/VulkanUtils.h"
+
+namespace Firefly
+{
+    void VulkanOcclusionCuller::Init(uint32_t maxObjectCount)
+    {
+        m_vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
+        m_device = m_vkContext->GetDevice();
+        m_imageCount = m_vkContext->GetSwapchain()->GetImageCount();
+        m_maxObjectCount = maxObjectCount;
+
+        ShaderCode depthCopyShaderCode = {};
+        depthCopyShaderCode.compute = Shader::ReadShaderCodeFromFile("assets/shaders/Vulkan/hiZDepthCopy.comp.spv");
+        m_depthCopyShader = RenderingAPI::CreateShader("hiZDepthCopy", depthCopyShaderCode);
+
+        ShaderCode depthReduceShaderCode = {};
+        depthReduceShaderCode.compute = Shader::ReadShaderCodeFromFile("assets/shaders/Vulkan/hiZDepthReduce.comp.spv");
+        m_depthReduceShader = RenderingAPI::CreateShader("hiZDepthReduce", depthReduceShaderCode);
+
+        ShaderCode cullShaderCode = {};
+        cullShaderCode.compute = Shader::ReadShaderCodeFromFile("assets/shaders/Vulkan/occlusionCull.comp.spv");
+        m_cullShader = RenderingAPI::CreateShader("occlusionCull", cullShaderCode);
+
+        vk::SamplerCreateInfo samplerCreateInfo{};
+        samplerCreateInfo.pNext = nullptr;
+        samplerCreateInfo.flags = {};
+        samplerCreateInfo.magFilter = vk::Filter::eNearest;
+        samplerCreateInfo.minFilter = vk::Filter::eNearest;
+        samplerCreateInfo.mipmapMode = vk::SamplerMipmapMode::eNearest;
+        samplerCreateInfo.addressModeU = vk::SamplerAddressMode::eClampToEdge;
+        samplerCreateInfo.addressModeV = vk::SamplerAddressMode::eClampToEdge;
+        samplerCreateInfo.addressModeW = vk::SamplerAddressMode::eClampToEdge;
+        samplerCreateInfo.mipLodBias = 0.0f;
+        samplerCreateInfo.anisotropyEnable = false;
+        samplerCreateInfo.maxAnisotropy = 1.0f;
+        samplerCreateInfo.compareEnable = false;
+        samplerCreateInfo.compareOp = vk::CompareOp::eAlways;
+        samplerCreateInfo.minLod = 0.0f;
+        samplerCreateInfo.maxLod = static_cast<float>(s_maxPyramidLevelCount);
+        samplerCreateInfo.borderColor = vk::BorderColor::eFloatOpaqueWhite;
+        samplerCreateInfo.unnormalizedCoordinates = false;
+        vk::Result result = m_device->GetHandle().createSampler(&samplerCreateInfo, nullptr, &m_pyramidSampler);
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to create Vulkan depth pyramid sampler!");
+
+        CreateBuffers();
+        CreateDescriptorSetLayouts();
+        AllocateDescriptorSets();
+        CreatePipelines();
+    }
+
+    void VulkanOcclusionCuller::Destroy()
+    {
+        DestroyPipelines();
+        DestroyDescriptorSetLayouts();
+        DestroyDepthPyramid();
+        DestroyBuffers();
+
+        m_device->GetHandle().destroySampler(m_pyramidSampler);
+
+        m_cullShader->Destroy();
+        m_depthReduceShader->Destroy();
+        m_depthCopyShader->Destroy();
+    }
+
+    void VulkanOcclusionCuller::SetDepthTexture(std::shared_ptr<VulkanTexture> depthTexture, Texture::SampleCount sampleCount)
+    {
+        DestroyDepthPyramid();
+
+        m_depthTexture = depthTexture;
+        m_depthSampleCount = sampleCount;
+        CreateDepthPyramid();
+        UpdateDescriptorSets();
+    }
+
+    void VulkanOcclusionCuller::UpdateObjects(const std::vector<CullObject>& objects)
+    {
+        FIREFLY_ASSERT(objects.size() <= m_maxObjectCount, "Too many objects for occlusion culling!");
+        m_objectCount = static_cast<uint32_t>(objects.size());
+        if (m_objectCount == 0)
+            return;
+
+        uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
+        vk::DeviceSize size = m_objectCount * sizeof(CullObject);
+
+        void* mappedMemory;
+        m_device->GetHandle().mapMemory(m_objectBufferMemories[currentImageIndex], 0, size, {}, &mappedMemory);
+        memcpy(mappedMemory, objects.data(), size);
+        m_device->GetHandle().unmapMemory(m_objectBufferMemories[currentImageIndex]);
+    }
+
+    void VulkanOcclusionCuller::CullFirstPhase()
+    {
+        vk::CommandBuffer commandBuffer = m_vkContext->GetCurrentCommandBuffer();
+
+        if (!m_isPyramidLayoutInitialized)
+        {
+            vk::ImageMemoryBarrier imageMemoryBarrier{};
+            imageMemoryBarrier.srcAccessMask = {};
+            imageMemoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+            imageMemoryBarrier.oldLayout = vk::ImageLayout::eUndefined;
+            imageMemoryBarrier.newLayout = vk::ImageLayout::eGeneral;
+            imageMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            imageMemoryBarrier.image = m_pyramidImage;
+            imageMemoryBarrier.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+            imageMemoryBarrier.subresourceRange.baseMipLevel = 0;
+            imageMemoryBarrier.subresourceRange.levelCount = m_pyramidLevelCount;
+            imageMemoryBarrier.subresourceRange.baseArrayLayer = 0;
+            imageMemoryBarrier.subresourceRange.layerCount = 1;
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eComputeShader, {},
+                0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+            m_isPyramidLayoutInitialized = true;
+        }
+        else
+        {
+            // the pyramid is shared by all frames in flight, it may still be built by the previous frame's submission
+            vk::MemoryBarrier memoryBarrier{};
+            memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+            memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {},
+                1, &memoryBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        Cull(Phase::FIRST);
+    }
+
+    void VulkanOcclusionCuller::BuildDepthPyramid(const glm::mat4& viewProjection)
+    {
+        vk::CommandBuffer commandBuffer = m_vkContext->GetCurrentCommandBuffer();
+
+        ReducePushConstants pushConstants = {};
+        pushConstants.inputSize = glm::ivec2(m_pyramidWidth, m_pyramidHeight);
+        pushConstants.outputSize = glm::ivec2(m_pyramidWidth, m_pyramidHeight);
+        pushConstants.sampleCount = static_cast<int32_t>(VulkanTexture::ConvertToVulkanSampleCount(m_depthSampleCount));
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_depthCopyPipeline);
+        for (uint32_t level = 0; level < m_pyramidLevelCount; level++)
+        {
+            if (level == 1)
+                commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_depthReducePipeline);
+            if (level > 0)
+            {
+                pushConstants.inputSize = pushConstants.outputSize;
+                pushConstants.outputSize = (pushConstants.inputSize + 1) / 2;
+            }
+
+            commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_reducePipelineLayout, 0, 1, &m_reduceDescriptorSets[level], 0, nullptr);
+            commandBuffer.pushConstants(m_reducePipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(ReducePushConstants), &pushConstants);
+            commandBuffer.dispatch((pushConstants.outputSize.x + 7) / 8, (pushConstants.outputSize.y + 7) / 8, 1);
+
+            vk::MemoryBarrier memoryBarrier{};
+            memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+            memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+            commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eComputeShader, {},
+                1, &memoryBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        // the depth attachment is written again by the second draw phase after it was read here
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = {};
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+            vk::AccessFlagBits::eColorAttachmentRead | vk::AccessFlagBits::eColorAttachmentWrite;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests | vk::PipelineStageFlagBits::eColorAttachmentOutput, {},
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        m_pyramidViewProjection = viewProjection;
+        m_isPyramidValid = true;
+    }
+
+    void VulkanOcclusionCuller::CullSecondPhase()
+    {
+        Cull(Phase::SECOND);
+    }
+
+    vk::Buffer VulkanOcclusionCuller::GetDrawCommandBuffer() const
+    {
+        return m_drawCommandBuffers[m_vkContext->GetCurrentImageIndex()];
+    }
+
+    vk::DeviceSize VulkanOcclusionCuller::GetDrawCommandOffset(size_t commandIndex, Phase phase) const
+    {
+        size_t drawCommandIndex = phase == Phase::FIRST ? commandIndex : m_objectCount + commandIndex;
+        return drawCommandIndex * sizeof(vk::DrawIndexedIndirectCommand);
+    }
+
+    uint32_t VulkanOcclusionCuller::GetDrawCommandStride() const
+    {
+        return sizeof(vk::DrawIndexedIndirectCommand);
+    }
+
+    vk::Buffer VulkanOcclusionCuller::GetDrawCountBuffer() const
+    {
+        return m_drawCountBuffers[m_vkContext->GetCurrentImageIndex()];
+    }
+
+    vk::DeviceSize VulkanOcclusionCuller::GetDrawCountOffset(size_t batchIndex, Phase phase) const
+    {
+        size_t drawCountIndex = phase == Phase::FIRST ? batchIndex : m_objectCount + batchIndex;
+        return drawCountIndex * sizeof(uint32_t);
+    }
+
+    void VulkanOcclusionCuller::Cull(Phase phase)
+    {
+        if (m_objectCount == 0)
+            return;
+
+        uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
+        vk::CommandBuffer commandBuffer = m_vkContext->GetCurrentCommandBuffer();
+
+        CullPushConstants pushConstants = {};
+        pushConstants.viewProjection = m_pyramidViewProjection;
+        pushConstants.depthSize = glm::uvec2(m_pyramidWidth, m_pyramidHeight);
+        pushConstants.objectCount = m_objectCount;
+        pushConstants.pyramidLevelCount = m_pyramidLevelCount;
+        pushConstants.phase = phase == Phase::FIRST ? 0 : 1;
+        pushConstants.isPyramidValid = m_isPyramidValid ? 1 : 0;
+
+        // the shader counts the visible objects of every batch up from zero, there are never more batches than objects
+        commandBuffer.fillBuffer(m_drawCountBuffers[currentImageIndex], GetDrawCountOffset(0, phase), m_objectCount * sizeof(uint32_t), 0);
+
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eComputeShader, {},
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_cullPipeline);
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_cullPipelineLayout, 0, 1, &m_cullDescriptorSets[currentImageIndex], 0, nullptr);
+        commandBuffer.pushConstants(m_cullPipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(CullPushConstants), &pushConstants);
+        commandBuffer.dispatch((m_objectCount + 63) / 64, 1, 1);
+
+        InsertDrawCommandBarrier(commandBuffer);
+    }
+
+    void VulkanOcclusionCuller::InsertDrawCommandBarrier(vk::CommandBuffer commandBuffer)
+    {
+        // the draw commands and counts are consumed by indirect draws, the visibility flags by the second cull phase
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eIndirectCommandRead | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+            vk::PipelineStageFlagBits::eDrawIndirect | vk::PipelineStageFlagBits::eComputeShader, {},
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanOcclusionCuller::CreateBuffers()
+    {
+        m_objectBuffers.resize(m_imageCount);
+        m_objectBufferMemories.resize(m_imageCount);
+        m_drawCommandBuffers.resize(m_imageCount);
+        m_drawCommandBufferMemories.resize(m_imageCount);
+        m_drawCountBuffers.resize(m_imageCount);
+        m_drawCountBufferMemories.resize(m_imageCount);
+        m_visibilityBuffers.resize(m_imageCount);
+        m_visibilityBufferMemories.resize(m_imageCount);
+
+        for (size_t i = 0; i < m_imageCount; i++)
+        {
+            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), m_maxObjectCount * sizeof(CullObject),
+                vk::BufferUsageFlagBits::eStorageBuffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+                m_objectBuffers[i], m_objectBufferMemories[i]);
+
+            // at most one command per object and phase
+            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), 2 * m_maxObjectCount * sizeof(vk::DrawIndexedIndirectCommand),
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                m_drawCommandBuffers[i], m_drawCommandBufferMemories[i]);
+
+            // at most one batch per object and phase
+            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), 2 * m_maxObjectCount * sizeof(uint32_t),
+                vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer | vk::BufferUsageFlagBits::eTransferDst, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                m_drawCountBuffers[i], m_drawCountBufferMemories[i]);
+
+            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), m_maxObjectCount * sizeof(uint32_t),
+                vk::BufferUsageFlagBits::eStorageBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal,
+                m_visibilityBuffers[i], m_visibilityBufferMemories[i]);
+        }
+    }
+
+    void VulkanOcclusionCuller::DestroyBuffers()
+    {
+        for (size_t i = 0; i < m_imageCount; i++)
+        {
+            m_device->GetHandle().destroyBuffer(m_objectBuffers[i]);
+            m_device->GetHandle().freeMemory(m_objectBufferMemories[i]);
+            m_device->GetHandle().destroyBuffer(m_drawCommandBuffers[i]);
+            m_device->GetHandle().freeMemory(m_drawCommandBufferMemories[i]);
+            m_device->GetHandle().destroyBuffer(m_drawCountBuffers[i]);
+            m_device->GetHandle().freeMemory(m_drawCountBufferMemories[i]);
+            m_device->GetHandle().destroyBuffer(m_visibilityBuffers[i]);
+            m_device->GetHandle().freeMemory(m_visibilityBufferMemories[i]);
+        }
+    }
+
+    void VulkanOcclusionCuller::CreateDescriptorSetLayouts()
+    {
+        // DEPTH PYRAMID REDUCTION
+        vk::DescriptorSetLayoutBinding inputDepthLayoutBinding{};
+        inputDepthLayoutBinding.binding = 0;
+        inputDepthLayoutBinding.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+        inputDepthLayoutBinding.descriptorCount = 1;
+        inputDepthLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        inputDepthLayoutBinding.pImmutableSamplers = nullptr;
+
+        vk::DescriptorSetLayoutBinding outputDepthLayoutBinding{};
+        outputDepthLayoutBinding.binding = 1;
+        outputDepthLayoutBinding.descriptorType = vk::DescriptorType::eStorageImage;
+        outputDepthLayoutBinding.descriptorCount = 1;
+        outputDepthLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        outputDepthLayoutBinding.pImmutableSamplers = nullptr;
+
+        std::vector<vk::DescriptorSetLayoutBinding> bindings = { inputDepthLayoutBinding, outputDepthLayoutBinding };
+
+        vk::DescriptorSetLayoutCreateInfo reduceDescriptorSetLayoutCreateInfo{};
+        reduceDescriptorSetLayoutCreateInfo.bindingCount = bindings.size();
+        reduceDescriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+        vk::Result result = m_device->GetHandle().createDescriptorSetLayout(&reduceDescriptorSetLayoutCreateInfo, nullptr, &m_reduceDescriptorSetLayout);
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor set layout!");
+
+        // CULLING
+        bindings.clear();
+        for (uint32_t binding = 0; binding < 3; binding++)
+        {
+            vk::DescriptorSetLayoutBinding bufferLayoutBinding{};
+            bufferLayoutBinding.binding = binding;
+            bufferLayoutBinding.descriptorType = vk::DescriptorType::eStorageBuffer;
+            bufferLayoutBinding.descriptorCount = 1;
+            bufferLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+            bufferLayoutBinding.pImmutableSamplers = nullptr;
+            bindings.push_back(bufferLayoutBinding);
+        }
+
+        vk::DescriptorSetLayoutBinding depthPyramidLayoutBinding{};
+        depthPyramidLayoutBinding.binding = 3;
+        depthPyramidLayoutBinding.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+        depthPyramidLayoutBinding.descriptorCount = 1;
+        depthPyramidLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        depthPyramidLayoutBinding.pImmutableSamplers = nullptr;
+        bindings.push_back(depthPyramidLayoutBinding);
+
+        vk::DescriptorSetLayoutBinding drawCountLayoutBinding{};
+        drawCountLayoutBinding.binding = 4;
+        drawCountLayoutBinding.descriptorType = vk::DescriptorType::eStorageBuffer;
+        drawCountLayoutBinding.descriptorCount = 1;
+        drawCountLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        drawCountLayoutBinding.pImmutableSamplers = nullptr;
+        bindings.push_back(drawCountLayoutBinding);
+
+        vk::DescriptorSetLayoutCreateInfo cullDescriptorSetLayoutCreateInfo{};
+        cullDescriptorSetLayoutCreateInfo.bindingCount = bindings.size();
+        cullDescriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+        result = m_device->GetHandle().createDescriptorSetLayout(&cullDescriptorSetLayoutCreateInfo, nullptr, &m_cullDescriptorSetLayout);
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor set layout!");
+    }
+
+    void VulkanOcclusionCuller::DestroyDescriptorSetLayouts()
+    {
+        m_device->GetHandle().destroyDescriptorSetLayout(m_cullDescriptorSetLayout);
+        m_device->GetHandle().destroyDescriptorSetLayout(m_reduceDescriptorSetLayout);
+    }
+
+    void VulkanOcclusionCuller::AllocateDescriptorSets()
+    {
+        // the sets are allocated once for the maximum level count and rewritten whenever the pyramid is recreated
+        m_reduceDescriptorSets.resize(s_maxPyramidLevelCount);
+        std::vector<vk::DescriptorSetLayout> reduceDescriptorSetLayouts(s_maxPyramidLevelCount, m_reduceDescriptorSetLayout);
+        vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+        descriptorSetAllocateInfo.pNext = nullptr;
+        descriptorSetAllocateInfo.descriptorPool = m_vkContext->GetDescriptorPool();
+        descriptorSetAllocateInfo.descriptorSetCount = reduceDescriptorSetLayouts.size();
+        descriptorSetAllocateInfo.pSetLayouts = reduceDescriptorSetLayouts.data();
+        vk::Result result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, m_reduceDescriptorSets.data());
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
+
+        m_cullDescriptorSets.resize(m_imageCount);
+        std::vector<vk::DescriptorSetLayout> cullDescriptorSetLayouts(m_imageCount, m_cullDescriptorSetLayout);
+        descriptorSetAllocateInfo.descriptorSetCount = cullDescriptorSetLayouts.size();
+        descriptorSetAllocateInfo.pSetLayouts = cullDescriptorSetLayouts.data();
+        result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, m_cullDescriptorSets.data());
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
+    }
+
+    void VulkanOcclusionCuller::CreatePipelines()
+    {
+        vk::PushConstantRange reducePushConstantRange{};
+        reducePushConstantRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        reducePushConstantRange.offset = 0;
+        reducePushConstantRange.size = sizeof(ReducePushConstants);
+        m_reducePipelineLayout = VulkanUtils::CreatePipelineLayout({ m_reduceDescriptorSetLayout }, { reducePushConstantRange });
+        m_depthCopyPipeline = VulkanUtils::CreateComputePipeline(m_reducePipelineLayout, std::dynamic_pointer_cast<VulkanShader>(m_depthCopyShader));
+        m_depthReducePipeline = VulkanUtils::CreateComputePipeline(m_reducePipelineLayout, std::dynamic_pointer_cast<VulkanShader>(m_depthReduceShader));
+
+        vk::PushConstantRange cullPushConstantRange{};
+        cullPushConstantRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        cullPushConstantRange.offset = 0;
+        cullPushConstantRange.size = sizeof(CullPushConstants);
+        m_cullPipelineLayout = VulkanUtils::CreatePipelineLayout({ m_cullDescriptorSetLayout }, { cullPushConstantRange });
+        m_cullPipeline = VulkanUtils::CreateComputePipeline(m_cullPipelineLayout, std::dynamic_pointer_cast<VulkanShader>(m_cullShader));
+    }
+
+    void VulkanOcclusionCuller::DestroyPipelines()
+    {
+        m_device->GetHandle().destroyPipeline(m_cullPipeline);
+        m_device->GetHandle().destroyPipelineLayout(m_cullPipelineLayout);
+        m_device->GetHandle().destroyPipeline(m_depthReducePipeline);
+        m_device->GetHandle().destroyPipeline(m_depthCopyPipeline);
+        m_device->GetHandle().destroyPipelineLayout(m_reducePipelineLayout);
+    }
+
+    void VulkanOcclusionCuller::CreateDepthPyramid()
+    {
+        m_pyramidWidth = m_depthTexture->GetWidth();
+        m_pyramidHeight = m_depthTexture->GetHeight();
+
+        // every level halves the previous one rounding up, down to a single texel
+        m_pyramidLevelCount = 1;
+        uint32_t maxSize = std::max(m_pyramidWidth, m_pyramidHeight);
+        while (maxSize > 1 && m_pyramidLevelCount < s_maxPyramidLevelCount)
+        {
+            maxSize = (maxSize + 1) / 2;
+            m_pyramidLevelCount++;
+        }
+
+        vk::Format format = vk::Format::eR32Sfloat;
+        VulkanTexture::CreateVulkanImage(m_pyramidWidth, m_pyramidHeight, format,
+            m_pyramidLevelCount, 1, vk::SampleCountFlagBits::e1,
+            vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eStorage, vk::MemoryPropertyFlagBits::eDeviceLocal, {},
+            m_pyramidImage, m_pyramidImageMemory);
+        m_pyramidImageView = VulkanUtils::CreateImageView(m_device->GetHandle(), m_pyramidImage, m_pyramidLevelCount, format, vk::ImageAspectFlagBits::eColor);
+
+        m_pyramidLevelImageViews.resize(m_pyramidLevelCount);
+        for (uint32_t level = 0; level < m_pyramidLevelCount; level++)
+        {
+            vk::ImageViewCreateInfo imageViewCreateInfo{};
+            imageViewCreateInfo.pNext = nullptr;
+            imageViewCreateInfo.flags = {};
+            imageViewCreateInfo.image = m_pyramidImage;
+            imageViewCreateInfo.viewType = vk::ImageViewType::e2D;
+            imageViewCreateInfo.format = format;
+            imageViewCreateInfo.components.r = vk::ComponentSwizzle::eIdentity;
+            imageViewCreateInfo.components.g = vk::ComponentSwizzle::eIdentity;
+            imageViewCreateInfo.components.b = vk::ComponentSwizzle::eIdentity;
+            imageViewCreateInfo.components.a = vk::ComponentSwizzle::eIdentity;
+            imageViewCreateInfo.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
+            imageViewCreateInfo.subresourceRange.baseMipLevel = level;
+            imageViewCreateInfo.subresourceRange.levelCount = 1;
+            imageViewCreateInfo.subresourceRange.baseArrayLayer = 0;
+            imageViewCreateInfo.subresourceRange.layerCount = 1;
+
+            vk::Result result = m_device->GetHandle().createImageView(&imageViewCreateInfo, nullptr, &m_pyramidLevelImageViews[level]);
+            FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to create Vulkan image view!");
+        }
+
+        m_isPyramidValid = false;
+        m_isPyramidLayoutInitialized = false;
+    }
+
+    void VulkanOcclusionCuller::DestroyDepthPyramid()
+    {
+        if (!m_pyramidImage)
+            return;
+
+        for (auto imageView : m_pyramidLevelImageViews)
+            m_device->GetHandle().destroyImageView(imageView);
+        m_pyramidLevelImageViews.clear();
+        m_device->GetHandle().destroyImageView(m_pyramidImageView);
+        m_device->GetHandle().destroyImage(m_pyramidImage);
+        m_device->GetHandle().freeMemory(m_pyramidImageMemory);
+        m_pyramidImage = nullptr;
+    }
+
+    void VulkanOcclusionCuller::UpdateDescriptorSets()
+    {
+        std::vector<vk::DescriptorImageInfo> inputImageInfos(m_pyramidLevelCount);
+        std::vector<vk::DescriptorImageInfo> outputImageInfos(m_pyramidLevelCount);
+        std::vector<vk::WriteDescriptorSet> writeDescriptorSets;
+        for (uint32_t level = 0; level < m_pyramidLevelCount; level++)
+        {
+            // the first level reads the multisampled depth attachment, the others the previous level
+            inputImageInfos[level].sampler = m_pyramidSampler;
+            if (level == 0)
+            {
+                inputImageInfos[level].imageView = m_depthTexture->GetImageView();
+                inputImageInfos[level].imageLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+            }
+            else
+            {
+                inputImageInfos[level].imageView = m_pyramidLevelImageViews[level - 1];
+                inputImageInfos[level].imageLayout = vk::ImageLayout::eGeneral;
+            }
+
+            outputImageInfos[level].sampler = nullptr;
+            outputImageInfos[level].imageView = m_pyramidLevelImageViews[level];
+            outputImageInfos[level].imageLayout = vk::ImageLayout::eGeneral;
+
+            vk::WriteDescriptorSet writeDescriptorSet{};
+            writeDescriptorSet.dstSet = m_reduceDescriptorSets[level];
+            writeDescriptorSet.dstBinding = 0;
+            writeDescriptorSet.dstArrayElement = 0;
+            writeDescriptorSet.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+            writeDescriptorSet.descriptorCount = 1;
+            writeDescriptorSet.pImageInfo = &inputImageInfos[level];
+            writeDescriptorSets.push_back(writeDescriptorSet);
+
+            writeDescriptorSet.dstBinding = 1;
+            writeDescriptorSet.descriptorType = vk::DescriptorType::eStorageImage;
+            writeDescriptorSet.pImageInfo = &outputImageInfos[level];
+            writeDescriptorSets.push_back(writeDescriptorSet);
+        }
+
+        vk::DescriptorImageInfo pyramidImageInfo{};
+        pyramidImageInfo.sampler = m_pyramidSampler;
+        pyramidImageInfo.imageView = m_pyramidImageView;
+        pyramidImageInfo.imageLayout = vk::ImageLayout::eGeneral;
+
+        std::vector<vk::DescriptorBufferInfo> bufferInfos(4 * m_imageCount);
+        for (size_t i = 0; i < m_imageCount; i++)
+        {
+            bufferInfos[4 * i + 0] = vk::DescriptorBufferInfo(m_objectBuffers[i], 0, VK_WHOLE_SIZE);
+            bufferInfos[4 * i + 1] = vk::DescriptorBufferInfo(m_drawCommandBuffers[i], 0, VK_WHOLE_SIZE);
+            bufferInfos[4 * i + 2] = vk::DescriptorBufferInfo(m_visibilityBuffers[i], 0, VK_WHOLE_SIZE);
+            bufferInfos[4 * i + 3] = vk::DescriptorBufferInfo(m_drawCountBuffers[i], 0, VK_WHOLE_SIZE);
+
+            vk::WriteDescriptorSet writeDescriptorSet{};
+            writeDescriptorSet.dstSet = m_cullDescriptorSets[i];
+            writeDescriptorSet.dstBinding = 0;
+            writeDescriptorSet.dstArrayElement = 0;
+            writeDescriptorSet.descriptorType = vk::DescriptorType::eStorageBuffer;
+            writeDescriptorSet.descriptorCount = 3;
+            writeDescriptorSet.pBufferInfo = &bufferInfos[4 * i];
+            writeDescriptorSets.push_back(writeDescriptorSet);
+
+            writeDescriptorSet.dstBinding = 3;
+            writeDescriptorSet.descriptorType = vk::DescriptorType::eCombinedImageSampler;
+            writeDescriptorSet.descriptorCount = 1;
+            writeDescriptorSet.pBufferInfo = nullptr;
+            writeDescriptorSet.pImageInfo = &pyramidImageInfo;
+            writeDescriptorSets.push_back(writeDescriptorSet);
+
+            writeDescriptorSet.dstBinding = 4;
+            writeDescriptorSet.descriptorType = vk::DescriptorType::eStorageBuffer;
+            writeDescriptorSet.pBufferInfo = &bufferInfos[4 * i + 3];
+            writeDescriptorSet.pImageInfo = nullptr;
+            writeDescriptorSets.push_back(writeDescriptorSet);
+        }
+
+        m_device->GetHandle().updateDescriptorSets(writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
+    }
+}
\ No newline at end of file
@@ -67,6 +67,18 @@ namespace Firefly
         else
             subpassDependency.dstAccessMask = vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
 
+        // the attachments are sampled by later passes or compute shaders once the pass has ended
+        vk::SubpassDependency outgoingSubpassDependency{};
+        outgoingSubpassDependency.dependencyFlags = {};
+        outgoingSubpassDependency.srcSubpass = 0;
+        outgoingSubpassDependency.dstSubpass = VK_SUBPASS_EXTERNAL;
+        outgoingSubpassDependency.srcStageMask = vk::PipelineStageFlagBits::eColorAttachmentOutput | vk::PipelineStageFlagBits::eLateFragmentTests;
+        outgoingSubpassDependency.dstStageMask = vk::PipelineStageFlagBits::eFragmentShader | vk::PipelineStageFlagBits::eComputeShader;
+        outgoingSubpassDependency.srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
+        outgoingSubpassDependency.dstAccessMask = vk::AccessFlagBits::eShaderRead;
+
+        std::vector<vk::SubpassDependency> subpassDependencies = { subpassDependency, outgoingSubpassDependency };
+
         vk::RenderPassCreateInfo renderPassCreateInfo{};
         renderPassCreateInfo.pNext = nullptr;
         renderPassCreateInfo.flags = {};
@@ -74,8 +86,8 @@ namespace Firefly
         renderPassCreateInfo.pAttachments = attachmentDescriptions.data();
         renderPassCreateInfo.subpassCount = 1;
         renderPassCreateInfo.pSubpasses = &subpassDescription;
-        renderPassCreateInfo.dependencyCount = 1;
-        renderPassCreateInfo.pDependencies = &subpassDependency;
+        renderPassCreateInfo.dependencyCount = subpassDependencies.size();
+        renderPassCreateInfo.pDependencies = subpassDependencies.data();
 
         vk::Result result = m_device.createRenderPass(&renderPassCreateInfo, nullptr, &m_renderPass);
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to create Vulkan render pass!");
@@ -181,11 +193,11 @@ namespace Firefly
         attachmentDescription.flags = {};
         attachmentDescription.format = format;
         attachmentDescription.samples = VulkanTexture::ConvertToVulkanSampleCount(attachmentLayout.sampleCount);
-        attachmentDescription.loadOp = vk::AttachmentLoadOp::eClear;
+        attachmentDescription.loadOp = m_description.isClearingEnabled ? vk::AttachmentLoadOp::eClear : vk::AttachmentLoadOp::eLoad;
         attachmentDescription.storeOp = vk::AttachmentStoreOp::eStore;
         attachmentDescription.stencilLoadOp = vk::AttachmentLoadOp::eDontCare;
         attachmentDescription.stencilStoreOp = vk::AttachmentStoreOp::eDontCare;
-        attachmentDescription.initialLayout = vk::ImageLayout::eUndefined;
+        attachmentDescription.initialLayout = m_description.isClearingEnabled ? vk::ImageLayout::eUndefined : vk::ImageLayout::eShaderReadOnlyOptimal;
         attachmentDescription.finalLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
 
         return attachmentDescription;
@@ -8,9 +8,6 @@
 #include "Rendering/Vulkan/VulkanUtils.h"
 #include "Rendering/Vulkan/VulkanFrameBuffer.h"
 #include "Rendering/Vulkan/VulkanRenderPass.h"
-#include "Scene/Components/TransformComponent.h"
-#include "Scene/Components/MeshComponent.h"
-#include "Scene/Components/MaterialComponent.h"
 #include "Rendering/MeshGenerator.h"
 
 namespace Firefly
@@ -40,16 +37,22 @@ namespace Firefly
 
         CreatePipelines();
 
+        m_occlusionCuller.Init(m_objectDataCount);
+        m_occlusionCuller.SetDepthTexture(m_depthTexture, m_msaaSampleCount);
+
         CreateScreenTexturePassResources();
 
     }
 
     void VulkanRenderer::Destroy()
     {
+        StopRenderThread();
         m_device->WaitIdle();
 
         DestroyScreenTexturePassResources();
 
+        m_occlusionCuller.Destroy();
+
         DestroyPipelines();
 
         DestroyImageBasedLightingResources();
@@ -66,46 +69,19 @@ namespace Firefly
         m_quadMesh->Destroy();
     }
 
-    void VulkanRenderer::BeginDrawRecording()
+    bool VulkanRenderer::IsRenderThreadSupported() const
     {
-        m_entities.clear();
-        m_materials.clear();
-        m_entityMaterialIndices.clear();
+        return true;
     }
 
-    void VulkanRenderer::RecordDraw(const Entity& entity)
+    void VulkanRenderer::DrawFrame(const FramePacket& framePacket)
     {
-        if (entity.HasComponents<MeshComponent, MaterialComponent, TransformComponent>())
-            m_entities.push_back(entity);
-    }
-
-    void VulkanRenderer::EndDrawRecording()
-    {
-        for (size_t i = 0; i < m_entities.size(); i++)
-        {
-            std::shared_ptr<Material> entityMaterial = m_entities[i].GetComponent<MaterialComponent>().m_material;
-            bool foundMaterial = false;
-            size_t entityMaterialIndex = 0;
-            for (size_t j = 0; j < m_materials.size(); j++)
-            {
-                if (m_materials[j] == entityMaterial)
-                {
-                    entityMaterialIndex = j;
-                    foundMaterial = true;
-                    break;
-                }
-            }
-            if (!foundMaterial)
-            {
-                entityMaterialIndex = m_materials.size();
-                m_materials.push_back(entityMaterial);
-            }
-            m_entityMaterialIndices.push_back(entityMaterialIndex);
-        }
-    }
+        // the deltas are kept by the scene buffers until a frame is actually drawn
+        for (const auto& [objectIndex, objectData] : framePacket.objectDataDeltas)
+            m_objectDataBuffer.Write(objectIndex, &objectData);
+        for (const auto& [materialIndex, materialData] : framePacket.materialDataDeltas)
+            m_materialDataBuffer.Write(materialIndex, &materialData);
 
-    void VulkanRenderer::SubmitDraw(std::shared_ptr<Camera> camera)
-    {
         if (m_vkContext->GetWidth() == 0 || m_vkContext->GetHeight() == 0)
         {
             m_device->WaitIdle();
@@ -117,45 +93,27 @@ namespace Firefly
             RecreateResources();
             return;
         }
+        RecordFrameTiming(m_vkContext->GetCompletedScreenFrameTiming());
 
         uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
         vk::CommandBuffer currentCommandBuffer = m_vkContext->GetCurrentCommandBuffer();
 
-        UpdateUniformBuffers(camera);
+        UpdateUniformBuffers(framePacket);
+        m_materialDataBuffer.RecordUpload();
+        m_objectDataBuffer.RecordUpload();
 
-        m_mainRenderPass->Begin(m_mainFrameBuffers[currentImageIndex]);
-
-        for (size_t i = 0; i < m_entities.size(); i++)
-        {
-            std::shared_ptr<VulkanMaterial> material = std::dynamic_pointer_cast<VulkanMaterial>(m_materials[m_entityMaterialIndices[i]]);
-            std::shared_ptr<VulkanMesh> mesh = std::dynamic_pointer_cast<VulkanMesh>(m_entities[i].GetComponent<MeshComponent>().m_mesh);
-            std::string shaderTag = material->GetShader()->GetTag();
+        // entities rejected against the old depth pyramid get a second chance against the pyramid built from the first phase
+        m_occlusionCuller.CullFirstPhase();
 
-            currentCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, m_pipelines[shaderTag]);
-
-            std::vector<vk::DescriptorSet> descriptorSets =
-            {
-                m_sceneDataDescriptorSets[currentImageIndex],
-                m_materialDataDescriptorSets[currentImageIndex],
-                material->GetTexturesDescriptorSet(),
-                m_objectDataDescriptorSets[currentImageIndex],
-                m_imageBasedLightingDescriptorSet
-            };
-            std::vector<uint32_t> dynamicOffsets =
-            {
-                static_cast<uint32_t>(m_entityMaterialIndices[i] * m_materialDataDynamicAlignment),
-                static_cast<uint32_t>(i * m_objectDataDynamicAlignment)
-            };
-            currentCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_pipelineLayouts[shaderTag], 0,
-                descriptorSets.size(), descriptorSets.data(),
-                dynamicOffsets.size(), dynamicOffsets.data());
+        m_mainRenderPass->Begin(m_mainFrameBuffers[currentImageIndex]);
+        RecordEntityDraws(framePacket, VulkanOcclusionCuller::Phase::FIRST);
+        m_mainRenderPass->End();
 
-            vk::DeviceSize offsets[] = { 0 };
-            currentCommandBuffer.bindVertexBuffers(0, 1, &mesh->GetVertexBuffer(), offsets);
-            currentCommandBuffer.bindIndexBuffer(mesh->GetIndexBuffer(), 0, vk::IndexType::eUint32);
+        m_occlusionCuller.BuildDepthPyramid(framePacket.sceneData.viewProjectionMatrix);
+        m_occlusionCuller.CullSecondPhase();
 
-            currentCommandBuffer.drawIndexed(mesh->GetIndexCount(), 1, 0, 0, 0);
-        }
+        m_mainLateRenderPass->Begin(m_mainFrameBuffers[currentImageIndex]);
+        RecordEntityDraws(framePacket, VulkanOcclusionCuller::Phase::SECOND);
 
         // Render environment map
         currentCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, m_environmentMapPipeline);
@@ -174,7 +132,7 @@ namespace Firefly
 
         currentCommandBuffer.drawIndexed(m_cubeMesh->GetIndexCount(), 1, 0, 0, 0);
 
-        m_mainRenderPass->End();
+        m_mainLateRenderPass->End();
 
         // RENDER RESOLVED COLOR TEXTURE TO SCREEN
         vk::ClearValue clearValue;
@@ -202,65 +160,125 @@ namespace Firefly
         currentCommandBuffer.endRenderPass();
 
 
-        if (!m_vkContext->EndScreenFrame())
+        if (!m_vkContext->EndScreenFrame(framePacket.inputEventTime))
         {
             RecreateResources();
             return;
         }
+
+        RecordPresent(framePacket);
+    }
+
+    void VulkanRenderer::WaitForSubmittedFrames()
+    {
+        m_vkContext->WaitForSubmittedScreenFrames();
     }
 
-    void VulkanRenderer::UpdateUniformBuffers(std::shared_ptr<Camera> camera)
+    void VulkanRenderer::RecordEntityDraws(const FramePacket& framePacket, VulkanOcclusionCuller::Phase phase)
     {
         uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
+        vk::CommandBuffer currentCommandBuffer = m_vkContext->GetCurrentCommandBuffer();
 
-        // Scene Data ---------
-        glm::vec4 cameraPosition = glm::vec4(camera->GetPosition(), 1.0f);
-        glm::mat4 viewMatrix = camera->GetViewMatrix();
-        glm::mat4 projectionMatrix = camera->GetProjectionMatrix();
+        for (size_t batchIndex = 0; batchIndex < m_drawBatches.size(); batchIndex++)
+        {
+            const DrawBatch& batch = m_drawBatches[batchIndex];
+            const FrameDraw& draw = framePacket.draws[batch.firstDraw];
+            VulkanMaterial* material = dynamic_cast<VulkanMaterial*>(draw.material);
+            VulkanMesh* mesh = dynamic_cast<VulkanMesh*>(draw.mesh);
+            std::string shaderTag = material->GetShader()->GetTag();
 
-        SceneData sceneData;
-        sceneData.viewMatrix = viewMatrix;
-        sceneData.projectionMatrix = projectionMatrix;
-        sceneData.viewProjectionMatrix = projectionMatrix * viewMatrix;
-        sceneData.cameraPosition = cameraPosition;
+            currentCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, m_pipelines[shaderTag]);
 
-        void* mappedMemory;
-        m_device->GetHandle().mapMemory(m_sceneDataUniformBufferMemories[currentImageIndex], 0, sizeof(SceneData), {}, &mappedMemory);
-        memcpy(mappedMemory, &sceneData, sizeof(SceneData));
-        m_device->GetHandle().unmapMemory(m_sceneDataUniformBufferMemories[currentImageIndex]);
-        // --------------------
-        // Material Data ------
-        for (size_t i = 0; i < m_materials.size(); i++)
-        {
-            MaterialData* materialData = (MaterialData*)((uint64_t)m_materialData + (i * m_materialDataDynamicAlignment));
-            (*materialData).albedo = m_materials[i]->GetAlbedo();
-            (*materialData).roughness = m_materials[i]->GetRoughness();
-            (*materialData).metalness = m_materials[i]->GetMetalness();
-            (*materialData).heightScale = m_materials[i]->GetHeightScale();
-            (*materialData).hasAlbedoTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Albedo);
-            (*materialData).hasNormalTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Normal);
-            (*materialData).hasRoughnessTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Roughness);
-            (*materialData).hasMetalnessTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Metalness);
-            (*materialData).hasOcclusionTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Occlusion);
-            (*materialData).hasHeightTexture = (float)m_materials[i]->IsTextureEnabled(Material::TextureUsage::Height);
+            vk::DescriptorSet descriptorSets[] =
+            {
+                m_sceneDataDescriptorSets[currentImageIndex],
+                m_materialDataDescriptorSet,
+                material->GetTexturesDescriptorSet(currentImageIndex),
+                m_objectDataDescriptorSet,
+                m_imageBasedLightingDescriptorSet
+            };
+            uint32_t dynamicOffsets[] =
+            {
+                static_cast<uint32_t>(draw.materialIndex * m_materialDataDynamicAlignment)
+            };
+            currentCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, m_pipelineLayouts[shaderTag], 0,
+                std::size(descriptorSets), descriptorSets,
+                std::size(dynamicOffsets), dynamicOffsets);
+
+            vk::DeviceSize offsets[] = { 0 };
+            currentCommandBuffer.bindVertexBuffers(0, 1, &mesh->GetVertexBuffer(), offsets);
+            currentCommandBuffer.bindIndexBuffer(mesh->GetIndexBuffer(), 0, vk::IndexType::eUint32);
+
+            // only the commands of the visible objects are written, their first instance selects the object data
+            currentCommandBuffer.drawIndexedIndirectCount(m_occlusionCuller.GetDrawCommandBuffer(), m_occlusionCuller.GetDrawCommandOffset(batch.firstCommand, phase),
+                m_occlusionCuller.GetDrawCountBuffer(), m_occlusionCuller.GetDrawCountOffset(batchIndex, phase),
+                batch.drawCount, m_occlusionCuller.GetDrawCommandStride());
         }
+    }
 
-        m_device->GetHandle().mapMemory(m_materialDataUniformBufferMemories[currentImageIndex], 0, m_materialDataCount * m_materialDataDynamicAlignment, {}, &mappedMemory);
-        memcpy(mappedMemory, m_materialData, m_materialDataCount * m_materialDataDynamicAlignment);
-        m_device->GetHandle().unmapMemory(m_materialDataUniformBufferMemories[currentImageIndex]);
-        // --------------------
-        // Object Data --------
-        for (size_t i = 0; i < m_entities.size(); i++)
+    void VulkanRenderer::BatchDraws(const FramePacket& framePacket)
+    {
+        m_drawOrder.resize(framePacket.draws.size());
+        for (size_t i = 0; i < m_drawOrder.size(); i++)
+            m_drawOrder[i] = static_cast<uint32_t>(i);
+
+        // draws sharing shader, material and mesh only differ in their object data
+        std::sort(m_drawOrder.begin(), m_drawOrder.end(), [&framePacket](uint32_t left, uint32_t right)
+            {
+                const FrameDraw& leftDraw = framePacket.draws[left];
+                const FrameDraw& rightDraw = framePacket.draws[right];
+                if (leftDraw.material->GetShader() != rightDraw.material->GetShader())
+                    return leftDraw.material->GetShader() < rightDraw.material->GetShader();
+                if (leftDraw.material != rightDraw.material)
+                    return leftDraw.material < rightDraw.material;
+                if (leftDraw.materialIndex != rightDraw.materialIndex)
+                    return leftDraw.materialIndex < rightDraw.materialIndex;
+                return leftDraw.mesh < rightDraw.mesh;
+            });
+
+        m_drawBatches.clear();
+        m_cullObjects.resize(m_drawOrder.size());
+        for (size_t i = 0; i < m_drawOrder.size(); i++)
         {
-            glm::mat4 modelMatrix = m_entities[i].GetComponent<TransformComponent>().m_transform;
-            ObjectData* objectData = (ObjectData*)((uint64_t)m_objectData + (i * m_objectDataDynamicAlignment));
-            (*objectData).modelMatrix = modelMatrix;
-            (*objectData).normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(modelMatrix))));
+            const FrameDraw& draw = framePacket.draws[m_drawOrder[i]];
+            if (m_drawBatches.empty() || !IsSameBatch(framePacket.draws[m_drawBatches.back().firstDraw], draw))
+            {
+                DrawBatch batch = {};
+                batch.firstDraw = m_drawOrder[i];
+                batch.firstCommand = static_cast<uint32_t>(i);
+                batch.drawCount = 0;
+                m_drawBatches.push_back(batch);
+            }
+            m_drawBatches.back().drawCount++;
+
+            m_cullObjects[i].boundsMin = glm::vec4(draw.worldBox.m_min, 1.0f);
+            m_cullObjects[i].boundsMax = glm::vec4(draw.worldBox.m_max, 1.0f);
+            m_cullObjects[i].indexCount = draw.mesh->GetIndexCount();
+            m_cullObjects[i].objectIndex = draw.objectIndex;
+            m_cullObjects[i].batchIndex = static_cast<uint32_t>(m_drawBatches.size() - 1);
+            m_cullObjects[i].batchFirstCommand = m_drawBatches.back().firstCommand;
         }
+    }
+
+    bool VulkanRenderer::IsSameBatch(const FrameDraw& left, const FrameDraw& right)
+    {
+        return left.material->GetShader() == right.material->GetShader() && left.material == right.material &&
+            left.materialIndex == right.materialIndex && left.mesh == right.mesh;
+    }
 
-        m_device->GetHandle().mapMemory(m_objectDataUniformBufferMemories[currentImageIndex], 0, m_objectDataCount * m_objectDataDynamicAlignment, {}, &mappedMemory);
-        memcpy(mappedMemory, m_objectData, m_objectDataCount * m_objectDataDynamicAlignment);
-        m_device->GetHandle().unmapMemory(m_objectDataUniformBufferMemories[currentImageIndex]);
+    void VulkanRenderer::UpdateUniformBuffers(const FramePacket& framePacket)
+    {
+        uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
+
+        // Scene Data ---------
+        void* mappedMemory;
+        m_device->GetHandle().mapMemory(m_sceneDataUniformBufferMemories[currentImageIndex], 0, sizeof(SceneData), {}, &mappedMemory);
+        memcpy(mappedMemory, &framePacket.sceneData, sizeof(SceneData));
+        m_device->GetHandle().unmapMemory(m_sceneDataUniformBufferMemories[currentImageIndex]);
+        // --------------------
+        // Cull Objects -------
+        BatchDraws(framePacket);
+        m_occlusionCuller.UpdateObjects(m_cullObjects);
         // --------------------
     }
 
@@ -272,6 +290,7 @@ namespace Firefly
         DestroyFramebuffers();
 
         CreateFramebuffers();
+        m_occlusionCuller.SetDepthTexture(m_depthTexture, m_msaaSampleCount);
         CreateScreenTexturePassResources();
     }
 
@@ -287,10 +306,15 @@ namespace Firefly
         mainRenderPassDesc.colorResolveAttachmentLayouts = { {Texture::Format::RGBA_8, Texture::SampleCount::SAMPLE_1} };
         mainRenderPassDesc.depthStencilAttachmentLayout = { Texture::Format::DEPTH_32_FLOAT, m_msaaSampleCount };
         m_mainRenderPass = RenderingAPI::CreateRenderPass(mainRenderPassDesc);
+
+        // continues the main pass after the depth pyramid was built from its depth
+        mainRenderPassDesc.isClearingEnabled = false;
+        m_mainLateRenderPass = RenderingAPI::CreateRenderPass(mainRenderPassDesc);
     }
 
     void VulkanRenderer::DestroyRenderPass()
     {
+        m_mainLateRenderPass->Destroy();
         m_mainRenderPass->Destroy();
     }
 
@@ -374,8 +398,8 @@ namespace Firefly
     void VulkanRenderer::CreateUniformBuffers()
     {
         CreateSceneDataUniformBuffers();
-        CreateMaterialDataUniformBuffers();
-        CreateObjectDataUniformBuffers();
+        CreateMaterialDataBuffer();
+        CreateObjectDataBuffer();
     }
 
     void VulkanRenderer::DestroyUniformBuffers()
@@ -384,11 +408,9 @@ namespace Firefly
         {
             m_device->GetHandle().destroyBuffer(m_sceneDataUniformBuffers[i]);
             m_device->GetHandle().freeMemory(m_sceneDataUniformBufferMemories[i]);
-            m_device->GetHandle().destroyBuffer(m_materialDataUniformBuffers[i]);
-            m_device->GetHandle().freeMemory(m_materialDataUniformBufferMemories[i]);
-            m_device->GetHandle().destroyBuffer(m_objectDataUniformBuffers[i]);
-            m_device->GetHandle().freeMemory(m_objectDataUniformBufferMemories[i]);
         }
+        m_materialDataBuffer.Destroy();
+        m_objectDataBuffer.Destroy();
     }
 
     void VulkanRenderer::CreateDescriptorSetLayouts()
@@ -498,7 +520,7 @@ namespace Firefly
         // OBJECT DATA
         vk::DescriptorSetLayoutBinding objectDataLayoutBinding{};
         objectDataLayoutBinding.binding = 0;
-        objectDataLayoutBinding.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+        objectDataLayoutBinding.descriptorType = vk::DescriptorType::eStorageBuffer;
         objectDataLayoutBinding.descriptorCount = 1;
         objectDataLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eVertex;
         objectDataLayoutBinding.pImmutableSamplers = nullptr;
@@ -524,8 +546,8 @@ namespace Firefly
     void VulkanRenderer::AllocateDescriptorSets()
     {
         AllocateSceneDataDescriptorSets();
-        AllocateMaterialDataDescriptorSets();
-        AllocateObjectDataDescriptorSets();
+        AllocateMaterialDataDescriptorSet();
+        AllocateObjectDataDescriptorSet();
     }
 
     void VulkanRenderer::CreateSceneDataUniformBuffers()
@@ -539,39 +561,22 @@ namespace Firefly
             VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), bufferSize, bufferUsageFlags, memoryPropertyFlags, m_sceneDataUniformBuffers[i], m_sceneDataUniformBufferMemories[i]);
     }
 
-    void VulkanRenderer::CreateMaterialDataUniformBuffers()
+    void VulkanRenderer::CreateMaterialDataBuffer()
     {
         size_t minUniformAlignment = m_device->GetPhysicalDevice().getProperties().limits.minUniformBufferOffsetAlignment;
         m_materialDataDynamicAlignment = sizeof(SceneData);
         if (minUniformAlignment > 0)
             m_materialDataDynamicAlignment = (m_materialDataDynamicAlignment + minUniformAlignment - 1) & ~(minUniformAlignment - 1);
 
-        size_t bufferSize = m_materialDataCount * m_materialDataDynamicAlignment; // TODO: grow/shrink dynamic buffer size dynamically
-        m_materialData = (MaterialData*)_aligned_malloc(bufferSize, m_materialDataDynamicAlignment);
-        vk::BufferUsageFlags bufferUsageFlags = vk::BufferUsageFlagBits::eUniformBuffer;
-        vk::MemoryPropertyFlags memoryPropertyFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-        m_materialDataUniformBuffers.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        m_materialDataUniformBufferMemories.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        for (size_t i = 0; i < m_vkContext->GetSwapchain()->GetImageCount(); i++)
-            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), bufferSize, bufferUsageFlags, memoryPropertyFlags, m_materialDataUniformBuffers[i], m_materialDataUniformBufferMemories[i]);
-
+        // TODO: grow/shrink dynamic buffer size dynamically
+        m_materialDataBuffer.Init(m_materialDataCount, sizeof(MaterialData), m_materialDataDynamicAlignment);
     }
 
-    void VulkanRenderer::CreateObjectDataUniformBuffers()
+    void VulkanRenderer::CreateObjectDataBuffer()
     {
-        size_t minUniformAlignment = m_device->GetPhysicalDevice().getProperties().limits.minUniformBufferOffsetAlignment;
-        m_objectDataDynamicAlignment = sizeof(SceneData);
-        if (minUniformAlignment > 0)
-            m_objectDataDynamicAlignment = (m_objectDataDynamicAlignment + minUniformAlignment - 1) & ~(minUniformAlignment - 1);
-
-        size_t bufferSize = m_objectDataCount * m_objectDataDynamicAlignment; // TODO: grow/shrink dynamic buffer size dynamically
-        m_objectData = (ObjectData*)_aligned_malloc(bufferSize, m_objectDataDynamicAlignment);
-        vk::BufferUsageFlags bufferUsageFlags = vk::BufferUsageFlagBits::eUniformBuffer;
-        vk::MemoryPropertyFlags memoryPropertyFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
-        m_objectDataUniformBuffers.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        m_objectDataUniformBufferMemories.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        for (size_t i = 0; i < m_vkContext->GetSwapchain()->GetImageCount(); i++)
-            VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), bufferSize, bufferUsageFlags, memoryPropertyFlags, m_objectDataUniformBuffers[i], m_objectDataUniformBufferMemories[i]);
+        // read as storage buffer array indexed by the instance, tightly packed like the std430 array in the shaders
+        // TODO: grow/shrink buffer size dynamically
+        m_objectDataBuffer.Init(m_objectDataCount, sizeof(ObjectData), sizeof(ObjectData));
     }
 
     void VulkanRenderer::AllocateSceneDataDescriptorSets()
@@ -610,76 +615,64 @@ namespace Firefly
         }
     }
 
-    void VulkanRenderer::AllocateMaterialDataDescriptorSets()
+    void VulkanRenderer::AllocateMaterialDataDescriptorSet()
     {
-        m_materialDataDescriptorSets.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts(m_vkContext->GetSwapchain()->GetImageCount(), m_materialDataDescriptorSetLayout);
+        // a single device local buffer is shared by all frames, the scatter upload synchronizes with the draws reading it
         vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{};
         descriptorSetAllocateInfo.pNext = nullptr;
         descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
-        descriptorSetAllocateInfo.descriptorSetCount = m_vkContext->GetSwapchain()->GetImageCount();
-        descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+        descriptorSetAllocateInfo.descriptorSetCount = 1;
+        descriptorSetAllocateInfo.pSetLayouts = &m_materialDataDescriptorSetLayout;
 
-        vk::Result result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, m_materialDataDescriptorSets.data());
+        vk::Result result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, &m_materialDataDescriptorSet);
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
 
-        for (size_t i = 0; i < m_vkContext->GetSwapchain()->GetImageCount(); i++)
-        {
-            vk::DescriptorBufferInfo materialDataDescriptorBufferInfo{};
-            materialDataDescriptorBufferInfo.buffer = m_materialDataUniformBuffers[i];
-            materialDataDescriptorBufferInfo.offset = 0;
-            materialDataDescriptorBufferInfo.range = sizeof(MaterialData);
-
-            vk::WriteDescriptorSet materialDataWriteDescriptorSet{};
-            materialDataWriteDescriptorSet.dstSet = m_materialDataDescriptorSets[i];
-            materialDataWriteDescriptorSet.dstBinding = 0;
-            materialDataWriteDescriptorSet.dstArrayElement = 0;
-            materialDataWriteDescriptorSet.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
-            materialDataWriteDescriptorSet.descriptorCount = 1;
-            materialDataWriteDescriptorSet.pBufferInfo = &materialDataDescriptorBufferInfo;
-            materialDataWriteDescriptorSet.pImageInfo = nullptr;
-            materialDataWriteDescriptorSet.pTexelBufferView = nullptr;
-
-            std::vector<vk::WriteDescriptorSet> writeDescriptorSets = { materialDataWriteDescriptorSet };
-
-            m_device->GetHandle().updateDescriptorSets(writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
-        }
+        vk::DescriptorBufferInfo materialDataDescriptorBufferInfo{};
+        materialDataDescriptorBufferInfo.buffer = m_materialDataBuffer.GetBuffer();
+        materialDataDescriptorBufferInfo.offset = 0;
+        materialDataDescriptorBufferInfo.range = sizeof(MaterialData);
+
+        vk::WriteDescriptorSet materialDataWriteDescriptorSet{};
+        materialDataWriteDescriptorSet.dstSet = m_materialDataDescriptorSet;
+        materialDataWriteDescriptorSet.dstBinding = 0;
+        materialDataWriteDescriptorSet.dstArrayElement = 0;
+        materialDataWriteDescriptorSet.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
+        materialDataWriteDescriptorSet.descriptorCount = 1;
+        materialDataWriteDescriptorSet.pBufferInfo = &materialDataDescriptorBufferInfo;
+        materialDataWriteDescriptorSet.pImageInfo = nullptr;
+        materialDataWriteDescriptorSet.pTexelBufferView = nullptr;
+
+        m_device->GetHandle().updateDescriptorSets(1, &materialDataWriteDescriptorSet, 0, nullptr);
     }
 
-    void VulkanRenderer::AllocateObjectDataDescriptorSets()
+    void VulkanRenderer::AllocateObjectDataDescriptorSet()
     {
-        m_objectDataDescriptorSets.resize(m_vkContext->GetSwapchain()->GetImageCount());
-        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts(m_vkContext->GetSwapchain()->GetImageCount(), m_objectDataDescriptorSetLayout);
+        // a single device local buffer is shared by all frames, the scatter upload synchronizes with the draws reading it
         vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{};
         descriptorSetAllocateInfo.pNext = nullptr;
         descriptorSetAllocateInfo.descriptorPool = m_descriptorPool;
-        descriptorSetAllocateInfo.descriptorSetCount = m_vkContext->GetSwapchain()->GetImageCount();
-        descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+        descriptorSetAllocateInfo.descriptorSetCount = 1;
+        descriptorSetAllocateInfo.pSetLayouts = &m_objectDataDescriptorSetLayout;
 
-        vk::Result result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, m_objectDataDescriptorSets.data());
+        vk::Result result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, &m_objectDataDescriptorSet);
         FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
 
-        for (size_t i = 0; i < m_vkContext->GetSwapchain()->GetImageCount(); i++)
-        {
-            vk::DescriptorBufferInfo objectDataDescriptorBufferInfo{};
-            objectDataDescriptorBufferInfo.buffer = m_objectDataUniformBuffers[i];
-            objectDataDescriptorBufferInfo.offset = 0;
-            objectDataDescriptorBufferInfo.range = sizeof(ObjectData);
-
-            vk::WriteDescriptorSet objectDataWriteDescriptorSet{};
-            objectDataWriteDescriptorSet.dstSet = m_objectDataDescriptorSets[i];
-            objectDataWriteDescriptorSet.dstBinding = 0;
-            objectDataWriteDescriptorSet.dstArrayElement = 0;
-            objectDataWriteDescriptorSet.descriptorType = vk::DescriptorType::eUniformBufferDynamic;
-            objectDataWriteDescriptorSet.descriptorCount = 1;
-            objectDataWriteDescriptorSet.pBufferInfo = &objectDataDescriptorBufferInfo;
-            objectDataWriteDescriptorSet.pImageInfo = nullptr;
-            objectDataWriteDescriptorSet.pTexelBufferView = nullptr;
-
-            std::vector<vk::WriteDescriptorSet> writeDescriptorSets = { objectDataWriteDescriptorSet };
-
-            m_device->GetHandle().updateDescriptorSets(writeDescriptorSets.size(), writeDescriptorSets.data(), 0, nullptr);
-        }
+        vk::DescriptorBufferInfo objectDataDescriptorBufferInfo{};
+        objectDataDescriptorBufferInfo.buffer = m_objectDataBuffer.GetBuffer();
+        objectDataDescriptorBufferInfo.offset = 0;
+        objectDataDescriptorBufferInfo.range = VK_WHOLE_SIZE;
+
+        vk::WriteDescriptorSet objectDataWriteDescriptorSet{};
+        objectDataWriteDescriptorSet.dstSet = m_objectDataDescriptorSet;
+        objectDataWriteDescriptorSet.dstBinding = 0;
+        objectDataWriteDescriptorSet.dstArrayElement = 0;
+        objectDataWriteDescriptorSet.descriptorType = vk::DescriptorType::eStorageBuffer;
+        objectDataWriteDescriptorSet.descriptorCount = 1;
+        objectDataWriteDescriptorSet.pBufferInfo = &objectDataDescriptorBufferInfo;
+        objectDataWriteDescriptorSet.pImageInfo = nullptr;
+        objectDataWriteDescriptorSet.pTexelBufferView = nullptr;
+
+        m_device->GetHandle().updateDescriptorSets(1, &objectDataWriteDescriptorSet, 0, nullptr);
     }
 
     void VulkanRenderer::CreatePipelines()
@@ -693,17 +686,16 @@ namespace Firefly
             m_imageBasedLightingDescriptorSetLayout
         };
 
-        std::vector<std::shared_ptr<Shader>> shaders = ShaderRegistry::Instance().GetAll();
-        for (auto shader : shaders)
-        {
-            vk::PipelineLayout pipelineLayout = VulkanUtils::CreatePipelineLayout(descriptorSetLayouts);
-            vk::Pipeline pipeline = VulkanUtils::CreatePipeline(pipelineLayout,
-                std::dynamic_pointer_cast<VulkanRenderPass>(m_mainRenderPass),
-                std::dynamic_pointer_cast<VulkanShader>(shader));
-
-            m_pipelineLayouts[shader->GetTag()] = pipelineLayout;
-            m_pipelines[shader->GetTag()] = pipeline;
-        }
+        ShaderRegistry::Instance().Each([this, &descriptorSetLayouts](ShaderHandle shaderHandle, const std::shared_ptr<Shader>& shader)
+            {
+                vk::PipelineLayout pipelineLayout = VulkanUtils::CreatePipelineLayout(descriptorSetLayouts);
+                vk::Pipeline pipeline = VulkanUtils::CreatePipeline(pipelineLayout,
+                    std::dynamic_pointer_cast<VulkanRenderPass>(m_mainRenderPass),
+                    std::dynamic_pointer_cast<VulkanShader>(shader));
+
+                m_pipelineLayouts[shader->GetTag()] = pipelineLayout;
+                m_pipelines[shader->GetTag()] = pipeline;
+            });
     }
 
     void VulkanRenderer::DestroyPipelines()
@@ -0,0 +1,201 @@
+#include "pch.h"
+#include "Rendering/Vulkan/VulkanSceneBuffer.h"
+
+#include "Rendering/RenderingAPI.h"
+#include "Rendering/Vulkan/VulkanShader.h"
+#include "Rendering/Vulkan/VulkanSwapchain.h"
+#include "Rendering/Vulkan/VulkanUtils.h"
+
+namespace Firefly
+{
+    void VulkanSceneBuffer::Init(uint32_t elementCount, uint32_t elementSize, vk::DeviceSize elementStride)
+    {
+        FIREFLY_ASSERT(elementStride % 16 == 0 && elementStride >= elementSize, "Invalid scene buffer element stride: {0}", elementStride);
+
+        m_vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
+        m_device = m_vkContext->GetDevice();
+        m_imageCount = m_vkContext->GetSwapchain()->GetImageCount();
+        m_elementCount = elementCount;
+        m_elementSize = elementSize;
+        m_elementVec4Count = (elementSize + 15) / 16;
+        m_elementStride = elementStride;
+
+        // deltas of an earlier Init refer to the old buffer and must not be scattered into the new one
+        m_pendingElementIndices.clear();
+        m_pendingDeltas.clear();
+        m_pendingDeltaIndices.assign(m_elementCount, s_invalidIndex);
+
+        // bound as storage buffer by the scatter shader and as dynamic uniform or storage buffer by the draws
+        VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), m_elementCount * m_elementStride,
+            vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eUniformBuffer, vk::MemoryPropertyFlagBits::eDeviceLocal,
+            m_buffer, m_bufferMemory);
+
+        ShaderCode scatterShaderCode = {};
+        scatterShaderCode.compute = Shader::ReadShaderCodeFromFile("assets/shaders/Vulkan/sceneBufferScatter.comp.spv");
+        m_scatterShader = RenderingAPI::CreateShader("sceneBufferScatter", scatterShaderCode);
+
+        std::vector<vk::DescriptorSetLayoutBinding> bindings;
+        for (uint32_t binding = 0; binding < 2; binding++)
+        {
+            vk::DescriptorSetLayoutBinding bufferLayoutBinding{};
+            bufferLayoutBinding.binding = binding;
+            bufferLayoutBinding.descriptorType = vk::DescriptorType::eStorageBuffer;
+            bufferLayoutBinding.descriptorCount = 1;
+            bufferLayoutBinding.stageFlags = vk::ShaderStageFlagBits::eCompute;
+            bufferLayoutBinding.pImmutableSamplers = nullptr;
+            bindings.push_back(bufferLayoutBinding);
+        }
+
+        vk::DescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+        descriptorSetLayoutCreateInfo.bindingCount = bindings.size();
+        descriptorSetLayoutCreateInfo.pBindings = bindings.data();
+
+        vk::Result result = m_device->GetHandle().createDescriptorSetLayout(&descriptorSetLayoutCreateInfo, nullptr, &m_descriptorSetLayout);
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor set layout!");
+
+        m_descriptorSets.resize(m_imageCount);
+        std::vector<vk::DescriptorSetLayout> descriptorSetLayouts(m_imageCount, m_descriptorSetLayout);
+        vk::DescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+        descriptorSetAllocateInfo.pNext = nullptr;
+        descriptorSetAllocateInfo.descriptorPool = m_vkContext->GetDescriptorPool();
+        descriptorSetAllocateInfo.descriptorSetCount = descriptorSetLayouts.size();
+        descriptorSetAllocateInfo.pSetLayouts = descriptorSetLayouts.data();
+        result = m_device->GetHandle().allocateDescriptorSets(&descriptorSetAllocateInfo, m_descriptorSets.data());
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to allocate Vulkan descriptor sets!");
+
+        vk::PushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = vk::ShaderStageFlagBits::eCompute;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(ScatterPushConstants);
+        m_pipelineLayout = VulkanUtils::CreatePipelineLayout({ m_descriptorSetLayout }, { pushConstantRange });
+        m_pipeline = VulkanUtils::CreateComputePipeline(m_pipelineLayout, std::dynamic_pointer_cast<VulkanShader>(m_scatterShader));
+
+        m_deltaBuffers.resize(m_imageCount);
+        m_deltaBufferMemories.resize(m_imageCount);
+        m_deltaCapacities.resize(m_imageCount);
+        for (uint32_t i = 0; i < m_imageCount; i++)
+        {
+            CreateDeltaBuffer(i, s_minDeltaCapacity);
+            UpdateDescriptorSet(i);
+        }
+    }
+
+    void VulkanSceneBuffer::Destroy()
+    {
+        for (uint32_t i = 0; i < m_imageCount; i++)
+            DestroyDeltaBuffer(i);
+
+        m_device->GetHandle().destroyPipeline(m_pipeline);
+        m_device->GetHandle().destroyPipelineLayout(m_pipelineLayout);
+        m_device->GetHandle().destroyDescriptorSetLayout(m_descriptorSetLayout);
+        m_scatterShader->Destroy();
+
+        m_device->GetHandle().destroyBuffer(m_buffer);
+        m_device->GetHandle().freeMemory(m_bufferMemory);
+    }
+
+    void VulkanSceneBuffer::Write(uint32_t elementIndex, const void* data)
+    {
+        FIREFLY_ASSERT(elementIndex < m_elementCount, "Scene buffer element index out of range: {0}", elementIndex);
+
+        size_t deltaSize = (m_elementVec4Count + 1) * 16;
+        uint32_t deltaIndex = m_pendingDeltaIndices[elementIndex];
+        if (deltaIndex == s_invalidIndex)
+        {
+            deltaIndex = static_cast<uint32_t>(m_pendingElementIndices.size());
+            m_pendingDeltaIndices[elementIndex] = deltaIndex;
+            m_pendingElementIndices.push_back(elementIndex);
+            m_pendingDeltas.resize(m_pendingDeltas.size() + deltaSize, 0);
+            memcpy(&m_pendingDeltas[deltaIndex * deltaSize], &elementIndex, sizeof(uint32_t));
+        }
+        memcpy(&m_pendingDeltas[deltaIndex * deltaSize + 16], data, m_elementSize);
+    }
+
+    void VulkanSceneBuffer::RecordUpload()
+    {
+        uint32_t deltaCount = static_cast<uint32_t>(m_pendingElementIndices.size());
+        if (deltaCount == 0)
+            return;
+
+        uint32_t currentImageIndex = m_vkContext->GetCurrentImageIndex();
+        vk::CommandBuffer commandBuffer = m_vkContext->GetCurrentCommandBuffer();
+
+        // the delta buffer of this image is not in use anymore once its command buffer is recorded again
+        if (deltaCount > m_deltaCapacities[currentImageIndex])
+        {
+            DestroyDeltaBuffer(currentImageIndex);
+            CreateDeltaBuffer(currentImageIndex, std::max(deltaCount, 2 * m_deltaCapacities[currentImageIndex]));
+            UpdateDescriptorSet(currentImageIndex);
+        }
+
+        void* mappedMemory;
+        m_device->GetHandle().mapMemory(m_deltaBufferMemories[currentImageIndex], 0, m_pendingDeltas.size(), {}, &mappedMemory);
+        memcpy(mappedMemory, m_pendingDeltas.data(), m_pendingDeltas.size());
+        m_device->GetHandle().unmapMemory(m_deltaBufferMemories[currentImageIndex]);
+
+        for (auto elementIndex : m_pendingElementIndices)
+            m_pendingDeltaIndices[elementIndex] = s_invalidIndex;
+        m_pendingElementIndices.clear();
+        m_pendingDeltas.clear();
+
+        // draws of previous frames may still read the elements that are overwritten now
+        vk::MemoryBarrier memoryBarrier{};
+        memoryBarrier.srcAccessMask = vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead;
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderWrite;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader, vk::PipelineStageFlagBits::eComputeShader, {},
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+        ScatterPushConstants pushConstants = {};
+        pushConstants.deltaCount = deltaCount;
+        pushConstants.elementVec4Count = m_elementVec4Count;
+        pushConstants.elementVec4Stride = static_cast<uint32_t>(m_elementStride / 16);
+
+        commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, m_pipeline);
+        commandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute, m_pipelineLayout, 0, 1, &m_descriptorSets[currentImageIndex], 0, nullptr);
+        commandBuffer.pushConstants(m_pipelineLayout, vk::ShaderStageFlagBits::eCompute, 0, sizeof(ScatterPushConstants), &pushConstants);
+        commandBuffer.dispatch((deltaCount * m_elementVec4Count + 63) / 64, 1, 1);
+
+        memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+        memoryBarrier.dstAccessMask = vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eShaderRead;
+        commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader, vk::PipelineStageFlagBits::eVertexShader | vk::PipelineStageFlagBits::eFragmentShader, {},
+            1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    }
+
+    vk::Buffer VulkanSceneBuffer::GetBuffer() const
+    {
+        return m_buffer;
+    }
+
+    void VulkanSceneBuffer::CreateDeltaBuffer(uint32_t imageIndex, uint32_t deltaCapacity)
+    {
+        m_deltaCapacities[imageIndex] = deltaCapacity;
+        VulkanUtils::CreateBuffer(m_device->GetHandle(), m_device->GetPhysicalDevice(), deltaCapacity * (m_elementVec4Count + 1) * 16,
+            vk::BufferUsageFlagBits::eStorageBuffer, vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+            m_deltaBuffers[imageIndex], m_deltaBufferMemories[imageIndex]);
+    }
+
+    void VulkanSceneBuffer::DestroyDeltaBuffer(uint32_t imageIndex)
+    {
+        m_device->GetHandle().destroyBuffer(m_deltaBuffers[imageIndex]);
+        m_device->GetHandle().freeMemory(m_deltaBufferMemories[imageIndex]);
+    }
+
+    void VulkanSceneBuffer::UpdateDescriptorSet(uint32_t imageIndex)
+    {
+        vk::DescriptorBufferInfo bufferInfos[] =
+        {
+            vk::DescriptorBufferInfo(m_deltaBuffers[imageIndex], 0, VK_WHOLE_SIZE),
+            vk::DescriptorBufferInfo(m_buffer, 0, VK_WHOLE_SIZE)
+        };
+
+        vk::WriteDescriptorSet writeDescriptorSet{};
+        writeDescriptorSet.dstSet = m_descriptorSets[imageIndex];
+        writeDescriptorSet.dstBinding = 0;
+        writeDescriptorSet.dstArrayElement = 0;
+        writeDescriptorSet.descriptorType = vk::DescriptorType::eStorageBuffer;
+        writeDescriptorSet.descriptorCount = std::size(bufferInfos);
+        writeDescriptorSet.pBufferInfo = bufferInfos;
+
+        m_device->GetHandle().updateDescriptorSets(1, &writeDescriptorSet, 0, nullptr);
+    }
+}
\ No newline at end of file
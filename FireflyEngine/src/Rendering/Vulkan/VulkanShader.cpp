@@ -25,6 +25,8 @@ namespace Firefly
             m_shaderStageCreateInfos.push_back(CreateShaderStage(shaderCode.geometry, vk::ShaderStageFlagBits::eGeometry));
         if (!shaderCode.fragment.empty())
             m_shaderStageCreateInfos.push_back(CreateShaderStage(shaderCode.fragment, vk::ShaderStageFlagBits::eFragment));
+        if (!shaderCode.compute.empty())
+            m_shaderStageCreateInfos.push_back(CreateShaderStage(shaderCode.compute, vk::ShaderStageFlagBits::eCompute));
     }
 
     void VulkanShader::Destroy()
@@ -86,7 +88,7 @@ namespace Firefly
         if (result != SPV_REFLECT_RESULT_SUCCESS) return;
 
 
-        Logger::Debug("SPIRV-Reflect", "-----------------------------------");
+        FIREFLY_LOG_DEBUG("SPIRV-Reflect", "-----------------------------------");
         // PRINT MODULE
         std::string shaderStageName = "";
         switch (module.shader_stage)
@@ -105,23 +107,23 @@ namespace Firefly
             shaderStageName = "Compute Shader"; break;
         }
 
-        Logger::Debug("SPIRV-Reflect", "{0} Module: {1} (v{2})", shaderStageName, spvReflectSourceLanguage(module.source_language), module.source_language_version);
+        FIREFLY_LOG_DEBUG("SPIRV-Reflect", "{0} Module: {1} (v{2})", shaderStageName, spvReflectSourceLanguage(module.source_language), module.source_language_version);
         // ---------------------------------
         // PRINT INPUT AND OUTPUT VARIABLES
         for (auto inputVariable : inputVariables)
         {
             if (inputVariable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN)
                 continue;
-            Logger::Debug("SPIRV-Reflect", "in (location = {0}) {1} {2}", inputVariable->location, GetDataTypeName(*inputVariable->type_description), inputVariable->name);
+            FIREFLY_LOG_DEBUG("SPIRV-Reflect", "in (location = {0}) {1} {2}", inputVariable->location, GetDataTypeName(*inputVariable->type_description), inputVariable->name);
         }
         for (auto outputVariable : outputVariables)
         {
             if (outputVariable->decoration_flags & SPV_REFLECT_DECORATION_BUILT_IN)
                 continue;
-            Logger::Debug("SPIRV-Reflect", "out (location = {0}) {1} {2}", outputVariable->location, GetDataTypeName(*outputVariable->type_description), outputVariable->name);
+            FIREFLY_LOG_DEBUG("SPIRV-Reflect", "out (location = {0}) {1} {2}", outputVariable->location, GetDataTypeName(*outputVariable->type_description), outputVariable->name);
         }
         // ---------------------------------
-        Logger::Debug("SPIRV-Reflect", "-----------------------------------");
+        FIREFLY_LOG_DEBUG("SPIRV-Reflect", "-----------------------------------");
 
         spvReflectDestroyShaderModule(&module);
     }
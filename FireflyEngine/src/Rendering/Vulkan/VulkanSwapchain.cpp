@@ -5,13 +5,13 @@
 
 namespace Firefly
 {
-    void VulkanSwapchain::Init(vk::Device device, vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, uint32_t width, uint32_t height)
+    void VulkanSwapchain::Init(vk::Device device, vk::PhysicalDevice physicalDevice, vk::SurfaceKHR surface, uint32_t width, uint32_t height, vk::PresentModeKHR presentMode)
     {
         m_device = device;
         m_physicalDevice = physicalDevice;
 
         m_swapchainData.imageCount = 2;
-        m_swapchainData.presentMode = vk::PresentModeKHR::eFifoRelaxed;
+        m_swapchainData.presentMode = presentMode;
         m_swapchainData.imageFormat = vk::Format::eR8G8B8A8Srgb;
         m_swapchainData.colorSpace = vk::ColorSpaceKHR::eSrgbNonlinear;
 
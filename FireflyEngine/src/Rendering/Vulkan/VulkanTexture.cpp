@@ -47,17 +47,17 @@ namespace Firefly
         return m_description.useSampler;
     }
 
-    void VulkanTexture::OnInit(void* pixelData)
+    void VulkanTexture::OnInit(void* pixelData, uint32_t pixelDataMipLevels)
     {
         m_format = ConvertToVulkanFormat(m_description.format);
 
-        CreateImage(pixelData);
+        CreateImage(pixelData, pixelDataMipLevels);
         CreateImageView();
         if (m_description.useSampler)
             CreateSampler();
     }
 
-    void VulkanTexture::CreateImage(void* pixelData)
+    void VulkanTexture::CreateImage(void* pixelData, uint32_t pixelDataMipLevels)
     {
         vk::ImageUsageFlags usage = vk::ImageUsageFlagBits::eSampled;
         if (pixelData)
@@ -87,8 +87,12 @@ namespace Firefly
             vk::ImageLayout newLayout = vk::ImageLayout::eTransferDstOptimal;
             TransitionImageLayout(m_image, oldLayout, newLayout, m_format, m_mipMapLevels, m_arrayLayers);
 
-            uint32_t bytePerPixel = GetBytePerPixel(m_description.format);
-            vk::DeviceSize bufferSize = m_description.width * m_description.height * m_arrayLayers * bytePerPixel;
+            // block compressed levels can not be blitted, they are only uploaded as a complete chain
+            FIREFLY_ASSERT(!IsCompressedFormat(m_description.format) || pixelDataMipLevels == m_mipMapLevels, "Block compressed Vulkan textures need pixel data of all {0} mip levels!", m_mipMapLevels);
+
+            vk::DeviceSize bufferSize = 0;
+            for (uint32_t level = 0; level < pixelDataMipLevels; level++)
+                bufferSize += GetImageByteSize(m_description.format, std::max(m_description.width >> level, 1u), std::max(m_description.height >> level, 1u)) * m_arrayLayers;
             vk::BufferUsageFlags usage = vk::BufferUsageFlagBits::eTransferSrc;
             vk::MemoryPropertyFlags memoryPropertyFlags = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
 
@@ -101,11 +105,12 @@ namespace Firefly
             memcpy(mappedMemory, pixelData, bufferSize);
             m_device.unmapMemory(stagingBufferMemory);
 
-            CopyBufferToImage(stagingBuffer, m_image, m_description.width, m_description.height, m_format, m_arrayLayers);
+            CopyBufferToImage(stagingBuffer, m_image, m_description.width, m_description.height, m_format, m_description.format, pixelDataMipLevels, m_arrayLayers);
 
             if (m_description.useSampler)
             {
-                if (m_description.sampler.isMipMappingEnabled)
+                // a complete chain from the loader needs no blits, all of its levels were copied at once
+                if (m_description.sampler.isMipMappingEnabled && pixelDataMipLevels < m_mipMapLevels)
                 {
                     // automatically transitions image layout into "eShaderReadOnlyOptimal"
                     GenerateMipMaps(m_image, m_description.width, m_description.height, m_format, m_mipMapLevels, m_arrayLayers);
@@ -169,7 +174,7 @@ namespace Firefly
         float maxAnisotropy = m_physicalDevice.getProperties().limits.maxSamplerAnisotropy;
         if (m_description.sampler.maxAnisotropy > maxAnisotropy)
         {
-            Logger::Warn("Vulkan", "Max. anisotropy ({0}) is bigger than the device limit ({1}).", m_description.sampler.maxAnisotropy, maxAnisotropy);
+            FIREFLY_LOG_WARN("Vulkan", "Max. anisotropy ({0}) is bigger than the device limit ({1}).", m_description.sampler.maxAnisotropy, maxAnisotropy);
             m_description.sampler.maxAnisotropy = maxAnisotropy;
         }
 
@@ -275,7 +280,7 @@ namespace Firefly
         vkBindImageMemory(device, image, imageMemory, 0);
     }
 
-    void VulkanTexture::CopyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height, vk::Format format, uint32_t arrayLayers)
+    void VulkanTexture::CopyBufferToImage(vk::Buffer buffer, vk::Image image, uint32_t width, uint32_t height, vk::Format format, Format textureFormat, uint32_t mipMapLevels, uint32_t arrayLayers)
     {
         std::shared_ptr<VulkanContext> vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
         vk::Device device = vkContext->GetDevice()->GetHandle();
@@ -284,17 +289,27 @@ namespace Firefly
 
         vk::CommandBuffer commandBuffer = VulkanUtils::BeginOneTimeCommandBuffer(device, commandPool);
 
-        vk::BufferImageCopy bufferImageCopy{};
-        bufferImageCopy.bufferOffset = 0;
-        bufferImageCopy.bufferRowLength = 0;
-        bufferImageCopy.bufferImageHeight = 0;
-        bufferImageCopy.imageSubresource.aspectMask = GetImageAspectFlags(format);
-        bufferImageCopy.imageSubresource.mipLevel = 0;
-        bufferImageCopy.imageSubresource.baseArrayLayer = 0;
-        bufferImageCopy.imageSubresource.layerCount = arrayLayers;
-        bufferImageCopy.imageOffset = { 0, 0, 0 };
-        bufferImageCopy.imageExtent = { width, height, 1 };
-        commandBuffer.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, 1, &bufferImageCopy);
+        // the levels are packed one after another in the buffer, each with all of its array layers
+        std::vector<vk::BufferImageCopy> bufferImageCopies(mipMapLevels);
+        vk::DeviceSize bufferOffset = 0;
+        for (uint32_t level = 0; level < mipMapLevels; level++)
+        {
+            uint32_t levelWidth = std::max(width >> level, 1u);
+            uint32_t levelHeight = std::max(height >> level, 1u);
+
+            vk::BufferImageCopy& bufferImageCopy = bufferImageCopies[level];
+            bufferImageCopy.bufferOffset = bufferOffset;
+            bufferImageCopy.bufferRowLength = 0;
+            bufferImageCopy.bufferImageHeight = 0;
+            bufferImageCopy.imageSubresource.aspectMask = GetImageAspectFlags(format);
+            bufferImageCopy.imageSubresource.mipLevel = level;
+            bufferImageCopy.imageSubresource.baseArrayLayer = 0;
+            bufferImageCopy.imageSubresource.layerCount = arrayLayers;
+            bufferImageCopy.imageOffset = { 0, 0, 0 };
+            bufferImageCopy.imageExtent = { levelWidth, levelHeight, 1 };
+            bufferOffset += GetImageByteSize(textureFormat, levelWidth, levelHeight) * arrayLayers;
+        }
+        commandBuffer.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, static_cast<uint32_t>(bufferImageCopies.size()), bufferImageCopies.data());
 
         VulkanUtils::EndCommandBuffer(device, commandBuffer, commandPool, queue);
     }
@@ -520,6 +535,24 @@ namespace Firefly
             return vk::Format::eR16G16B16A16Sfloat;
         case Format::RGBA_32_FLOAT:
             return vk::Format::eR32G32B32A32Sfloat;
+        case Format::BC1_RGBA:
+            return vk::Format::eBc1RgbaUnormBlock;
+        case Format::BC1_RGBA_NON_LINEAR:
+            return vk::Format::eBc1RgbaSrgbBlock;
+        case Format::BC3_RGBA:
+            return vk::Format::eBc3UnormBlock;
+        case Format::BC3_RGBA_NON_LINEAR:
+            return vk::Format::eBc3SrgbBlock;
+        case Format::BC4_R:
+            return vk::Format::eBc4UnormBlock;
+        case Format::BC5_RG:
+            return vk::Format::eBc5UnormBlock;
+        case Format::BC6H_RGB_FLOAT:
+            return vk::Format::eBc6HUfloatBlock;
+        case Format::BC7_RGBA:
+            return vk::Format::eBc7UnormBlock;
+        case Format::BC7_RGBA_NON_LINEAR:
+            return vk::Format::eBc7SrgbBlock;
         case Format::DEPTH_32_FLOAT:
             return vk::Format::eD32Sfloat;
         case Format::DEPTH_24_STENCIL_8:
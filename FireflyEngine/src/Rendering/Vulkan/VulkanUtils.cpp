@@ -102,18 +102,19 @@ namespace Firefly::VulkanUtils
             swapchainData.imageFormat = supportedSurfaceFormats[0].format;
         swapchainData.colorSpace = supportedSurfaceFormats[0].colorSpace;
 
-        bool isPresentModeSupported = false;
+        // immediate falls back to mailbox as the other mode without vsync wait, fifo is the only mode every device supports
         std::vector<vk::PresentModeKHR> surfacePresentModes = physicalDevice.getSurfacePresentModesKHR(surface);
-        for (const vk::PresentModeKHR& surfacePresentMode : surfacePresentModes)
-        {
-            if (swapchainData.presentMode == surfacePresentMode)
+        auto isPresentModeSupported = [&surfacePresentModes](vk::PresentModeKHR presentMode)
             {
-                isPresentModeSupported = true;
-                break;
-            }
+                return std::find(surfacePresentModes.begin(), surfacePresentModes.end(), presentMode) != surfacePresentModes.end();
+            };
+        if (!isPresentModeSupported(swapchainData.presentMode))
+        {
+            if (swapchainData.presentMode == vk::PresentModeKHR::eImmediate && isPresentModeSupported(vk::PresentModeKHR::eMailbox))
+                swapchainData.presentMode = vk::PresentModeKHR::eMailbox;
+            else
+                swapchainData.presentMode = vk::PresentModeKHR::eFifo;
         }
-        if (!isPresentModeSupported)
-            swapchainData.presentMode = vk::PresentModeKHR::eMailbox;
 
         vk::SwapchainCreateInfoKHR swapchainCreateInfo{};
         swapchainCreateInfo.pNext = nullptr;
@@ -141,6 +142,11 @@ namespace Firefly::VulkanUtils
     }
 
     vk::PipelineLayout CreatePipelineLayout(std::vector<vk::DescriptorSetLayout> descriptorSetLayouts)
+    {
+        return CreatePipelineLayout(descriptorSetLayouts, {});
+    }
+
+    vk::PipelineLayout CreatePipelineLayout(std::vector<vk::DescriptorSetLayout> descriptorSetLayouts, std::vector<vk::PushConstantRange> pushConstantRanges)
     {
         std::shared_ptr<VulkanContext> vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
         vk::Device device = vkContext->GetDevice()->GetHandle();
@@ -150,8 +156,8 @@ namespace Firefly::VulkanUtils
         pipelineLayoutCreateInfo.flags = {};
         pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayouts.size();
         pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts.data();
-        pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
-        pipelineLayoutCreateInfo.pPushConstantRanges = nullptr;
+        pipelineLayoutCreateInfo.pushConstantRangeCount = pushConstantRanges.size();
+        pipelineLayoutCreateInfo.pPushConstantRanges = pushConstantRanges.data();
 
         vk::PipelineLayout pipelineLayout;
         vk::Result result = device.createPipelineLayout(&pipelineLayoutCreateInfo, nullptr, &pipelineLayout);
@@ -318,6 +324,30 @@ namespace Firefly::VulkanUtils
         return pipeline;
     }
 
+    vk::Pipeline CreateComputePipeline(vk::PipelineLayout layout, std::shared_ptr<VulkanShader> shader)
+    {
+        std::shared_ptr<VulkanContext> vkContext = std::dynamic_pointer_cast<VulkanContext>(RenderingAPI::GetContext());
+        vk::Device device = vkContext->GetDevice()->GetHandle();
+
+        std::vector<vk::PipelineShaderStageCreateInfo> shaderStageCreateInfos = shader->GetShaderStageCreateInfos();
+        FIREFLY_ASSERT(shaderStageCreateInfos.size() == 1 && shaderStageCreateInfos[0].stage == vk::ShaderStageFlagBits::eCompute,
+            "Vulkan compute pipeline requires a shader with a single compute stage!");
+
+        vk::ComputePipelineCreateInfo pipelineCreateInfo{};
+        pipelineCreateInfo.pNext = nullptr;
+        pipelineCreateInfo.flags = {};
+        pipelineCreateInfo.stage = shaderStageCreateInfos[0];
+        pipelineCreateInfo.layout = layout;
+        pipelineCreateInfo.basePipelineHandle = nullptr;
+        pipelineCreateInfo.basePipelineIndex = -1;
+
+        vk::Pipeline pipeline;
+        vk::Result result = device.createComputePipelines(nullptr, 1, &pipelineCreateInfo, nullptr, &pipeline);
+        FIREFLY_ASSERT(result == vk::Result::eSuccess, "Unable to create Vulkan compute pipeline!");
+
+        return pipeline;
+    }
+
     vk::CommandBuffer BeginOneTimeCommandBuffer(vk::Device device, vk::CommandPool commandPool)
     {
         vk::CommandBufferAllocateInfo commandBufferAllocateInfo{};
@@ -79,6 +79,10 @@ namespace Firefly
     {
         return m_projectionMatrix;
     }
+    Frustum Camera::GetFrustum() const
+    {
+        return Frustum(m_projectionMatrix * m_viewMatrix);
+    }
     glm::vec3 Camera::GetPosition() const
     {
         return m_position;
@@ -4,13 +4,7 @@
 
 namespace Firefly
 {
-    Entity::Entity(const Entity& entity) :
-        m_entityRegistry(entity.m_entityRegistry),
-        m_id(entity.m_id)
-    {
-    }
-
-    Entity::Entity(std::shared_ptr<entt::registry> entityRegistry, entt::entity id) :
+    Entity::Entity(entt::registry* entityRegistry, entt::entity id) :
         m_entityRegistry(entityRegistry),
         m_id(id)
     {
@@ -19,18 +13,19 @@ namespace Firefly
     }
 
     Entity::Entity(std::shared_ptr<Scene> scene) :
-        m_entityRegistry(scene->m_entityRegistry),
+        m_entityRegistry(scene->m_entityRegistry.get()),
         m_id(entt::null)
     {
         m_id = m_entityRegistry->create();
     }
 
-    Entity::~Entity()
+    void Entity::RemoveFromScene()
     {
+        m_entityRegistry->destroy(m_id);
     }
 
-    void Entity::RemoveFromScene()
+    entt::entity Entity::GetId() const
     {
-        m_entityRegistry->destroy(m_id);
+        return m_id;
     }
 }
\ No newline at end of file
@@ -1,26 +1,54 @@
 #include "Scene/Scene.h"
 
 #include "Rendering/RenderingAPI.h"
+#include "Scene/Components/MeshComponent.h"
 
 namespace Firefly
 {
     Scene::Scene()
     {
         m_entityRegistry = std::make_shared<entt::registry>();
+        m_spatialIndex = std::make_unique<SceneSpatialIndex>(m_entityRegistry);
+        m_transformHierarchy = std::make_unique<TransformHierarchy>(m_entityRegistry);
     }
 
     Scene::~Scene()
     {
+        m_spatialIndex.reset();
+        m_transformHierarchy.reset();
         m_entityRegistry->clear();
     }
 
-    std::vector<Entity> Scene::GetEntities()
+    Entity Scene::GetEntity(entt::entity id)
     {
-        std::vector<Entity> entities;
-        m_entityRegistry->each([this, &entities](auto entityId)
-            {
-                entities.push_back(Entity(m_entityRegistry, entityId));
-            });
-        return entities;
+        return Entity(m_entityRegistry.get(), id);
+    }
+
+    SceneSpatialIndex& Scene::GetSpatialIndex()
+    {
+        return *m_spatialIndex;
+    }
+
+    TransformHierarchy& Scene::GetTransformHierarchy()
+    {
+        return *m_transformHierarchy;
+    }
+
+    void Scene::RefreshMeshes(const std::vector<MeshHandle>& meshes)
+    {
+        if (meshes.empty())
+            return;
+
+        // collected first, patching fires the signals of the pool that is iterated
+        std::vector<entt::entity> entities;
+        auto view = m_entityRegistry->view<MeshComponent>();
+        for (auto entity : view)
+        {
+            if (std::find(meshes.begin(), meshes.end(), view.get<MeshComponent>(entity).m_mesh) != meshes.end())
+                entities.push_back(entity);
+        }
+
+        for (auto entity : entities)
+            m_entityRegistry->patch<MeshComponent>(entity, [](auto& meshComponent) {});
     }
 }
\ No newline at end of file
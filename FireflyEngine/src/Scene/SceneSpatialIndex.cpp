@@ -0,0 +1,567 @@
+#include "pch.h"
+#include "Scene/SceneSpatialIndex.h"
+
+#include "Core/ResourceRegistry.h"
+#include "Scene/Components/TransformComponent.h"
+#include "Scene/Components/MeshComponent.h"
+
+#include <queue>
+
+namespace Firefly
+{
+    static bool IntersectRay(const BoundingBox& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance, float& distance)
+    {
+        float tNear = 0.f;
+        float tFar = maxDistance;
+        for (int axis = 0; axis < 3; axis++)
+        {
+            // a ray parallel to the slab only hits from inside of it, 0 * inf would turn the slab distances into NaN
+            if (std::isinf(inverseDirection[axis]))
+            {
+                if (origin[axis] < box.m_min[axis] || origin[axis] > box.m_max[axis])
+                    return false;
+                continue;
+            }
+
+            float t1 = (box.m_min[axis] - origin[axis]) * inverseDirection[axis];
+            float t2 = (box.m_max[axis] - origin[axis]) * inverseDirection[axis];
+            tNear = std::max(tNear, std::min(t1, t2));
+            tFar = std::min(tFar, std::max(t1, t2));
+        }
+
+        if (tNear > tFar)
+            return false;
+
+        distance = tNear;
+        return true;
+    }
+
+    SceneSpatialIndex::SceneSpatialIndex(std::shared_ptr<entt::registry> entityRegistry, float fatMargin) :
+        m_entityRegistry(entityRegistry),
+        m_fatMargin(fatMargin)
+    {
+        m_entityRegistry->on_construct<TransformComponent>().connect<&SceneSpatialIndex::OnBoundsChanged>(*this);
+        m_entityRegistry->on_update<TransformComponent>().connect<&SceneSpatialIndex::OnBoundsChanged>(*this);
+        m_entityRegistry->on_destroy<TransformComponent>().connect<&SceneSpatialIndex::OnBoundsRemoved>(*this);
+        m_entityRegistry->on_construct<MeshComponent>().connect<&SceneSpatialIndex::OnBoundsChanged>(*this);
+        m_entityRegistry->on_update<MeshComponent>().connect<&SceneSpatialIndex::OnBoundsChanged>(*this);
+        m_entityRegistry->on_destroy<MeshComponent>().connect<&SceneSpatialIndex::OnBoundsRemoved>(*this);
+
+        for (auto entity : m_entityRegistry->view<TransformComponent, MeshComponent>())
+            MarkDirty(entity);
+    }
+
+    SceneSpatialIndex::~SceneSpatialIndex()
+    {
+        m_entityRegistry->on_construct<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_update<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_construct<MeshComponent>().disconnect(this);
+        m_entityRegistry->on_update<MeshComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<MeshComponent>().disconnect(this);
+    }
+
+    void SceneSpatialIndex::Update()
+    {
+        if (m_dirtyEntities.empty())
+            return;
+
+        std::sort(m_dirtyEntities.begin(), m_dirtyEntities.end());
+        m_dirtyEntities.erase(std::unique(m_dirtyEntities.begin(), m_dirtyEntities.end()), m_dirtyEntities.end());
+
+        for (auto entity : m_dirtyEntities)
+        {
+            auto proxy = m_proxies.find(entity);
+
+            BoundingBox box;
+            if (CalculateBoundingBox(entity, box))
+            {
+                if (proxy == m_proxies.end())
+                    m_proxies[entity] = CreateProxy(entity, box);
+                else
+                    MoveProxy(proxy->second, box);
+            }
+            else if (proxy != m_proxies.end())
+            {
+                DestroyProxy(proxy->second);
+                m_proxies.erase(proxy);
+            }
+        }
+        m_dirtyEntities.clear();
+    }
+
+    void SceneSpatialIndex::MarkDirty(entt::entity entity)
+    {
+        m_dirtyEntities.push_back(entity);
+    }
+
+    void SceneSpatialIndex::QueryFrustum(const Frustum& frustum, std::vector<entt::entity>& result) const
+    {
+        if (m_root == s_nullNode)
+            return;
+
+        // nodes fully inside the frustum accept their whole subtree without further plane tests
+        thread_local std::vector<std::pair<int32_t, bool>> stack;
+        stack.clear();
+        stack.push_back({ m_root, false });
+        while (!stack.empty())
+        {
+            auto [nodeIndex, isInside] = stack.back();
+            stack.pop_back();
+
+            const Node& node = m_nodes[nodeIndex];
+            if (!isInside)
+            {
+                if (!frustum.Intersects(node.fatBox))
+                    continue;
+                isInside = frustum.Contains(node.fatBox);
+            }
+
+            if (node.IsLeaf())
+            {
+                if (isInside || frustum.Intersects(node.box))
+                    result.push_back(node.entity);
+            }
+            else
+            {
+                stack.push_back({ node.child1, isInside });
+                stack.push_back({ node.child2, isInside });
+            }
+        }
+    }
+
+    void SceneSpatialIndex::QueryBox(const BoundingBox& box, std::vector<entt::entity>& result) const
+    {
+        Traverse([&box](const BoundingBox& nodeBox) { return box.Intersects(nodeBox); },
+            [&box, &result](const Node& leaf)
+            {
+                if (box.Intersects(leaf.box))
+                    result.push_back(leaf.entity);
+            });
+    }
+
+    void SceneSpatialIndex::QuerySphere(const glm::vec3& center, float radius, std::vector<entt::entity>& result) const
+    {
+        float radiusSquared = radius * radius;
+        Traverse([&center, radiusSquared](const BoundingBox& nodeBox) { return nodeBox.GetDistanceSquared(center) <= radiusSquared; },
+            [&center, radiusSquared, &result](const Node& leaf)
+            {
+                if (leaf.box.GetDistanceSquared(center) <= radiusSquared)
+                    result.push_back(leaf.entity);
+            });
+    }
+
+    void SceneSpatialIndex::QueryNearest(const glm::vec3& point, uint32_t count, std::vector<entt::entity>& result) const
+    {
+        if (m_root == s_nullNode || count == 0)
+            return;
+
+        // best first search, inner nodes are keyed by their fat box (a lower bound) and leaves by their exact box
+        using Candidate = std::pair<float, int32_t>;
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> candidates;
+        auto pushCandidate = [this, &point, &candidates](int32_t nodeIndex)
+        {
+            const Node& node = m_nodes[nodeIndex];
+            candidates.push({ node.IsLeaf() ? node.box.GetDistanceSquared(point) : node.fatBox.GetDistanceSquared(point), nodeIndex });
+        };
+
+        uint32_t foundCount = 0;
+        pushCandidate(m_root);
+        while (!candidates.empty() && foundCount < count)
+        {
+            int32_t nodeIndex = candidates.top().second;
+            candidates.pop();
+
+            const Node& node = m_nodes[nodeIndex];
+            if (node.IsLeaf())
+            {
+                result.push_back(node.entity);
+                foundCount++;
+            }
+            else
+            {
+                pushCandidate(node.child1);
+                pushCandidate(node.child2);
+            }
+        }
+    }
+
+    bool SceneSpatialIndex::RayCast(const Ray& ray, float maxDistance, RayHit& hit) const
+    {
+        if (m_root == s_nullNode)
+            return false;
+
+        glm::vec3 direction = glm::normalize(ray.direction);
+        glm::vec3 inverseDirection = 1.f / direction;
+
+        bool hasHit = false;
+        float closestDistance = maxDistance;
+
+        thread_local std::vector<int32_t> stack;
+        stack.clear();
+        stack.push_back(m_root);
+        while (!stack.empty())
+        {
+            int32_t nodeIndex = stack.back();
+            stack.pop_back();
+
+            const Node& node = m_nodes[nodeIndex];
+            float distance;
+            if (!IntersectRay(node.fatBox, ray.origin, inverseDirection, closestDistance, distance))
+                continue;
+
+            if (node.IsLeaf())
+            {
+                if (IntersectRay(node.box, ray.origin, inverseDirection, closestDistance, distance))
+                {
+                    hasHit = true;
+                    closestDistance = distance;
+                    hit.entity = node.entity;
+                    hit.distance = distance;
+                }
+            }
+            else
+            {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+
+        return hasHit;
+    }
+
+    bool SceneSpatialIndex::GetBoundingBox(entt::entity entity, BoundingBox& box) const
+    {
+        auto proxy = m_proxies.find(entity);
+        if (proxy == m_proxies.end())
+            return false;
+
+        box = m_nodes[proxy->second].box;
+        return true;
+    }
+
+    uint32_t SceneSpatialIndex::GetProxyCount() const
+    {
+        return m_proxyCount;
+    }
+
+    int32_t SceneSpatialIndex::GetHeight() const
+    {
+        return m_root == s_nullNode ? 0 : m_nodes[m_root].height;
+    }
+
+    void SceneSpatialIndex::OnBoundsChanged(entt::registry& registry, entt::entity entity)
+    {
+        MarkDirty(entity);
+    }
+
+    void SceneSpatialIndex::OnBoundsRemoved(entt::registry& registry, entt::entity entity)
+    {
+        auto proxy = m_proxies.find(entity);
+        if (proxy != m_proxies.end())
+        {
+            DestroyProxy(proxy->second);
+            m_proxies.erase(proxy);
+        }
+    }
+
+    bool SceneSpatialIndex::CalculateBoundingBox(entt::entity entity, BoundingBox& box) const
+    {
+        if (!m_entityRegistry->valid(entity) || !m_entityRegistry->has<TransformComponent, MeshComponent>(entity))
+            return false;
+
+        auto [transformComponent, meshComponent] = m_entityRegistry->get<TransformComponent, MeshComponent>(entity);
+        const Mesh* mesh = MeshRegistry::Instance().Get(meshComponent.m_mesh);
+        if (!mesh || !mesh->GetBoundingBox().IsValid())
+            return false;
+
+        box = mesh->GetBoundingBox().Transformed(transformComponent.m_transform);
+        return true;
+    }
+
+    int32_t SceneSpatialIndex::AllocateNode()
+    {
+        if (m_freeList == s_nullNode)
+        {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        int32_t nodeIndex = m_freeList;
+        m_freeList = m_nodes[nodeIndex].parent;
+        m_nodes[nodeIndex] = Node();
+        return nodeIndex;
+    }
+
+    void SceneSpatialIndex::FreeNode(int32_t nodeIndex)
+    {
+        m_nodes[nodeIndex].parent = m_freeList;
+        m_nodes[nodeIndex].height = -1;
+        m_freeList = nodeIndex;
+    }
+
+    int32_t SceneSpatialIndex::CreateProxy(entt::entity entity, const BoundingBox& box)
+    {
+        int32_t proxyIndex = AllocateNode();
+        Node& node = m_nodes[proxyIndex];
+        node.box = box;
+        node.fatBox = box.Inflated(m_fatMargin);
+        node.entity = entity;
+        node.height = 0;
+
+        InsertLeaf(proxyIndex);
+        m_proxyCount++;
+        return proxyIndex;
+    }
+
+    void SceneSpatialIndex::DestroyProxy(int32_t proxyIndex)
+    {
+        RemoveLeaf(proxyIndex);
+        FreeNode(proxyIndex);
+        m_proxyCount--;
+    }
+
+    void SceneSpatialIndex::MoveProxy(int32_t proxyIndex, const BoundingBox& box)
+    {
+        Node& node = m_nodes[proxyIndex];
+
+        // the fat box still encloses the new box and has not grown too large after a shrink, the tree stays untouched
+        if (node.fatBox.Contains(box) && box.Inflated(4.f * m_fatMargin).Contains(node.fatBox))
+        {
+            node.box = box;
+            return;
+        }
+
+        RemoveLeaf(proxyIndex);
+        m_nodes[proxyIndex].box = box;
+        m_nodes[proxyIndex].fatBox = box.Inflated(m_fatMargin);
+        InsertLeaf(proxyIndex);
+    }
+
+    void SceneSpatialIndex::InsertLeaf(int32_t leafIndex)
+    {
+        if (m_root == s_nullNode)
+        {
+            m_root = leafIndex;
+            m_nodes[m_root].parent = s_nullNode;
+            return;
+        }
+
+        // find the best sibling with the surface area heuristic
+        BoundingBox leafBox = m_nodes[leafIndex].fatBox;
+        int32_t index = m_root;
+        while (!m_nodes[index].IsLeaf())
+        {
+            const Node& node = m_nodes[index];
+
+            float area = node.fatBox.GetSurfaceArea();
+            float combinedArea = BoundingBox::Merge(node.fatBox, leafBox).GetSurfaceArea();
+
+            float cost = 2.f * combinedArea;
+            float inheritanceCost = 2.f * (combinedArea - area);
+
+            auto descendCost = [this, &leafBox, inheritanceCost](int32_t childIndex)
+            {
+                const Node& child = m_nodes[childIndex];
+                float mergedArea = BoundingBox::Merge(leafBox, child.fatBox).GetSurfaceArea();
+                if (child.IsLeaf())
+                    return mergedArea + inheritanceCost;
+                return mergedArea - child.fatBox.GetSurfaceArea() + inheritanceCost;
+            };
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2)
+                break;
+
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        int32_t siblingIndex = index;
+        int32_t oldParentIndex = m_nodes[siblingIndex].parent;
+        int32_t newParentIndex = AllocateNode();
+
+        Node& newParent = m_nodes[newParentIndex];
+        newParent.parent = oldParentIndex;
+        newParent.fatBox = BoundingBox::Merge(leafBox, m_nodes[siblingIndex].fatBox);
+        newParent.height = m_nodes[siblingIndex].height + 1;
+        newParent.child1 = siblingIndex;
+        newParent.child2 = leafIndex;
+
+        if (oldParentIndex != s_nullNode)
+        {
+            if (m_nodes[oldParentIndex].child1 == siblingIndex)
+                m_nodes[oldParentIndex].child1 = newParentIndex;
+            else
+                m_nodes[oldParentIndex].child2 = newParentIndex;
+        }
+        else
+        {
+            m_root = newParentIndex;
+        }
+        m_nodes[siblingIndex].parent = newParentIndex;
+        m_nodes[leafIndex].parent = newParentIndex;
+
+        RefitAncestors(m_nodes[leafIndex].parent);
+    }
+
+    void SceneSpatialIndex::RemoveLeaf(int32_t leafIndex)
+    {
+        if (leafIndex == m_root)
+        {
+            m_root = s_nullNode;
+            return;
+        }
+
+        int32_t parentIndex = m_nodes[leafIndex].parent;
+        int32_t grandParentIndex = m_nodes[parentIndex].parent;
+        int32_t siblingIndex = m_nodes[parentIndex].child1 == leafIndex ? m_nodes[parentIndex].child2 : m_nodes[parentIndex].child1;
+
+        if (grandParentIndex != s_nullNode)
+        {
+            if (m_nodes[grandParentIndex].child1 == parentIndex)
+                m_nodes[grandParentIndex].child1 = siblingIndex;
+            else
+                m_nodes[grandParentIndex].child2 = siblingIndex;
+            m_nodes[siblingIndex].parent = grandParentIndex;
+            FreeNode(parentIndex);
+
+            RefitAncestors(grandParentIndex);
+        }
+        else
+        {
+            m_root = siblingIndex;
+            m_nodes[siblingIndex].parent = s_nullNode;
+            FreeNode(parentIndex);
+        }
+    }
+
+    void SceneSpatialIndex::RefitAncestors(int32_t nodeIndex)
+    {
+        while (nodeIndex != s_nullNode)
+        {
+            nodeIndex = Balance(nodeIndex);
+
+            Node& node = m_nodes[nodeIndex];
+            const Node& child1 = m_nodes[node.child1];
+            const Node& child2 = m_nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            node.fatBox = BoundingBox::Merge(child1.fatBox, child2.fatBox);
+
+            nodeIndex = node.parent;
+        }
+    }
+
+    // rotates the taller grandchild subtree up if the node is imbalanced, returns the new subtree root
+    int32_t SceneSpatialIndex::Balance(int32_t indexA)
+    {
+        Node& a = m_nodes[indexA];
+        if (a.IsLeaf() || a.height < 2)
+            return indexA;
+
+        int32_t indexB = a.child1;
+        int32_t indexC = a.child2;
+        Node& b = m_nodes[indexB];
+        Node& c = m_nodes[indexC];
+
+        int32_t balance = c.height - b.height;
+
+        // rotate c up
+        if (balance > 1)
+        {
+            int32_t indexF = c.child1;
+            int32_t indexG = c.child2;
+            Node& f = m_nodes[indexF];
+            Node& g = m_nodes[indexG];
+
+            c.child1 = indexA;
+            c.parent = a.parent;
+            a.parent = indexC;
+
+            if (c.parent != s_nullNode)
+            {
+                if (m_nodes[c.parent].child1 == indexA)
+                    m_nodes[c.parent].child1 = indexC;
+                else
+                    m_nodes[c.parent].child2 = indexC;
+            }
+            else
+            {
+                m_root = indexC;
+            }
+
+            if (f.height > g.height)
+            {
+                c.child2 = indexF;
+                a.child2 = indexG;
+                g.parent = indexA;
+                a.fatBox = BoundingBox::Merge(b.fatBox, g.fatBox);
+                c.fatBox = BoundingBox::Merge(a.fatBox, f.fatBox);
+                a.height = 1 + std::max(b.height, g.height);
+                c.height = 1 + std::max(a.height, f.height);
+            }
+            else
+            {
+                c.child2 = indexG;
+                a.child2 = indexF;
+                f.parent = indexA;
+                a.fatBox = BoundingBox::Merge(b.fatBox, f.fatBox);
+                c.fatBox = BoundingBox::Merge(a.fatBox, g.fatBox);
+                a.height = 1 + std::max(b.height, f.height);
+                c.height = 1 + std::max(a.height, g.height);
+            }
+
+            return indexC;
+        }
+
+        // rotate b up
+        if (balance < -1)
+        {
+            int32_t indexD = b.child1;
+            int32_t indexE = b.child2;
+            Node& d = m_nodes[indexD];
+            Node& e = m_nodes[indexE];
+
+            b.child1 = indexA;
+            b.parent = a.parent;
+            a.parent = indexB;
+
+            if (b.parent != s_nullNode)
+            {
+                if (m_nodes[b.parent].child1 == indexA)
+                    m_nodes[b.parent].child1 = indexB;
+                else
+                    m_nodes[b.parent].child2 = indexB;
+            }
+            else
+            {
+                m_root = indexB;
+            }
+
+            if (d.height > e.height)
+            {
+                b.child2 = indexD;
+                a.child1 = indexE;
+                e.parent = indexA;
+                a.fatBox = BoundingBox::Merge(c.fatBox, e.fatBox);
+                b.fatBox = BoundingBox::Merge(a.fatBox, d.fatBox);
+                a.height = 1 + std::max(c.height, e.height);
+                b.height = 1 + std::max(a.height, d.height);
+            }
+            else
+            {
+                b.child2 = indexE;
+                a.child1 = indexD;
+                d.parent = indexA;
+                a.fatBox = BoundingBox::Merge(c.fatBox, d.fatBox);
+                b.fatBox = BoundingBox::Merge(a.fatBox, e.fatBox);
+                a.height = 1 + std::max(c.height, d.height);
+                b.height = 1 + std::max(a.height, e.height);
+            }
+
+            return indexB;
+        }
+
+        return indexA;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,186 @@
+#include "pch.h"
+#include "Scene/SystemScheduler.h"
+
+#include "Core/ThreadPool.h"
+
+namespace Firefly
+{
+    // pool threads are numbered on their first system, the thread calling Run is worker 0
+    static uint32_t GetPoolWorkerIndex()
+    {
+        static std::atomic<uint32_t> s_workerCount = 0;
+        thread_local uint32_t workerIndex = ++s_workerCount;
+        return workerIndex;
+    }
+
+    SystemScheduler::~SystemScheduler()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_pendingTaskCount == 0; });
+    }
+
+    void SystemScheduler::Run(float deltaTime)
+    {
+        if (m_systems.empty())
+            return;
+
+        BuildGraph();
+        m_trace.resize(m_systems.size());
+
+        uint64_t runIndex;
+        size_t readySystemCount;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            runIndex = ++m_runIndex;
+            m_deltaTime = deltaTime;
+            m_doneSystemCount = 0;
+            m_readySystems.clear();
+            m_remainingPredecessorCounts = m_predecessorCounts;
+            // pushed in reverse, so systems without dependencies start in the order they were added
+            for (size_t i = m_systems.size(); i-- > 0;)
+            {
+                if (m_predecessorCounts[i] == 0)
+                    m_readySystems.push_back(i);
+            }
+            readySystemCount = m_readySystems.size();
+            m_runStartTime = std::chrono::steady_clock::now();
+        }
+
+        // the first ready system is left to the calling thread, which keeps taking systems until the run is done,
+        // so a thread pool without free workers still runs everything
+        SubmitReadySystems(runIndex, readySystemCount - 1);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_condition.wait(lock, [this]() { return !m_readySystems.empty() || m_doneSystemCount == m_systems.size(); });
+            if (m_doneSystemCount == m_systems.size())
+                return;
+
+            lock.unlock();
+            RunReadySystem(runIndex, 0);
+            lock.lock();
+        }
+    }
+
+    const std::vector<SystemScheduler::TraceEntry>& SystemScheduler::GetTrace() const
+    {
+        return m_trace;
+    }
+
+    void SystemScheduler::LogTrace() const
+    {
+        for (size_t i = 0; i < m_trace.size(); i++)
+        {
+            std::string overlappingSystems;
+            for (size_t j = 0; j < m_trace.size(); j++)
+            {
+                if (i != j && m_trace[i].startTime < m_trace[j].endTime && m_trace[j].startTime < m_trace[i].endTime)
+                    overlappingSystems += (overlappingSystems.empty() ? "" : ", ") + m_trace[j].systemName;
+            }
+
+            FIREFLY_LOG_INFO("SystemScheduler", "{0}: worker {1}, {2:.3f} - {3:.3f} ms, overlapped with: {4}",
+                m_trace[i].systemName, m_trace[i].workerIndex, m_trace[i].startTime, m_trace[i].endTime,
+                overlappingSystems.empty() ? "-" : overlappingSystems);
+        }
+    }
+
+    bool SystemScheduler::ContainsAny(const std::vector<entt::id_type>& typeIds, const std::vector<entt::id_type>& otherTypeIds)
+    {
+        for (auto typeId : typeIds)
+        {
+            if (std::find(otherTypeIds.begin(), otherTypeIds.end(), typeId) != otherTypeIds.end())
+                return true;
+        }
+        return false;
+    }
+
+    bool SystemScheduler::IsConflicting(const System& system, const System& otherSystem) const
+    {
+        return ContainsAny(system.writeTypeIds, otherSystem.writeTypeIds)
+            || ContainsAny(system.writeTypeIds, otherSystem.readTypeIds)
+            || ContainsAny(system.readTypeIds, otherSystem.writeTypeIds);
+    }
+
+    void SystemScheduler::BuildGraph()
+    {
+        // a system depends on every earlier system it conflicts with, which keeps the result of a serial run
+        m_successors.assign(m_systems.size(), {});
+        m_predecessorCounts.assign(m_systems.size(), 0);
+        for (size_t i = 0; i < m_systems.size(); i++)
+        {
+            for (size_t j = i + 1; j < m_systems.size(); j++)
+            {
+                if (IsConflicting(m_systems[i], m_systems[j]))
+                {
+                    m_successors[i].push_back(j);
+                    m_predecessorCounts[j]++;
+                }
+            }
+        }
+    }
+
+    void SystemScheduler::RunReadySystem(uint64_t runIndex, uint32_t workerIndex)
+    {
+        size_t systemIndex;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (runIndex != m_runIndex || m_readySystems.empty())
+                return;
+
+            systemIndex = m_readySystems.back();
+            m_readySystems.pop_back();
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+        m_systems[systemIndex].func(m_deltaTime);
+        auto endTime = std::chrono::steady_clock::now();
+
+        TraceEntry& traceEntry = m_trace[systemIndex];
+        traceEntry.systemName = m_systems[systemIndex].name;
+        traceEntry.workerIndex = workerIndex;
+        traceEntry.startTime = std::chrono::duration<float, std::milli>(startTime - m_runStartTime).count();
+        traceEntry.endTime = std::chrono::duration<float, std::milli>(endTime - m_runStartTime).count();
+
+        size_t readySystemCount = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t successor : m_successors[systemIndex])
+            {
+                if (--m_remainingPredecessorCounts[successor] == 0)
+                {
+                    m_readySystems.push_back(successor);
+                    readySystemCount++;
+                }
+            }
+            m_doneSystemCount++;
+            m_condition.notify_all();
+        }
+
+        // one task per system, the calling thread of Run may take some of them first
+        SubmitReadySystems(runIndex, readySystemCount);
+    }
+
+    void SystemScheduler::SubmitReadySystems(uint64_t runIndex, size_t readySystemCount)
+    {
+        if (readySystemCount == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pendingTaskCount += static_cast<uint32_t>(readySystemCount);
+        }
+
+        for (size_t i = 0; i < readySystemCount; i++)
+        {
+            ThreadPool::Instance().Submit([this, runIndex]()
+                {
+                    RunReadySystem(runIndex, GetPoolWorkerIndex());
+
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_pendingTaskCount--;
+                    m_condition.notify_all();
+                });
+        }
+    }
+}
\ No newline at end of file
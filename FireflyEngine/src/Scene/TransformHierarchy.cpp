@@ -0,0 +1,360 @@
+#include "pch.h"
+#include "Scene/TransformHierarchy.h"
+
+#include "Core/ThreadPool.h"
+#include "Scene/Components/TransformComponent.h"
+#include "Scene/Components/HierarchyComponent.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define FIREFLY_TRANSFORM_SSE
+#endif
+
+namespace Firefly
+{
+    TransformHierarchy::TransformHierarchy(std::shared_ptr<entt::registry> entityRegistry) :
+        m_entityRegistry(entityRegistry)
+    {
+        m_entityRegistry->on_construct<TransformComponent>().connect<&TransformHierarchy::OnNodesChanged>(*this);
+        m_entityRegistry->on_update<TransformComponent>().connect<&TransformHierarchy::OnTransformChanged>(*this);
+        m_entityRegistry->on_destroy<TransformComponent>().connect<&TransformHierarchy::OnNodesChanged>(*this);
+        m_entityRegistry->on_destroy<HierarchyComponent>().connect<&TransformHierarchy::OnHierarchyRemoved>(*this);
+    }
+
+    TransformHierarchy::~TransformHierarchy()
+    {
+        m_entityRegistry->on_construct<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_update<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<TransformComponent>().disconnect(this);
+        m_entityRegistry->on_destroy<HierarchyComponent>().disconnect(this);
+    }
+
+    void TransformHierarchy::SetParent(entt::entity child, entt::entity parent)
+    {
+        FIREFLY_ASSERT(m_entityRegistry->has<TransformComponent>(child), "Transform hierarchy child needs a TransformComponent!");
+        if (parent != entt::null)
+        {
+            FIREFLY_ASSERT(m_entityRegistry->has<TransformComponent>(parent), "Transform hierarchy parent needs a TransformComponent!");
+            for (entt::entity ancestor = parent; ancestor != entt::null; ancestor = GetParent(ancestor))
+                FIREFLY_ASSERT(ancestor != child, "Transform hierarchy must not contain cycles!");
+        }
+
+        if (GetParent(child) == parent)
+            return;
+
+        // emplace both first, emplacing can move the components of the other
+        m_entityRegistry->get_or_emplace<HierarchyComponent>(child);
+        if (parent != entt::null)
+            m_entityRegistry->get_or_emplace<HierarchyComponent>(parent);
+
+        Unlink(child);
+        if (parent != entt::null)
+        {
+            auto& childHierarchy = m_entityRegistry->get<HierarchyComponent>(child);
+            auto& parentHierarchy = m_entityRegistry->get<HierarchyComponent>(parent);
+            childHierarchy.m_parent = parent;
+            childHierarchy.m_nextSibling = parentHierarchy.m_firstChild;
+            if (parentHierarchy.m_firstChild != entt::null)
+                m_entityRegistry->get<HierarchyComponent>(parentHierarchy.m_firstChild).m_previousSibling = child;
+            parentHierarchy.m_firstChild = child;
+        }
+
+        m_areNodesDirty = true;
+    }
+
+    entt::entity TransformHierarchy::GetParent(entt::entity entity) const
+    {
+        const auto* hierarchy = m_entityRegistry->try_get<HierarchyComponent>(entity);
+        return hierarchy ? hierarchy->m_parent : entt::null;
+    }
+
+    void TransformHierarchy::GetChildren(entt::entity entity, std::vector<entt::entity>& children) const
+    {
+        const auto* hierarchy = m_entityRegistry->try_get<HierarchyComponent>(entity);
+        if (!hierarchy)
+            return;
+
+        for (entt::entity child = hierarchy->m_firstChild; child != entt::null; child = m_entityRegistry->get<HierarchyComponent>(child).m_nextSibling)
+            children.push_back(child);
+    }
+
+    void TransformHierarchy::Update()
+    {
+        if (m_areNodesDirty)
+        {
+            RebuildNodes();
+            m_areNodesDirty = false;
+        }
+        else
+        {
+            if (m_changedEntities.empty())
+                return;
+
+            for (auto entity : m_changedEntities)
+            {
+                auto nodeIndex = m_nodeIndices.find(entity);
+                if (nodeIndex == m_nodeIndices.end())
+                    continue;
+
+                const auto& transform = m_entityRegistry->get<TransformComponent>(entity);
+                m_positions[nodeIndex->second] = transform.m_position;
+                m_rotations[nodeIndex->second] = transform.m_rotation;
+                m_scales[nodeIndex->second] = transform.m_scale;
+                m_dirtyFlags[nodeIndex->second] = 1;
+            }
+        }
+        m_changedEntities.clear();
+
+        // a level only reads the finished level above it, so the nodes of a level are independent
+        for (size_t level = 0; level + 1 < m_levelOffsets.size(); level++)
+        {
+            size_t levelBegin = m_levelOffsets[level];
+            ThreadPool::Instance().ParallelFor(m_levelOffsets[level + 1] - levelBegin, s_grainSize, [this, levelBegin](size_t begin, size_t end)
+                {
+                    UpdateNodes(levelBegin + begin, levelBegin + end);
+                });
+        }
+        UpdateNormalMatrices();
+
+        // patching notifies other listeners like the spatial index, but must not mark the nodes again
+        m_isWritingWorldMatrices = true;
+        for (size_t i = 0; i < m_entities.size(); i++)
+        {
+            if (!m_dirtyFlags[i])
+                continue;
+
+            const glm::mat4& worldMatrix = m_worldMatrices[i];
+            const glm::mat4& normalMatrix = m_normalMatrices[i];
+            m_entityRegistry->patch<TransformComponent>(m_entities[i], [&worldMatrix, &normalMatrix](auto& transform)
+                {
+                    transform.m_transform = worldMatrix;
+                    transform.m_normalMatrix = normalMatrix;
+                    transform.m_version++;
+                });
+            m_dirtyFlags[i] = 0;
+        }
+        m_isWritingWorldMatrices = false;
+    }
+
+    size_t TransformHierarchy::GetNodeCount() const
+    {
+        return m_entities.size();
+    }
+
+    size_t TransformHierarchy::GetLevelCount() const
+    {
+        return m_levelOffsets.size() - 1;
+    }
+
+    void TransformHierarchy::OnTransformChanged(entt::registry& registry, entt::entity entity)
+    {
+        if (!m_isWritingWorldMatrices)
+            m_changedEntities.push_back(entity);
+    }
+
+    void TransformHierarchy::OnNodesChanged(entt::registry& registry, entt::entity entity)
+    {
+        m_areNodesDirty = true;
+    }
+
+    void TransformHierarchy::OnHierarchyRemoved(entt::registry& registry, entt::entity entity)
+    {
+        Unlink(entity);
+
+        // children of a removed node become roots
+        auto& hierarchy = registry.get<HierarchyComponent>(entity);
+        entt::entity child = hierarchy.m_firstChild;
+        while (child != entt::null)
+        {
+            auto& childHierarchy = registry.get<HierarchyComponent>(child);
+            child = childHierarchy.m_nextSibling;
+            childHierarchy.m_parent = entt::null;
+            childHierarchy.m_previousSibling = entt::null;
+            childHierarchy.m_nextSibling = entt::null;
+        }
+        hierarchy.m_firstChild = entt::null;
+
+        m_areNodesDirty = true;
+    }
+
+    void TransformHierarchy::Unlink(entt::entity entity)
+    {
+        auto& hierarchy = m_entityRegistry->get<HierarchyComponent>(entity);
+        if (hierarchy.m_parent == entt::null)
+            return;
+
+        if (hierarchy.m_previousSibling != entt::null)
+            m_entityRegistry->get<HierarchyComponent>(hierarchy.m_previousSibling).m_nextSibling = hierarchy.m_nextSibling;
+        else
+            m_entityRegistry->get<HierarchyComponent>(hierarchy.m_parent).m_firstChild = hierarchy.m_nextSibling;
+        if (hierarchy.m_nextSibling != entt::null)
+            m_entityRegistry->get<HierarchyComponent>(hierarchy.m_nextSibling).m_previousSibling = hierarchy.m_previousSibling;
+
+        hierarchy.m_parent = entt::null;
+        hierarchy.m_previousSibling = entt::null;
+        hierarchy.m_nextSibling = entt::null;
+    }
+
+    void TransformHierarchy::RebuildNodes()
+    {
+        m_entities.clear();
+        m_parentIndices.clear();
+        m_positions.clear();
+        m_rotations.clear();
+        m_scales.clear();
+        m_worldMatrices.clear();
+        m_normalMatrices.clear();
+        m_dirtyFlags.clear();
+        m_uniformScaleFlags.clear();
+        m_nodeIndices.clear();
+        m_levelOffsets.assign(1, 0);
+
+        // nodes whose parent lost its transform are treated as roots
+        for (auto entity : m_entityRegistry->view<TransformComponent>())
+        {
+            entt::entity parent = GetParent(entity);
+            if (parent == entt::null || !m_entityRegistry->has<TransformComponent>(parent))
+                AddNode(entity, -1);
+        }
+
+        // breadth first, so every level is contiguous and the children of a node are next to each other
+        size_t levelBegin = 0;
+        while (levelBegin < m_entities.size())
+        {
+            size_t levelEnd = m_entities.size();
+            m_levelOffsets.push_back(levelEnd);
+            for (size_t i = levelBegin; i < levelEnd; i++)
+            {
+                const auto* hierarchy = m_entityRegistry->try_get<HierarchyComponent>(m_entities[i]);
+                if (!hierarchy)
+                    continue;
+
+                for (entt::entity child = hierarchy->m_firstChild; child != entt::null; child = m_entityRegistry->get<HierarchyComponent>(child).m_nextSibling)
+                {
+                    if (m_entityRegistry->has<TransformComponent>(child))
+                        AddNode(child, static_cast<int32_t>(i));
+                }
+            }
+            levelBegin = levelEnd;
+        }
+    }
+
+    void TransformHierarchy::AddNode(entt::entity entity, int32_t parentIndex)
+    {
+        const auto& transform = m_entityRegistry->get<TransformComponent>(entity);
+        m_nodeIndices[entity] = static_cast<uint32_t>(m_entities.size());
+        m_entities.push_back(entity);
+        m_parentIndices.push_back(parentIndex);
+        m_positions.push_back(transform.m_position);
+        m_rotations.push_back(transform.m_rotation);
+        m_scales.push_back(transform.m_scale);
+        m_worldMatrices.push_back(glm::mat4(1.0f));
+        m_normalMatrices.push_back(glm::mat4(1.0f));
+        m_dirtyFlags.push_back(1);
+        m_uniformScaleFlags.push_back(1);
+    }
+
+    void TransformHierarchy::UpdateNodes(size_t begin, size_t end)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            int32_t parentIndex = m_parentIndices[i];
+            if (parentIndex >= 0 && m_dirtyFlags[parentIndex])
+                m_dirtyFlags[i] = 1;
+            if (!m_dirtyFlags[i])
+                continue;
+
+            glm::mat4 localMatrix = TransformComponent::ComposeMatrix(m_positions[i], m_rotations[i], m_scales[i]);
+            m_worldMatrices[i] = parentIndex >= 0 ? m_worldMatrices[parentIndex] * localMatrix : localMatrix;
+
+            glm::vec3 scale = glm::abs(m_scales[i]);
+            float tolerance = s_uniformScaleTolerance * glm::max(scale.x, glm::max(scale.y, scale.z));
+            bool isUniformScale = glm::abs(scale.x - scale.y) <= tolerance && glm::abs(scale.x - scale.z) <= tolerance;
+            m_uniformScaleFlags[i] = isUniformScale && (parentIndex < 0 || m_uniformScaleFlags[parentIndex]);
+        }
+    }
+
+    void TransformHierarchy::UpdateNormalMatrices()
+    {
+        m_normalBatchIndices.clear();
+        for (size_t i = 0; i < m_entities.size(); i++)
+        {
+            if (!m_dirtyFlags[i])
+                continue;
+
+            if (m_uniformScaleFlags[i])
+            {
+                // the world matrix is s * R with R orthogonal, so its inverse transpose is the matrix divided by s^2
+                const glm::mat4& worldMatrix = m_worldMatrices[i];
+                glm::vec3 axis = glm::vec3(worldMatrix[0]);
+                m_normalMatrices[i] = glm::mat4(glm::mat3(worldMatrix) * (1.0f / glm::dot(axis, axis)));
+            }
+            else
+                m_normalBatchIndices.push_back(static_cast<uint32_t>(i));
+        }
+
+        size_t batchSize = m_normalBatchIndices.size();
+        if (batchSize == 0)
+            return;
+
+        m_normalBatchWorldMatrices.resize(batchSize);
+        m_normalBatchNormalMatrices.resize(batchSize);
+        for (size_t i = 0; i < batchSize; i++)
+            m_normalBatchWorldMatrices[i] = m_worldMatrices[m_normalBatchIndices[i]];
+
+        ThreadPool::Instance().ParallelFor(batchSize, s_grainSize, [this](size_t begin, size_t end)
+            {
+                ComputeNormalMatrices(m_normalBatchWorldMatrices.data() + begin, m_normalBatchNormalMatrices.data() + begin, end - begin);
+            });
+
+        for (size_t i = 0; i < batchSize; i++)
+            m_normalMatrices[m_normalBatchIndices[i]] = m_normalBatchNormalMatrices[i];
+    }
+
+#ifdef FIREFLY_TRANSFORM_SSE
+    static inline __m128 Cross(__m128 a, __m128 b)
+    {
+        __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+        __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+        return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+    }
+
+    static inline float Dot3(__m128 a, __m128 b)
+    {
+        __m128 product = _mm_mul_ps(a, b);
+        __m128 y = _mm_shuffle_ps(product, product, _MM_SHUFFLE(1, 1, 1, 1));
+        __m128 z = _mm_movehl_ps(product, product);
+        return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(product, y), z));
+    }
+#endif
+
+    void TransformHierarchy::ComputeNormalMatrices(const glm::mat4* worldMatrices, glm::mat4* normalMatrices, size_t count)
+    {
+        // the inverse of a 3x3 matrix with columns a, b, c has the rows b x c, c x a, a x b divided by the determinant,
+        // so the inverse transpose has them as columns
+        for (size_t i = 0; i < count; i++)
+        {
+#ifdef FIREFLY_TRANSFORM_SSE
+            __m128 a = _mm_loadu_ps(&worldMatrices[i][0][0]);
+            __m128 b = _mm_loadu_ps(&worldMatrices[i][1][0]);
+            __m128 c = _mm_loadu_ps(&worldMatrices[i][2][0]);
+            __m128 bc = Cross(b, c);
+            __m128 inverseDeterminant = _mm_set1_ps(1.0f / Dot3(a, bc));
+            _mm_storeu_ps(&normalMatrices[i][0][0], _mm_mul_ps(bc, inverseDeterminant));
+            _mm_storeu_ps(&normalMatrices[i][1][0], _mm_mul_ps(Cross(c, a), inverseDeterminant));
+            _mm_storeu_ps(&normalMatrices[i][2][0], _mm_mul_ps(Cross(a, b), inverseDeterminant));
+#else
+            glm::vec3 a = glm::vec3(worldMatrices[i][0]);
+            glm::vec3 b = glm::vec3(worldMatrices[i][1]);
+            glm::vec3 c = glm::vec3(worldMatrices[i][2]);
+            glm::vec3 bc = glm::cross(b, c);
+            float inverseDeterminant = 1.0f / glm::dot(a, bc);
+            normalMatrices[i][0] = glm::vec4(bc * inverseDeterminant, 0.0f);
+            normalMatrices[i][1] = glm::vec4(glm::cross(c, a) * inverseDeterminant, 0.0f);
+            normalMatrices[i][2] = glm::vec4(glm::cross(a, b) * inverseDeterminant, 0.0f);
+#endif
+            normalMatrices[i][3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        }
+    }
+}
\ No newline at end of file
@@ -13,7 +13,7 @@ namespace Firefly
     {
     }
 
-    void Window::SetEventCallback(const std::function<void(std::shared_ptr<Event>)>& eventCallback)
+    void Window::SetEventCallback(const std::function<void(const Event&)>& eventCallback)
     {
         m_eventCallback = eventCallback;
         SetupKeyCodeConversionMap();
@@ -32,11 +32,26 @@ namespace Firefly
         OnSetSize(width, height);
     }
 
-    const std::function<void(std::shared_ptr<Event>)>& Window::GetEventCallback()
+    const std::function<void(const Event&)>& Window::GetEventCallback()
     {
         return m_eventCallback;
     }
 
+    EventQueue& Window::GetEventQueue()
+    {
+        return m_eventQueue;
+    }
+
+    std::chrono::steady_clock::time_point Window::GetLastEventPollTime() const
+    {
+        return m_lastEventPollTime;
+    }
+
+    std::chrono::steady_clock::time_point Window::GetNewestInputEventTime() const
+    {
+        return m_newestInputEventTime;
+    }
+
     const std::string& Window::GetTitle() const
     {
         return m_title;
@@ -68,4 +83,15 @@ namespace Firefly
         else
             return -1;
     }
+
+    void Window::DispatchEvents()
+    {
+        m_newestInputEventTime = {};
+        m_eventQueue.Dispatch([this](const Event& event)
+            {
+                if (event.GetCategory() != EventCategory::Window)
+                    m_newestInputEventTime = std::max(m_newestInputEventTime, event.GetTimestamp());
+                m_eventCallback(event);
+            });
+    }
 }
\ No newline at end of file
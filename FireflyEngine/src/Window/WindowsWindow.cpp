@@ -17,7 +17,7 @@ namespace Firefly
 
         glfwSetErrorCallback([](int code, const char* description)
             {
-                Logger::Error("FireflyEngine", "GLFW error [{0}]: {1}", code, description);
+                FIREFLY_LOG_ERROR("FireflyEngine", "GLFW error [{0}]: {1}", code, description);
             });
 
         if (RenderingAPI::GetType() == RenderingAPI::Type::OpenGL)
@@ -47,6 +47,26 @@ namespace Firefly
     {
         glfwPollEvents();
         PollGamepadEvents();
+        m_lastEventPollTime = std::chrono::steady_clock::now();
+        DispatchEvents();
+    }
+
+    void WindowsWindow::WaitEvents(float timeout)
+    {
+        glfwWaitEventsTimeout(timeout);
+        PollGamepadEvents();
+        m_lastEventPollTime = std::chrono::steady_clock::now();
+        DispatchEvents();
+    }
+
+    bool WindowsWindow::IsMinimized() const
+    {
+        return glfwGetWindowAttrib(m_window, GLFW_ICONIFIED) == GLFW_TRUE;
+    }
+
+    bool WindowsWindow::IsFocused() const
+    {
+        return glfwGetWindowAttrib(m_window, GLFW_FOCUSED) == GLFW_TRUE;
     }
 
     int WindowsWindow::GetHeight() const
@@ -89,54 +109,37 @@ namespace Firefly
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
                 window->SetSize(width, height);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event = std::make_shared<WindowResizeEvent>(width, height);
-                eventCallback(event);
+                window->GetEventQueue().Push(WindowResizeEvent(width, height));
             });
 
         glfwSetWindowCloseCallback(m_window, [](GLFWwindow* glfwWindow)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event = std::make_shared<WindowCloseEvent>();
-                eventCallback(event);
+                window->GetEventQueue().Push(WindowCloseEvent());
             });
 
         glfwSetWindowMaximizeCallback(m_window, [](GLFWwindow* glfwWindow, int maximized)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event;
                 if (maximized == GLFW_TRUE)
-                    event = std::make_shared<WindowMaximizeEvent>();
+                    window->GetEventQueue().Push(WindowMaximizeEvent());
                 else
-                    event = std::make_shared<WindowRestoreEvent>();
-                eventCallback(event);
+                    window->GetEventQueue().Push(WindowRestoreEvent());
             });
 
         glfwSetWindowIconifyCallback(m_window, [](GLFWwindow* glfwWindow, int iconified)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event;
                 if (iconified == GLFW_TRUE)
-                    event = std::make_shared<WindowMinimizeEvent>();
+                    window->GetEventQueue().Push(WindowMinimizeEvent());
                 else
-                    event = std::make_shared<WindowRestoreEvent>();
-                eventCallback(event);
+                    window->GetEventQueue().Push(WindowRestoreEvent());
             });
 
         glfwSetWindowPosCallback(m_window, [](GLFWwindow* glfwWindow, int xPos, int yPos)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event = std::make_shared<WindowMoveEvent>(xPos, yPos);
-                eventCallback(event);
+                window->GetEventQueue().Push(WindowMoveEvent(xPos, yPos));
             });
     }
 
@@ -145,87 +148,69 @@ namespace Firefly
         glfwSetKeyCallback(m_window, [](GLFWwindow* glfwWindow, int key, int scancode, int action, int mods)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
 
                 int keyCode = window->ToFireflyKeyCode(key);
-                std::shared_ptr<Event> event;
                 switch (action)
                 {
                 case GLFW_PRESS:
-                    event = std::make_shared<KeyPressEvent>(keyCode);
+                    window->GetEventQueue().Push(KeyPressEvent(keyCode));
                     break;
                 case GLFW_RELEASE:
-                    event = std::make_shared<KeyReleaseEvent>(keyCode);
+                    window->GetEventQueue().Push(KeyReleaseEvent(keyCode));
                     break;
                 case GLFW_REPEAT:
-                    event = std::make_shared<KeyRepeatEvent>(keyCode);
+                    window->GetEventQueue().Push(KeyRepeatEvent(keyCode));
                     break;
                 }
-                eventCallback(event);
             });
 
         glfwSetMouseButtonCallback(m_window, [](GLFWwindow* glfwWindow, int button, int action, int mods)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
 
                 int buttonCode = window->ToFireflyMouseButtonCode(button);
-                std::shared_ptr<Event> event;
                 switch (action)
                 {
                 case GLFW_PRESS:
-                    event = std::make_shared<MouseButtonPressEvent>(buttonCode);
+                    window->GetEventQueue().Push(MouseButtonPressEvent(buttonCode));
                     break;
                 case GLFW_RELEASE:
-                    event = std::make_shared<MouseButtonReleaseEvent>(buttonCode);
+                    window->GetEventQueue().Push(MouseButtonReleaseEvent(buttonCode));
                     break;
                 }
-                eventCallback(event);
             });
 
         glfwSetScrollCallback(m_window, [](GLFWwindow* glfwWindow, double xOffset, double yOffset)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event = std::make_shared<MouseScrollEvent>((float)xOffset, (float)yOffset);
-                eventCallback(event);
+                window->GetEventQueue().Push(MouseScrollEvent((float)xOffset, (float)yOffset));
             });
 
         glfwSetCursorPosCallback(m_window, [](GLFWwindow* glfwWindow, double xPos, double yPos)
             {
                 Window* window = (WindowsWindow*)glfwGetWindowUserPointer(glfwWindow);
-                auto eventCallback = window->GetEventCallback();
-
-                std::shared_ptr<Event> event = std::make_shared<MouseMoveEvent>((int)xPos, (int)yPos);
-                eventCallback(event);
+                window->GetEventQueue().Push(MouseMoveEvent((int)xPos, (int)yPos));
             });
     }
 
     void WindowsWindow::PollGamepadEvents()
     {
-        for (int gamepadNumber = 0; gamepadNumber < 16; gamepadNumber++)
+        for (int gamepadNumber = 0; gamepadNumber < FIREFLY_MAX_GAMEPADS; gamepadNumber++)
         {
-            if (glfwJoystickIsGamepad(gamepadNumber) && !Input::IsGamepadConnected(gamepadNumber))
-            {
-                std::string gamepadName = glfwGetGamepadName(gamepadNumber);
-                std::shared_ptr<Event> event = std::make_shared<GamepadConnectedEvent>(gamepadNumber, gamepadName);
-                m_eventCallback(event);
-            }
-            else if (!glfwJoystickIsGamepad(gamepadNumber) && Input::IsGamepadConnected(gamepadNumber))
-            {
-                std::shared_ptr<Event> event = std::make_shared<GamepadDisconnectedEvent>(gamepadNumber, Input::GetGamepadName(gamepadNumber));
-                m_eventCallback(event);
-            }
-
-            if (!glfwJoystickIsGamepad(gamepadNumber))
+            // the name is only queried when the gamepad connects
+            bool isGamepad = glfwJoystickIsGamepad(gamepadNumber);
+            if (isGamepad && !Input::IsGamepadConnected(gamepadNumber))
+                m_eventQueue.Push(GamepadConnectedEvent(gamepadNumber, glfwGetGamepadName(gamepadNumber)));
+            else if (!isGamepad && Input::IsGamepadConnected(gamepadNumber))
+                m_eventQueue.Push(GamepadDisconnectedEvent(gamepadNumber));
+
+            if (!isGamepad)
                 continue;
 
-            std::string gamepadName = glfwGetGamepadName(gamepadNumber);
             GLFWgamepadstate state;
             if (glfwGetGamepadState(gamepadNumber, &state))
             {
-                for (int button = 0; button < 15; button++) // there are 15 buttons
+                for (int button = 0; button < FIREFLY_GAMEPAD_BUTTON_COUNT; button++)
                 {
                     auto action = state.buttons[button];
                     int buttonCode = ToFireflyGamepadButtonCode(button);
@@ -233,17 +218,11 @@ namespace Firefly
                     {
                     case GLFW_PRESS:
                         if (!Input::IsGamepadButtonPressed(gamepadNumber, buttonCode))
-                        {
-                            std::shared_ptr<Event> event = std::make_shared<GamepadButtonPressEvent>(gamepadNumber, gamepadName, buttonCode);
-                            m_eventCallback(event);
-                        }
+                            m_eventQueue.Push(GamepadButtonPressEvent(gamepadNumber, buttonCode));
                         break;
                     case GLFW_RELEASE:
                         if (Input::IsGamepadButtonPressed(gamepadNumber, buttonCode))
-                        {
-                            std::shared_ptr<Event> event = std::make_shared<GamepadButtonReleaseEvent>(gamepadNumber, gamepadName, buttonCode);
-                            m_eventCallback(event);
-                        }
+                            m_eventQueue.Push(GamepadButtonReleaseEvent(gamepadNumber, buttonCode));
                         break;
                     }
                 }
@@ -254,36 +233,24 @@ namespace Firefly
                 bool hasChangedAxisLeftX = fabsf(axisLeftX - Input::GetGamepadAxisLeftX(gamepadNumber)) >= epsilon;
                 bool hasChangedAxisLeftY = fabsf(axisLeftY - Input::GetGamepadAxisLeftY(gamepadNumber)) >= epsilon;
                 if (hasChangedAxisLeftX || hasChangedAxisLeftY)
-                {
-                    std::shared_ptr<Event> event = std::make_shared<GamepadAxisLeftMoveEvent>(gamepadNumber, gamepadName, axisLeftX, axisLeftY);
-                    m_eventCallback(event);
-                }
+                    m_eventQueue.Push(GamepadAxisLeftMoveEvent(gamepadNumber, axisLeftX, axisLeftY));
 
                 float axisRightX = ApplyGamepadAxisDeadZone(state.axes[GLFW_GAMEPAD_AXIS_RIGHT_X]);
                 float axisRightY = ApplyGamepadAxisDeadZone(state.axes[GLFW_GAMEPAD_AXIS_RIGHT_Y]);
                 bool hasChangedAxisRightX = fabsf(axisRightX - Input::GetGamepadAxisRightX(gamepadNumber)) >= epsilon;
                 bool hasChangedAxisRightY = fabsf(axisRightY - Input::GetGamepadAxisRightY(gamepadNumber)) >= epsilon;
                 if (hasChangedAxisRightX || hasChangedAxisRightY)
-                {
-                    std::shared_ptr<Event> event = std::make_shared<GamepadAxisRightMoveEvent>(gamepadNumber, gamepadName, axisRightX, axisRightY);
-                    m_eventCallback(event);
-                }
+                    m_eventQueue.Push(GamepadAxisRightMoveEvent(gamepadNumber, axisRightX, axisRightY));
 
                 float triggerLeft = state.axes[GLFW_GAMEPAD_AXIS_LEFT_TRIGGER];
                 bool hasChangedTriggerLeft = fabsf(triggerLeft - Input::GetGamepadTriggerLeft(gamepadNumber)) >= epsilon;
                 if (hasChangedTriggerLeft)
-                {
-                    std::shared_ptr<Event> event = std::make_shared<GamepadTriggerLeftMoveEvent>(gamepadNumber, gamepadName, triggerLeft);
-                    m_eventCallback(event);
-                }
+                    m_eventQueue.Push(GamepadTriggerLeftMoveEvent(gamepadNumber, triggerLeft));
 
                 float triggerRight = state.axes[GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER];
                 bool hasChangedTriggerRight = fabsf(triggerRight - Input::GetGamepadTriggerRight(gamepadNumber)) >= epsilon;
                 if (hasChangedTriggerRight)
-                {
-                    std::shared_ptr<Event> event = std::make_shared<GamepadTriggerRightMoveEvent>(gamepadNumber, gamepadName, triggerRight);
-                    m_eventCallback(event);
-                }
+                    m_eventQueue.Push(GamepadTriggerRightMoveEvent(gamepadNumber, triggerRight));
             }
         }
     }
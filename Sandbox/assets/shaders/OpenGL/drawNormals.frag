@@ -12,6 +12,7 @@ struct MaterialData
     float hasMetalnessTexture;
     float hasOcclusionTexture;
     float hasHeightTexture;
+    float hasOcclusionRoughnessMetalnessTexture;
 };
 
 uniform MaterialData material;
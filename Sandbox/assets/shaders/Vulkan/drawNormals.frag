@@ -12,6 +12,7 @@ layout(set = 1, binding = 0) uniform MaterialData
     float hasMetalnessTexture;
     float hasOcclusionTexture;
     float hasHeightTexture;
+    float hasOcclusionRoughnessMetalnessTexture;
 } material;
 
 layout(location = 0) out vec4 outColor;
@@ -8,11 +8,17 @@ layout(set = 0, binding = 0) uniform SceneData
     vec4 cameraPosition;
 } scene;
 
-layout(set = 3, binding = 0) uniform ObjectData
+struct ObjectData
 {
     mat4 modelMatrix;
     mat4 normalMatrix;
-} object;
+};
+
+// the culled draw commands carry the object index as their first instance
+layout(set = 3, binding = 0) readonly buffer Objects
+{
+    ObjectData objects[];
+};
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inNormal;
@@ -25,6 +31,8 @@ layout(location = 1) out mat4 mvp;
 
 void main() 
 {
+    ObjectData object = objects[gl_InstanceIndex];
+
     gl_Position = vec4(inPosition, 1.0);
     geomNormal = inNormal;
     mvp = scene.viewProjectionMatrix * object.modelMatrix;
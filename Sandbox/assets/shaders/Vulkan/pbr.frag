@@ -12,6 +12,7 @@ layout(set = 1, binding = 0) uniform MaterialData
     float hasMetalnessTexture;
     float hasOcclusionTexture;
     float hasHeightTexture;
+    float hasOcclusionRoughnessMetalnessTexture;
 } material;
 
 layout(set = 2, binding = 0) uniform sampler2D albedoTextureSampler;
@@ -20,6 +21,7 @@ layout(set = 2, binding = 2) uniform sampler2D roughnessTextureSampler;
 layout(set = 2, binding = 3) uniform sampler2D metalnessTextureSampler;
 layout(set = 2, binding = 4) uniform sampler2D occlusionTextureSampler;
 layout(set = 2, binding = 5) uniform sampler2D heightTextureSampler;
+layout(set = 2, binding = 6) uniform sampler2D occlusionRoughnessMetalnessTextureSampler;
 
 layout(set = 4, binding = 0) uniform samplerCube irradianceMap;
 layout(set = 4, binding = 1) uniform samplerCube prefilterMap;
@@ -60,25 +62,35 @@ void main()
 
     vec3 normal;
     if(material.hasNormalTexture > 0.0f)
-        normal = normalize(TBN * normalize(texture(normalTextureSampler, texCoords).xyz * 2.0 - 1.0));
+    {
+        // only x and y are stored, two channel formats like bc5 leave out z
+        vec2 tangentNormalXY = texture(normalTextureSampler, texCoords).xy * 2.0 - 1.0;
+        vec3 tangentNormal = vec3(tangentNormalXY, sqrt(max(1.0 - dot(tangentNormalXY, tangentNormalXY), 0.0)));
+        normal = normalize(TBN * tangentNormal);
+    }
     else
         normal = normalize(fragNormal);
 
-    float roughness;
-    if(material.hasRoughnessTexture > 0.0f)
-        roughness = texture(roughnessTextureSampler, texCoords).r;
-    else
-        roughness = material.roughness;
-
-    float metalness;
-    if(material.hasMetalnessTexture > 0.0f)
-        metalness = texture(metalnessTextureSampler, texCoords).r;
-    else
-        metalness = material.metalness;
-
+    float roughness = material.roughness;
+    float metalness = material.metalness;
     float occlusion = 1.0;
-    if(material.hasOcclusionTexture > 0.0f)
-        occlusion = texture(occlusionTextureSampler, texCoords).r;
+    if(material.hasOcclusionRoughnessMetalnessTexture > 0.0f)
+    {
+        // one fetch instead of three, occlusion in r, roughness in g and metalness in b
+        vec3 occlusionRoughnessMetalness = texture(occlusionRoughnessMetalnessTextureSampler, texCoords).rgb;
+        occlusion = occlusionRoughnessMetalness.r;
+        roughness = occlusionRoughnessMetalness.g;
+        metalness = occlusionRoughnessMetalness.b;
+    }
+    else
+    {
+        if(material.hasRoughnessTexture > 0.0f)
+            roughness = texture(roughnessTextureSampler, texCoords).r;
+        if(material.hasMetalnessTexture > 0.0f)
+            metalness = texture(metalnessTextureSampler, texCoords).r;
+        if(material.hasOcclusionTexture > 0.0f)
+            occlusion = texture(occlusionTextureSampler, texCoords).r;
+    }
 
     vec3 F0 = vec3(0.04); 
     F0 = mix(F0, albedo, metalness);
@@ -11,7 +11,7 @@ public:
     ~CameraController();
 
     void OnUpdate(float deltaTime);
-    void OnMouseEvent(std::shared_ptr<Firefly::MouseEvent> event);
+    void OnMouseEvent(const Firefly::Event& event);
 
 private:
     std::shared_ptr<Firefly::Camera> m_camera;
@@ -11,17 +11,31 @@ public:
     ~SandboxApp();
 
 protected:
-    virtual void OnUpdate(float deltaTime) override;
-    virtual void OnWindowEvent(std::shared_ptr<Firefly::WindowEvent> event) override;
-    virtual void OnKeyEvent(std::shared_ptr<Firefly::KeyEvent> event) override;
-    virtual void OnMouseEvent(std::shared_ptr<Firefly::MouseEvent> event) override;
-    virtual void OnGamepadEvent(std::shared_ptr<Firefly::GamepadEvent> event) override;
+    virtual void OnFrameStart() override;
+    virtual void OnFixedUpdate(float fixedDeltaTime) override;
+    virtual void OnRender(float deltaTime, float interpolationAlpha) override;
+    virtual void OnWindowEvent(const Firefly::Event& event) override;
+    virtual void OnKeyEvent(const Firefly::Event& event) override;
+    virtual void OnMouseEvent(const Firefly::Event& event) override;
+    virtual void OnGamepadEvent(const Firefly::Event& event) override;
 
 private:
+    // written by the statistics system while the other systems run
+    struct SceneStatistics
+    {
+        std::atomic<uint32_t> meshCount = 0;
+        std::atomic<uint64_t> triangleCount = 0;
+    };
+
+    void CullScene();
+
     std::shared_ptr<Firefly::Scene> m_scene;
     std::shared_ptr<Firefly::Renderer> m_renderer;
     std::shared_ptr<Firefly::Camera> m_camera;
     std::shared_ptr<CameraController> m_cameraController;
+    std::shared_ptr<Firefly::SoftwareOcclusionCuller> m_occlusionCuller;
+    std::vector<entt::entity> m_visibleEntities;
+    SceneStatistics m_sceneStatistics;
 
     bool m_isAlbedoTexEnabled = true;
     bool m_isNormalTexEnabled = true;
@@ -29,5 +43,15 @@ private:
     bool m_isMetalnessTexEnabled = true;
     bool m_isOcclusionTexEnabled = true;
     bool m_isHeightTexEnabled = true;
+    bool m_isOcclusionRoughnessMetalnessTexEnabled = true;
     float m_heightScale = 0.2f;
+
+    static constexpr std::pair<Firefly::GraphicsContext::PresentMode, const char*> s_presentModes[] =
+    {
+        { Firefly::GraphicsContext::PresentMode::FifoRelaxed, "fifo relaxed" },
+        { Firefly::GraphicsContext::PresentMode::Fifo, "fifo" },
+        { Firefly::GraphicsContext::PresentMode::Mailbox, "mailbox" },
+        { Firefly::GraphicsContext::PresentMode::Immediate, "immediate" }
+    };
+    size_t m_presentModeIndex = 0;
 };
\ No newline at end of file
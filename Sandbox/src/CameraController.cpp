@@ -72,12 +72,12 @@ void CameraController::OnUpdate(float deltaTime)
     }
 }
 
-void CameraController::OnMouseEvent(std::shared_ptr<Firefly::MouseEvent> event)
+void CameraController::OnMouseEvent(const Firefly::Event& event)
 {
     if (Firefly::Input::IsGamepadConnected(FIREFLY_GAMEPAD_1))
         return;
 
-    if (auto moveEvent = event->AsType<Firefly::MouseMoveEvent>())
+    if (auto moveEvent = event.AsType<Firefly::MouseMoveEvent>())
     {
         float newMouseXPos = (float)moveEvent->GetXPos();
         float newMouseYPos = (float)moveEvent->GetYPos();
@@ -101,7 +101,7 @@ void CameraController::OnMouseEvent(std::shared_ptr<Firefly::MouseEvent> event)
             m_camera->LookAt(m_camera->GetPosition() + camViewDirection);
         }
     }
-    else if (auto scrollEvent = event->AsType<Firefly::MouseScrollEvent>())
+    else if (auto scrollEvent = event.AsType<Firefly::MouseScrollEvent>())
     {
         float delta = scrollEvent->GetYOffset();
         float zoom = m_camera->GetFieldOfView();
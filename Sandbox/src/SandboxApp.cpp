@@ -4,6 +4,8 @@
 #include <Firefly/Scene/Components/MeshComponent.h>
 #include <Firefly/Scene/Components/MaterialComponent.h>
 #include <Firefly/Scene/Components/TransformComponent.h>
+#include <Firefly/Scene/Components/OccluderComponent.h>
+#include <Firefly/Scene/Components/HierarchyComponent.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 SandboxApp::SandboxApp()
@@ -12,6 +14,7 @@ SandboxApp::SandboxApp()
     m_camera = std::make_shared<Firefly::Camera>(m_window->GetWidth(), m_window->GetHeight());
     m_camera->SetPosition(glm::vec3(0.f, 0.f, 2.f));
     m_cameraController = std::make_shared<CameraController>(m_camera);
+    m_occlusionCuller = std::make_shared<Firefly::SoftwareOcclusionCuller>();
 
     // DEFAULT SHADER
     Firefly::ShaderCode shaderCode{};
@@ -48,76 +51,46 @@ SandboxApp::SandboxApp()
     Firefly::ShaderRegistry::Instance().Insert(drawNormalsShader->GetTag(), drawNormalsShader);
 
     std::shared_ptr<Firefly::Mesh> floorMesh = Firefly::MeshGenerator::CreateQuad(glm::vec2(2.0f));
-    std::shared_ptr<Firefly::Mesh> pistolMesh = Firefly::RenderingAPI::CreateMesh("assets/meshes/pistol.fbx", true);
-    std::shared_ptr<Firefly::Mesh> globeMesh = Firefly::RenderingAPI::CreateMesh("assets/meshes/globe.fbx");
-    std::shared_ptr<Firefly::Mesh> armchairMesh = Firefly::RenderingAPI::CreateMesh("assets/meshes/armchair.fbx");
     std::shared_ptr<Firefly::Mesh> sphereMesh = Firefly::MeshGenerator::CreateSphere();
 
-    Firefly::MeshRegistry::Instance().Insert("Floor", floorMesh);
-    Firefly::MeshRegistry::Instance().Insert("Pistol", pistolMesh);
-    Firefly::MeshRegistry::Instance().Insert("Globe", globeMesh);
-    Firefly::MeshRegistry::Instance().Insert("Armchair", armchairMesh);
-    Firefly::MeshRegistry::Instance().Insert("Sphere", sphereMesh);
-
-    std::shared_ptr<Firefly::Texture> pistolAlbedoTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/pistol/albedo.jpg", false);
-    std::shared_ptr<Firefly::Texture> pistolNormalTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/pistol/normal.jpg");
-    std::shared_ptr<Firefly::Texture> pistolRoughnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/pistol/roughness.jpg");
-    std::shared_ptr<Firefly::Texture> pistolMetalnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/pistol/metalness.jpg");
-    std::shared_ptr<Firefly::Texture> pistolOcclusionTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/pistol/occlusion.jpg");
-    Firefly::TextureRegistry::Instance().Insert("PistolAlbedo", pistolAlbedoTexture);
-    Firefly::TextureRegistry::Instance().Insert("PistolNormal", pistolNormalTexture);
-    Firefly::TextureRegistry::Instance().Insert("PistolRoughness", pistolRoughnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("PistolMetallness", pistolMetalnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("PistolOcclusion", pistolOcclusionTexture);
-
-    std::shared_ptr<Firefly::Texture> globeAlbedoTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/globe/albedo.png", false);
-    std::shared_ptr<Firefly::Texture> globeRoughnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/globe/roughness.png");
-    std::shared_ptr<Firefly::Texture> globeMetalnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/globe/metalness.png");
-    std::shared_ptr<Firefly::Texture> globeOcclusionTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/globe/occlusion.png");
-    Firefly::TextureRegistry::Instance().Insert("GlobeAlbedo", globeAlbedoTexture);
-    Firefly::TextureRegistry::Instance().Insert("GlobeRoughness", globeRoughnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("GlobeMetalness", globeMetalnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("GlobeOcclusion", globeOcclusionTexture);
-
-    std::shared_ptr<Firefly::Texture> armchairAlbedoTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/armchair/albedo.png", false);
-    std::shared_ptr<Firefly::Texture> armchairNormalTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/armchair/normal.png");
-    std::shared_ptr<Firefly::Texture> armchairRoughnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/armchair/roughness.png");
-    std::shared_ptr<Firefly::Texture> armchairOcclusionTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/armchair/occlusion.png");
-    Firefly::TextureRegistry::Instance().Insert("ArmchairAlbedo", armchairAlbedoTexture);
-    Firefly::TextureRegistry::Instance().Insert("ArmchairNormal", armchairNormalTexture);
-    Firefly::TextureRegistry::Instance().Insert("ArmchairRoughness", armchairRoughnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("ArmchairOcclusion", armchairOcclusionTexture);
-
-    std::shared_ptr<Firefly::Texture> floorAlbedoTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/1_albedo.jpg", false);
-    std::shared_ptr<Firefly::Texture> floorNormalTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/1_normal.jpg");
-    std::shared_ptr<Firefly::Texture> floorRoughnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/1_roughness.jpg");
-    std::shared_ptr<Firefly::Texture> floorOcclusionTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/1_occlusion.jpg");
-    std::shared_ptr<Firefly::Texture> floorHeightTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/1_height.jpg");
-    Firefly::TextureRegistry::Instance().Insert("FloorAlbedo", floorAlbedoTexture);
-    Firefly::TextureRegistry::Instance().Insert("FloorNormal", floorNormalTexture);
-    Firefly::TextureRegistry::Instance().Insert("FloorRoughness", floorRoughnessTexture);
-    Firefly::TextureRegistry::Instance().Insert("FloorOcclusion", floorOcclusionTexture);
-    Firefly::TextureRegistry::Instance().Insert("FloorHeight", floorHeightTexture);
-
-    std::shared_ptr<Firefly::Texture> floor2AlbedoTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/2_albedo.jpg", false);
-    std::shared_ptr<Firefly::Texture> floor2NormalTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/2_normal.jpg");
-    std::shared_ptr<Firefly::Texture> floor2RoughnessTexture = Firefly::RenderingAPI::CreateTexture("assets/textures/floor/2_roughness.jpg");
-    Firefly::TextureRegistry::Instance().Insert("Floor2Albedo", floor2AlbedoTexture);
-    Firefly::TextureRegistry::Instance().Insert("Floor2Normal", floor2NormalTexture);
-    Firefly::TextureRegistry::Instance().Insert("Floor2Roughness", floor2RoughnessTexture);
+    Firefly::MeshHandle floorMeshHandle = Firefly::MeshRegistry::Instance().Insert("Floor", floorMesh);
+    Firefly::MeshHandle pistolMeshHandle = Firefly::ResourceLoader::Instance().LoadMeshAsync("assets/meshes/pistol.fbx", true);
+    Firefly::MeshHandle globeMeshHandle = Firefly::ResourceLoader::Instance().LoadMeshAsync("assets/meshes/globe.fbx");
+    Firefly::MeshHandle armchairMeshHandle = Firefly::ResourceLoader::Instance().LoadMeshAsync("assets/meshes/armchair.fbx");
+    Firefly::MeshHandle sphereMeshHandle = Firefly::MeshRegistry::Instance().Insert("Sphere", sphereMesh);
+
+    Firefly::TextureHandle pistolAlbedoTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/pistol/albedo.jpg", Firefly::Material::TextureUsage::Albedo);
+    Firefly::TextureHandle pistolNormalTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/pistol/normal.jpg", Firefly::Material::TextureUsage::Normal);
+    Firefly::TextureHandle pistolOcclusionRoughnessMetalnessTexture = Firefly::ResourceLoader::Instance().LoadOcclusionRoughnessMetalnessAsync(
+        "assets/textures/pistol/occlusion.jpg", "assets/textures/pistol/roughness.jpg", "assets/textures/pistol/metalness.jpg");
+
+    Firefly::TextureHandle globeAlbedoTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/globe/albedo.png", Firefly::Material::TextureUsage::Albedo);
+    Firefly::TextureHandle globeOcclusionRoughnessMetalnessTexture = Firefly::ResourceLoader::Instance().LoadOcclusionRoughnessMetalnessAsync(
+        "assets/textures/globe/occlusion.png", "assets/textures/globe/roughness.png", "assets/textures/globe/metalness.png");
+
+    Firefly::TextureHandle armchairAlbedoTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/armchair/albedo.png", Firefly::Material::TextureUsage::Albedo);
+    Firefly::TextureHandle armchairNormalTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/armchair/normal.png", Firefly::Material::TextureUsage::Normal);
+    Firefly::TextureHandle armchairRoughnessTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/armchair/roughness.png", Firefly::Material::TextureUsage::Roughness);
+    Firefly::TextureHandle armchairOcclusionTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/armchair/occlusion.png", Firefly::Material::TextureUsage::Occlusion);
+
+    Firefly::TextureHandle floorAlbedoTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/1_albedo.jpg", Firefly::Material::TextureUsage::Albedo);
+    Firefly::TextureHandle floorNormalTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/1_normal.jpg", Firefly::Material::TextureUsage::Normal);
+    Firefly::TextureHandle floorRoughnessTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/1_roughness.jpg", Firefly::Material::TextureUsage::Roughness);
+    Firefly::TextureHandle floorOcclusionTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/1_occlusion.jpg", Firefly::Material::TextureUsage::Occlusion);
+    Firefly::TextureHandle floorHeightTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/1_height.jpg", Firefly::Material::TextureUsage::Height);
+
+    Firefly::TextureHandle floor2AlbedoTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/2_albedo.jpg", Firefly::Material::TextureUsage::Albedo);
+    Firefly::TextureHandle floor2NormalTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/2_normal.jpg", Firefly::Material::TextureUsage::Normal);
+    Firefly::TextureHandle floor2RoughnessTexture = Firefly::ResourceLoader::Instance().LoadTextureAsync("assets/textures/floor/2_roughness.jpg", Firefly::Material::TextureUsage::Roughness);
 
     std::shared_ptr<Firefly::Material> pistolMaterial = Firefly::RenderingAPI::CreateMaterial(defaultShader);
     pistolMaterial->SetTexture(pistolAlbedoTexture, Firefly::Material::TextureUsage::Albedo);
     pistolMaterial->SetTexture(pistolNormalTexture, Firefly::Material::TextureUsage::Normal);
-    pistolMaterial->SetTexture(pistolRoughnessTexture, Firefly::Material::TextureUsage::Roughness);
-    pistolMaterial->SetTexture(pistolMetalnessTexture, Firefly::Material::TextureUsage::Metalness);
-    pistolMaterial->SetTexture(pistolOcclusionTexture, Firefly::Material::TextureUsage::Occlusion);
+    pistolMaterial->SetTexture(pistolOcclusionRoughnessMetalnessTexture, Firefly::Material::TextureUsage::OcclusionRoughnessMetalness);
 
     std::shared_ptr<Firefly::Material> globeMaterial = Firefly::RenderingAPI::CreateMaterial(defaultShader);
     globeMaterial->SetTexture(globeAlbedoTexture, Firefly::Material::TextureUsage::Albedo);
-    globeMaterial->SetTexture(globeRoughnessTexture, Firefly::Material::TextureUsage::Roughness);
-    globeMaterial->SetTexture(globeMetalnessTexture, Firefly::Material::TextureUsage::Metalness);
-    globeMaterial->SetTexture(globeOcclusionTexture, Firefly::Material::TextureUsage::Occlusion);
+    globeMaterial->SetTexture(globeOcclusionRoughnessMetalnessTexture, Firefly::Material::TextureUsage::OcclusionRoughnessMetalness);
 
     std::shared_ptr<Firefly::Material> armchairMaterial = Firefly::RenderingAPI::CreateMaterial(defaultShader);
     armchairMaterial->SetTexture(armchairAlbedoTexture, Firefly::Material::TextureUsage::Albedo);
@@ -141,45 +114,52 @@ SandboxApp::SandboxApp()
     std::shared_ptr<Firefly::Material> drawNormalsMaterial = Firefly::RenderingAPI::CreateMaterial(drawNormalsShader);
     drawNormalsMaterial->SetAlbedo(glm::vec4(0.0f, 1.0f, 0.0f, 1.0f));
 
-    Firefly::MaterialRegistry::Instance().Insert("Pistol", pistolMaterial);
-    Firefly::MaterialRegistry::Instance().Insert("Globe", globeMaterial);
-    Firefly::MaterialRegistry::Instance().Insert("Armchair", armchairMaterial);
-    Firefly::MaterialRegistry::Instance().Insert("Floor", floorMaterial);
-    Firefly::MaterialRegistry::Instance().Insert("Floor2", floor2Material);
-    Firefly::MaterialRegistry::Instance().Insert("DrawNormals", drawNormalsMaterial);
+    Firefly::MaterialHandle pistolMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Pistol", pistolMaterial);
+    Firefly::MaterialHandle globeMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Globe", globeMaterial);
+    Firefly::MaterialHandle armchairMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Armchair", armchairMaterial);
+    Firefly::MaterialHandle floorMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Floor", floorMaterial);
+    Firefly::MaterialHandle floor2MaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Floor2", floor2Material);
+    Firefly::MaterialHandle drawNormalsMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("DrawNormals", drawNormalsMaterial);
 
     Firefly::Entity pistol(m_scene);
     pistol.AddComponent<Firefly::TagComponent>("Pistol");
     pistol.AddComponent<Firefly::TransformComponent>(glm::rotate(glm::scale(glm::mat4(1), glm::vec3(0.01f)), -(float)M_PI_2, glm::vec3(1.f, 0.f, 0.f)));
-    pistol.AddComponent<Firefly::MeshComponent>(pistolMesh);
-    pistol.AddComponent<Firefly::MaterialComponent>(pistolMaterial);
+    pistol.AddComponent<Firefly::MeshComponent>(pistolMeshHandle);
+    pistol.AddComponent<Firefly::MaterialComponent>(pistolMaterialHandle);
 
     Firefly::Entity globe(m_scene);
     globe.AddComponent<Firefly::TagComponent>("Globe");
     globe.AddComponent<Firefly::TransformComponent>(glm::scale(glm::translate(glm::mat4(1), glm::vec3(-1.5f, -0.5f, -1.5f)), glm::vec3(0.0075f)));
-    globe.AddComponent<Firefly::MeshComponent>(globeMesh);
-    globe.AddComponent<Firefly::MaterialComponent>(globeMaterial);
+    globe.AddComponent<Firefly::MeshComponent>(globeMeshHandle);
+    globe.AddComponent<Firefly::MaterialComponent>(globeMaterialHandle);
 
     Firefly::Entity armchair(m_scene);
     armchair.AddComponent<Firefly::TagComponent>("Armchair");
     armchair.AddComponent<Firefly::TransformComponent>(glm::scale(glm::translate(glm::rotate(glm::mat4(1), -(float)M_PI_2, glm::vec3(1.f, 0.f, 0.f)), glm::vec3(1.5f, 1.5f, -0.55f)), glm::vec3(0.01f)));
-    armchair.AddComponent<Firefly::MeshComponent>(armchairMesh);
-    armchair.AddComponent<Firefly::MaterialComponent>(armchairMaterial);
+    armchair.AddComponent<Firefly::MeshComponent>(armchairMeshHandle);
+    armchair.AddComponent<Firefly::MaterialComponent>(armchairMaterialHandle);
 
     Firefly::Entity floor(m_scene);
     floor.AddComponent<Firefly::TagComponent>("Floor");
     floor.AddComponent<Firefly::TransformComponent>(glm::rotate(glm::scale(glm::translate(glm::mat4(1), glm::vec3(0.f, -0.5f, 8.f)), glm::vec3(4.f)), -(float)M_PI_2, glm::vec3(1.f, 0.f, 0.f)));
-    floor.AddComponent<Firefly::MeshComponent>(floorMesh);
-    floor.AddComponent<Firefly::MaterialComponent>(floorMaterial);
+    floor.AddComponent<Firefly::MeshComponent>(floorMeshHandle);
+    floor.AddComponent<Firefly::MaterialComponent>(floorMaterialHandle);
+    floor.AddComponent<Firefly::OccluderComponent>(Firefly::OccluderMesh::CreateBox(floorMesh->GetBoundingBox()));
 
     Firefly::Entity floor2(m_scene);
     floor2.AddComponent<Firefly::TagComponent>("Floor2");
     floor2.AddComponent<Firefly::TransformComponent>(glm::rotate(glm::scale(glm::translate(glm::mat4(1), glm::vec3(0.f, -0.5f, 0.f)), glm::vec3(4.f)), -(float)M_PI_2, glm::vec3(1.f, 0.f, 0.f)));
-    floor2.AddComponent<Firefly::MeshComponent>(floorMesh);
-    floor2.AddComponent<Firefly::MaterialComponent>(floor2Material);
+    floor2.AddComponent<Firefly::MeshComponent>(floorMeshHandle);
+    floor2.AddComponent<Firefly::MaterialComponent>(floor2MaterialHandle);
+    floor2.AddComponent<Firefly::OccluderComponent>(Firefly::OccluderMesh::CreateBox(floorMesh->GetBoundingBox()));
 
     const uint32_t rowCount = 7;
     const uint32_t columnCount = 7;
+
+    Firefly::Entity sphereGrid(m_scene);
+    sphereGrid.AddComponent<Firefly::TagComponent>("SphereGrid");
+    sphereGrid.AddComponent<Firefly::TransformComponent>(glm::vec3(-(float)columnCount * 0.5f, 1.0f, -5.f));
+
     for (size_t x = 0; x < columnCount; x++)
     {
         for (size_t y = 0; y < rowCount; y++)
@@ -188,23 +168,60 @@ SandboxApp::SandboxApp()
             defaultMaterial->SetAlbedo(glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
             defaultMaterial->SetRoughness(x / (float)(columnCount - 1));
             defaultMaterial->SetMetalness(y / (float)(rowCount - 1));
-            Firefly::MaterialRegistry::Instance().Insert("Default" + std::to_string(x) + "-" + std::to_string(y), defaultMaterial);
+            Firefly::MaterialHandle defaultMaterialHandle = Firefly::MaterialRegistry::Instance().Insert("Default" + std::to_string(x) + "-" + std::to_string(y), defaultMaterial);
 
             Firefly::Entity sphere(m_scene);
             sphere.AddComponent<Firefly::TagComponent>("Sphere" + std::to_string(x) + "-" + std::to_string(y));
-            sphere.AddComponent<Firefly::TransformComponent>(glm::translate(glm::mat4(1), glm::vec3(x * 1.1f, y * 1.1f, 0.0f) + glm::vec3(-(float)columnCount * 0.5f, 1.0f, -5.f)));
-            sphere.AddComponent<Firefly::MeshComponent>(sphereMesh);
-            sphere.AddComponent<Firefly::MaterialComponent>(defaultMaterial);
+            sphere.AddComponent<Firefly::TransformComponent>(glm::vec3(x * 1.1f, y * 1.1f, 0.0f));
+            sphere.AddComponent<Firefly::MeshComponent>(sphereMeshHandle);
+            sphere.AddComponent<Firefly::MaterialComponent>(defaultMaterialHandle);
+            m_scene->GetTransformHierarchy().SetParent(sphere.GetId(), sphereGrid.GetId());
 
             //Firefly::Entity sphereNormals(m_scene);
             //sphereNormals.AddComponent<Firefly::TagComponent>("SphereNormals" + std::to_string(x) + "-" + std::to_string(y));
             //sphereNormals.AddComponent<Firefly::TransformComponent>(glm::translate(glm::mat4(1), glm::vec3(x * 1.1f, y * 1.1f, 0.0f) + glm::vec3(-(float)columnCount * 0.5f, 1.0f, -5.f)));
-            //sphereNormals.AddComponent<Firefly::MeshComponent>(sphereMesh);
-            //sphereNormals.AddComponent<Firefly::MaterialComponent>(drawNormalsMaterial);
+            //sphereNormals.AddComponent<Firefly::MeshComponent>(sphereMeshHandle);
+            //sphereNormals.AddComponent<Firefly::MaterialComponent>(drawNormalsMaterialHandle);
         }
     }
 
     m_renderer = Firefly::RenderingAPI::CreateRenderer();
+    m_renderer->SetScene(m_scene);
+    // the next frame is simulated while the previous one is drawn
+    m_renderer->SetRenderThreadEnabled(true);
+
+    // the scene systems tick at a fixed rate independent of the frame rate
+    SetFixedTickRate(60.0f);
+    // the camera only needs the newest cursor position of a frame
+    m_window->GetEventQueue().SetMouseMoveCoalescingEnabled(true);
+
+    // patching the world matrices notifies the spatial index and the render proxies, so the hierarchy writes to them as well
+    m_systemScheduler.AddSystem<Firefly::Read<>, Firefly::Write<Firefly::TransformComponent, Firefly::HierarchyComponent, Firefly::SceneSpatialIndex, Firefly::RenderProxyCache>>("TransformHierarchy",
+        [this](float deltaTime)
+        {
+            m_scene->GetTransformHierarchy().Update();
+        });
+    m_systemScheduler.AddSystem<Firefly::Read<Firefly::TransformComponent, Firefly::MeshComponent>, Firefly::Write<Firefly::SceneSpatialIndex>>("SpatialIndex",
+        [this](float deltaTime)
+        {
+            m_scene->GetSpatialIndex().Update();
+        });
+    // only reads meshes, so it overlaps with the systems above
+    m_systemScheduler.AddSystem<Firefly::Read<Firefly::MeshComponent>, Firefly::Write<SceneStatistics>>("SceneStatistics",
+        [this](float deltaTime)
+        {
+            m_sceneStatistics.meshCount = 0;
+            m_sceneStatistics.triangleCount = 0;
+            m_scene->ParallelEach<const Firefly::MeshComponent>([this](entt::entity entity, const Firefly::MeshComponent& meshComponent)
+                {
+                    const Firefly::Mesh* mesh = Firefly::MeshRegistry::Instance().Get(meshComponent.m_mesh);
+                    if (!mesh)
+                        return;
+
+                    m_sceneStatistics.meshCount.fetch_add(1, std::memory_order_relaxed);
+                    m_sceneStatistics.triangleCount.fetch_add(mesh->GetIndexCount() / 3, std::memory_order_relaxed);
+                }, 256);
+        });
 }
 
 SandboxApp::~SandboxApp()
@@ -212,20 +229,35 @@ SandboxApp::~SandboxApp()
     m_renderer->Destroy();
 }
 
-void SandboxApp::OnUpdate(float deltaTime)
+void SandboxApp::OnFrameStart()
+{
+    m_renderer->WaitForFrameSlot();
+    // meshes that finished loading have other bounds than their placeholder
+    m_scene->RefreshMeshes(Firefly::ResourceLoader::Instance().GetReplacedMeshes());
+}
+
+void SandboxApp::OnFixedUpdate(float fixedDeltaTime)
+{
+    m_renderer->BeginFixedStep();
+    m_systemScheduler.Run(fixedDeltaTime);
+}
+
+void SandboxApp::OnRender(float deltaTime, float interpolationAlpha)
 {
+    // input is polled on the main thread, the camera moves every frame so culling follows it
     m_cameraController->OnUpdate(deltaTime);
+    CullScene();
 
-    m_renderer->BeginDrawRecording();
-    for (auto entity : m_scene->GetEntities())
-        m_renderer->RecordDraw(entity);
+    m_renderer->BeginDrawRecording(interpolationAlpha);
+    for (auto entityId : m_visibleEntities)
+        m_renderer->RecordDraw(m_scene->GetEntity(entityId));
     m_renderer->EndDrawRecording();
     m_renderer->SubmitDraw(m_camera);
 }
 
-void SandboxApp::OnWindowEvent(std::shared_ptr<Firefly::WindowEvent> event)
+void SandboxApp::OnWindowEvent(const Firefly::Event& event)
 {
-    if (auto resizeEvent = event->AsType<Firefly::WindowResizeEvent>())
+    if (auto resizeEvent = event.AsType<Firefly::WindowResizeEvent>())
     {
         int width = resizeEvent->GetWidth();
         int height = resizeEvent->GetHeight();
@@ -238,11 +270,12 @@ void SandboxApp::OnWindowEvent(std::shared_ptr<Firefly::WindowEvent> event)
     }
 }
 
-void SandboxApp::OnKeyEvent(std::shared_ptr<Firefly::KeyEvent> event)
+void SandboxApp::OnKeyEvent(const Firefly::Event& event)
 {
-    if (event->IsType<Firefly::KeyPressEvent>() || event->IsType<Firefly::KeyRepeatEvent>())
+    if (event.IsType<Firefly::KeyPressEvent>() || event.IsType<Firefly::KeyRepeatEvent>())
     {
-        switch (event->GetKeyCode())
+        int keyCode = event.AsType<Firefly::KeyEvent>()->GetKeyCode();
+        switch (keyCode)
         {
         case FIREFLY_KEY_1:
             m_isAlbedoTexEnabled = !m_isAlbedoTexEnabled;
@@ -262,59 +295,105 @@ void SandboxApp::OnKeyEvent(std::shared_ptr<Firefly::KeyEvent> event)
         case FIREFLY_KEY_6:
             m_isHeightTexEnabled = !m_isHeightTexEnabled;
             break;
+        case FIREFLY_KEY_7:
+            m_isOcclusionRoughnessMetalnessTexEnabled = !m_isOcclusionRoughnessMetalnessTexEnabled;
+            break;
         case FIREFLY_KEY_UP:
             m_heightScale = std::max(m_heightScale - 0.01f, 0.f);
             break;
         case FIREFLY_KEY_DOWN:
             m_heightScale += 0.01f;
             break;
-        }
-
-        auto entityGroup = m_scene->GetEntityGroup<Firefly::MaterialComponent>();
-        for (auto entity : entityGroup)
+        case FIREFLY_KEY_T:
+            m_systemScheduler.LogTrace();
+            FIREFLY_LOG_INFO("Sandbox", "Scene: {0} meshes, {1} triangles", m_sceneStatistics.meshCount.load(), m_sceneStatistics.triangleCount.load());
+            break;
+        case FIREFLY_KEY_L:
         {
-            auto material = entity.GetComponent<Firefly::MaterialComponent>().m_material;
+            FIREFLY_LOG_INFO("Sandbox", "Input to present latency: {0:.2f} ms", m_renderer->GetInputToPresentLatency() * 1000.0f);
+            Firefly::LatencyPercentiles presentPercentiles = m_renderer->GetInputToPresentPercentiles();
+            Firefly::LatencyPercentiles gpuPercentiles = m_renderer->GetInputToGpuCompletionPercentiles();
+            FIREFLY_LOG_INFO("Sandbox", "Input to present p50/p95/p99: {0:.2f}/{1:.2f}/{2:.2f} ms ({3} frames)",
+                presentPercentiles.p50 * 1000.0f, presentPercentiles.p95 * 1000.0f, presentPercentiles.p99 * 1000.0f, presentPercentiles.sampleCount);
+            FIREFLY_LOG_INFO("Sandbox", "Input to gpu completion p50/p95/p99: {0:.2f}/{1:.2f}/{2:.2f} ms ({3} frames)",
+                gpuPercentiles.p50 * 1000.0f, gpuPercentiles.p95 * 1000.0f, gpuPercentiles.p99 * 1000.0f, gpuPercentiles.sampleCount);
+            m_renderer->ResetLatencyPercentiles();
+            m_renderer->SetLowLatencyEnabled(!m_renderer->IsLowLatencyEnabled());
+            FIREFLY_LOG_INFO("Sandbox", "Low latency mode: {0}", m_renderer->IsLowLatencyEnabled());
+            break;
+        }
+        case FIREFLY_KEY_P:
+            m_presentModeIndex = (m_presentModeIndex + 1) % std::size(s_presentModes);
+            Firefly::RenderingAPI::GetContext()->SetPresentMode(s_presentModes[m_presentModeIndex].first);
+            FIREFLY_LOG_INFO("Sandbox", "Present mode: {0}", s_presentModes[m_presentModeIndex].second);
+            m_renderer->ResetLatencyPercentiles();
+            break;
+        }
 
-            switch (event->GetKeyCode())
+        m_scene->Each<Firefly::MaterialComponent>([this, keyCode](Firefly::Entity entity, auto& materialComponent)
             {
-            case FIREFLY_KEY_1:
-                material->EnableTexture(m_isAlbedoTexEnabled, Firefly::Material::TextureUsage::Albedo);
-                break;
-            case FIREFLY_KEY_2:
-                material->EnableTexture(m_isNormalTexEnabled, Firefly::Material::TextureUsage::Normal);
-                break;
-            case FIREFLY_KEY_3:
-                material->EnableTexture(m_isRoughnessTexEnabled, Firefly::Material::TextureUsage::Roughness);
-                break;
-            case FIREFLY_KEY_4:
-                material->EnableTexture(m_isMetalnessTexEnabled, Firefly::Material::TextureUsage::Metalness);
-                break;
-            case FIREFLY_KEY_5:
-                material->EnableTexture(m_isOcclusionTexEnabled, Firefly::Material::TextureUsage::Occlusion);
-                break;
-            case FIREFLY_KEY_6:
-                material->EnableTexture(m_isHeightTexEnabled, Firefly::Material::TextureUsage::Height);
-                break;
-            case FIREFLY_KEY_UP:
-                material->SetHeightScale(m_heightScale);
-                material->SetRoughness(std::min(material->GetRoughness() + 0.01f, 1.0f));
-                break;
-            case FIREFLY_KEY_DOWN:
-                material->SetHeightScale(m_heightScale);
-                material->SetRoughness(std::max(material->GetRoughness() - 0.01f, 0.0f));
-                break;
-            default:
-                break;
-            }
-        }
+                Firefly::Material* material = Firefly::MaterialRegistry::Instance().Get(materialComponent.m_material);
+                if (!material)
+                    return;
+
+                switch (keyCode)
+                {
+                case FIREFLY_KEY_1:
+                    material->EnableTexture(m_isAlbedoTexEnabled, Firefly::Material::TextureUsage::Albedo);
+                    break;
+                case FIREFLY_KEY_2:
+                    material->EnableTexture(m_isNormalTexEnabled, Firefly::Material::TextureUsage::Normal);
+                    break;
+                case FIREFLY_KEY_3:
+                    material->EnableTexture(m_isRoughnessTexEnabled, Firefly::Material::TextureUsage::Roughness);
+                    break;
+                case FIREFLY_KEY_4:
+                    material->EnableTexture(m_isMetalnessTexEnabled, Firefly::Material::TextureUsage::Metalness);
+                    break;
+                case FIREFLY_KEY_5:
+                    material->EnableTexture(m_isOcclusionTexEnabled, Firefly::Material::TextureUsage::Occlusion);
+                    break;
+                case FIREFLY_KEY_6:
+                    material->EnableTexture(m_isHeightTexEnabled, Firefly::Material::TextureUsage::Height);
+                    break;
+                case FIREFLY_KEY_7:
+                    material->EnableTexture(m_isOcclusionRoughnessMetalnessTexEnabled, Firefly::Material::TextureUsage::OcclusionRoughnessMetalness);
+                    break;
+                case FIREFLY_KEY_UP:
+                    material->SetHeightScale(m_heightScale);
+                    material->SetRoughness(std::min(material->GetRoughness() + 0.01f, 1.0f));
+                    break;
+                case FIREFLY_KEY_DOWN:
+                    material->SetHeightScale(m_heightScale);
+                    material->SetRoughness(std::max(material->GetRoughness() - 0.01f, 0.0f));
+                    break;
+                default:
+                    break;
+                }
+            });
     }
 }
 
-void SandboxApp::OnMouseEvent(std::shared_ptr<Firefly::MouseEvent> event)
+void SandboxApp::OnMouseEvent(const Firefly::Event& event)
 {
     m_cameraController->OnMouseEvent(event);
 }
 
-void SandboxApp::OnGamepadEvent(std::shared_ptr<Firefly::GamepadEvent> event)
+void SandboxApp::OnGamepadEvent(const Firefly::Event& event)
 {
+}
+
+void SandboxApp::CullScene()
+{
+    Firefly::SceneSpatialIndex& spatialIndex = m_scene->GetSpatialIndex();
+    m_visibleEntities.clear();
+    spatialIndex.QueryFrustum(m_camera->GetFrustum(), m_visibleEntities);
+
+    m_occlusionCuller->BeginFrame(m_camera->GetProjectionMatrix() * m_camera->GetViewMatrix());
+    m_scene->Each<Firefly::TransformComponent, Firefly::OccluderComponent>([this](Firefly::Entity occluder, auto& transformComponent, auto& occluderComponent)
+        {
+            m_occlusionCuller->AddOccluder(occluderComponent.m_occluderMesh, transformComponent.m_transform);
+        });
+    m_occlusionCuller->RasterizeOccluders();
+    m_occlusionCuller->FilterVisible(m_visibleEntities, spatialIndex);
 }
\ No newline at end of file